@@ -197,6 +197,8 @@ namespace {
         makeFastProperty<TilemapComponent, bool, &TilemapComponent::flipY>("flipY", PropertyType::Bool, UpdateFlags_Tilemap),
         makeFastProperty<TilemapComponent, float, &TilemapComponent::textureScaleFactor>("textureScaleFactor", PropertyType::Float, UpdateFlags_Tilemap),
         makeFastProperty<TilemapComponent, unsigned int, &TilemapComponent::reserveTiles>("reserveTiles", PropertyType::UInt, UpdateFlags_Tilemap),
+        makeFastProperty<TilemapComponent, unsigned int, &TilemapComponent::chunkSize>("chunkSize", PropertyType::UInt, UpdateFlags_Tilemap),
+        makeFastProperty<TilemapComponent, bool, &TilemapComponent::cullChunks>("cullChunks", PropertyType::Bool, UpdateFlags_Tilemap),
     };
 
     static const FastPropertyDescriptor kActionProperties[] = {
@@ -222,6 +224,7 @@ namespace {
     static const FastPropertyDescriptor kKeyframeTracksProperties[] = {
         makeFastPropertyNoDefault<KeyframeTracksComponent, int, &KeyframeTracksComponent::index>("index", PropertyType::Int, UpdateFlags_None),
         makeFastProperty<KeyframeTracksComponent, float, &KeyframeTracksComponent::interpolation>("interpolation", PropertyType::Float, UpdateFlags_None),
+        makeFastProperty<KeyframeTracksComponent, int, &KeyframeTracksComponent::poseBone>("poseBone", PropertyType::Int, UpdateFlags_None),
     };
 
     static const FastPropertyDescriptor kSpriteAnimationProperties[] = {
@@ -239,6 +242,8 @@ namespace {
         makeFastProperty<AnimationComponent, bool, &AnimationComponent::loop>("loop", PropertyType::Bool, UpdateFlags_None),
         makeFastProperty<AnimationComponent, float, &AnimationComponent::duration>("duration", PropertyType::Float, UpdateFlags_None),
         makeFastProperty<AnimationComponent, bool, &AnimationComponent::ownedActions>("ownedActions", PropertyType::Bool, UpdateFlags_None),
+        makeFastProperty<AnimationComponent, bool, &AnimationComponent::compactClip>("compactClip", PropertyType::Bool, UpdateFlags_None),
+        makeFastProperty<AnimationComponent, bool, &AnimationComponent::quantizedClip>("quantizedClip", PropertyType::Bool, UpdateFlags_None),
     };
 
     static const FastPropertyDescriptor kLightProperties[] = {
@@ -911,7 +916,7 @@ namespace {
 
         // numTiles
         if (propertyName == "numTiles") {
-            return {PropertyType::UInt, UpdateFlags_Tilemap, (void*)&def.numTiles, (void*)&comp->numTiles};
+            return {PropertyType::UInt, UpdateFlags_Tilemap_Count, (void*)&def.numTiles, (void*)&comp->numTiles};
         }
 
         // tilesRect[N].field
@@ -961,7 +966,7 @@ namespace {
 
             pos++;
             if (pos == propertyName.size()) {
-                return {PropertyType::Custom, UpdateFlags_Tilemap, (void*)&defTile, (void*)&tile};
+                return {PropertyType::Custom, UpdateFlags_Tilemap_Tile, (void*)&defTile, (void*)&tile, (int)index};
             }
             if (propertyName[pos] != '.') {
                 return PropertyData();
@@ -970,19 +975,19 @@ namespace {
             const size_t fieldPos = pos + 1;
 
             if (propertyName.compare(fieldPos, 4, "name") == 0 && fieldPos + 4 == propertyName.size()) {
-                return {PropertyType::String, UpdateFlags_Tilemap, (void*)&defTile.name, (void*)&tile.name};
+                return {PropertyType::String, UpdateFlags_Tilemap_Tile, (void*)&defTile.name, (void*)&tile.name, (int)index};
             }
             if (propertyName.compare(fieldPos, 6, "rectId") == 0 && fieldPos + 6 == propertyName.size()) {
-                return {PropertyType::Int, UpdateFlags_Tilemap, (void*)&defTile.rectId, (void*)&tile.rectId};
+                return {PropertyType::Int, UpdateFlags_Tilemap_Tile, (void*)&defTile.rectId, (void*)&tile.rectId, (int)index};
             }
             if (propertyName.compare(fieldPos, 8, "position") == 0 && fieldPos + 8 == propertyName.size()) {
-                return {PropertyType::Vector2, UpdateFlags_Tilemap, (void*)&defTile.position, (void*)&tile.position};
+                return {PropertyType::Vector2, UpdateFlags_Tilemap_Tile, (void*)&defTile.position, (void*)&tile.position, (int)index};
             }
             if (propertyName.compare(fieldPos, 5, "width") == 0 && fieldPos + 5 == propertyName.size()) {
-                return {PropertyType::Float, UpdateFlags_Tilemap, (void*)&defTile.width, (void*)&tile.width};
+                return {PropertyType::Float, UpdateFlags_Tilemap_Tile, (void*)&defTile.width, (void*)&tile.width, (int)index};
             }
             if (propertyName.compare(fieldPos, 6, "height") == 0 && fieldPos + 6 == propertyName.size()) {
-                return {PropertyType::Float, UpdateFlags_Tilemap, (void*)&defTile.height, (void*)&tile.height};
+                return {PropertyType::Float, UpdateFlags_Tilemap_Tile, (void*)&defTile.height, (void*)&tile.height, (int)index};
             }
 
             return PropertyData();
@@ -1141,6 +1146,10 @@ namespace {
             return {PropertyType::Entity, UpdateFlags_Mesh_Reload, (void*)&def.skeleton, (void*)&comp->skeleton};
         }
 
+        if (propertyName == "compactSkeleton") {
+            return {PropertyType::Bool, UpdateFlags_Model | UpdateFlags_Mesh_Reload, (void*)&def.compactSkeleton, (void*)&comp->compactSkeleton};
+        }
+
         if (propertyName == "animations") {
             return {PropertyType::Custom, UpdateFlags_None, (void*)&def.animations, (void*)&comp->animations};
         }
@@ -1326,6 +1335,7 @@ namespace {
 
         ps["filename"] = {PropertyType::String, UpdateFlags_Model, (void*)&def.filename, compRef ? (void*)&comp->filename : nullptr};
         ps["skeleton"] = {PropertyType::Entity, UpdateFlags_Mesh_Reload, (void*)&def.skeleton, compRef ? (void*)&comp->skeleton : nullptr};
+        ps["compactSkeleton"] = {PropertyType::Bool, UpdateFlags_Model | UpdateFlags_Mesh_Reload, (void*)&def.compactSkeleton, compRef ? (void*)&comp->compactSkeleton : nullptr};
         ps["animations"] = {PropertyType::Custom, UpdateFlags_None, (void*)&def.animations, compRef ? (void*)&comp->animations : nullptr};
 
         for (size_t i = 0; i < (compRef ? comp->animations.size() : 0); i++) {
@@ -1487,7 +1497,7 @@ namespace {
         enumerateFromDescriptors(compRef, ps, kTilemapTopProperties);
 
         ps["numTilesRect"] = {PropertyType::UInt, UpdateFlags_Tilemap, (void*)&def.numTilesRect, compRef ? (void*)&comp->numTilesRect : nullptr};
-        ps["numTiles"] = {PropertyType::UInt, UpdateFlags_Tilemap, (void*)&def.numTiles, compRef ? (void*)&comp->numTiles : nullptr};
+        ps["numTiles"] = {PropertyType::UInt, UpdateFlags_Tilemap_Count, (void*)&def.numTiles, compRef ? (void*)&comp->numTiles : nullptr};
 
         for (unsigned int i = 0; i < (compRef ? comp->numTilesRect : 0); i++) {
             std::string idx = std::to_string(i);
@@ -1506,11 +1516,11 @@ namespace {
             TileData& tile = comp->tiles[i];
             TileData& defTile = def.tiles[0];
 
-            ps["tiles[" + idx + "].name"] = {PropertyType::String, UpdateFlags_Tilemap, (void*)&defTile.name, (void*)&tile.name};
-            ps["tiles[" + idx + "].rectId"] = {PropertyType::Int, UpdateFlags_Tilemap, (void*)&defTile.rectId, (void*)&tile.rectId};
-            ps["tiles[" + idx + "].position"] = {PropertyType::Vector2, UpdateFlags_Tilemap, (void*)&defTile.position, (void*)&tile.position};
-            ps["tiles[" + idx + "].width"] = {PropertyType::Float, UpdateFlags_Tilemap, (void*)&defTile.width, (void*)&tile.width};
-            ps["tiles[" + idx + "].height"] = {PropertyType::Float, UpdateFlags_Tilemap, (void*)&defTile.height, (void*)&tile.height};
+            ps["tiles[" + idx + "].name"] = {PropertyType::String, UpdateFlags_Tilemap_Tile, (void*)&defTile.name, (void*)&tile.name, (int)i};
+            ps["tiles[" + idx + "].rectId"] = {PropertyType::Int, UpdateFlags_Tilemap_Tile, (void*)&defTile.rectId, (void*)&tile.rectId, (int)i};
+            ps["tiles[" + idx + "].position"] = {PropertyType::Vector2, UpdateFlags_Tilemap_Tile, (void*)&defTile.position, (void*)&tile.position, (int)i};
+            ps["tiles[" + idx + "].width"] = {PropertyType::Float, UpdateFlags_Tilemap_Tile, (void*)&defTile.width, (void*)&tile.width, (int)i};
+            ps["tiles[" + idx + "].height"] = {PropertyType::Float, UpdateFlags_Tilemap_Tile, (void*)&defTile.height, (void*)&tile.height, (int)i};
         }
     }
 
@@ -1954,105 +1964,13 @@ std::string editor::Catalog::getComponentName(ComponentType component, bool remo
 }
 
 ComponentId editor::Catalog::getComponentId(const EntityRegistry* registry, ComponentType compType) {
-    using namespace doriax;
-    switch (compType) {
-        case ComponentType::Transform:
-            return registry->getComponentId<Transform>();
-        case ComponentType::MeshComponent:
-            return registry->getComponentId<MeshComponent>();
-        case ComponentType::UIComponent:
-            return registry->getComponentId<UIComponent>();
-        case ComponentType::UILayoutComponent:
-            return registry->getComponentId<UILayoutComponent>();
-        case ComponentType::ActionComponent:
-            return registry->getComponentId<ActionComponent>();
-        case ComponentType::AlphaActionComponent:
-            return registry->getComponentId<AlphaActionComponent>();
-        case ComponentType::AnimationComponent:
-            return registry->getComponentId<AnimationComponent>();
-        case ComponentType::AudioComponent:
-            return registry->getComponentId<AudioComponent>();
-        case ComponentType::Body2DComponent:
-            return registry->getComponentId<Body2DComponent>();
-        case ComponentType::Body3DComponent:
-            return registry->getComponentId<Body3DComponent>();
-        case ComponentType::BoneComponent:
-            return registry->getComponentId<BoneComponent>();
-        case ComponentType::BundleComponent:
-            return registry->getComponentId<BundleComponent>();
-        case ComponentType::ButtonComponent:
-            return registry->getComponentId<ButtonComponent>();
-        case ComponentType::CameraComponent:
-            return registry->getComponentId<CameraComponent>();
-        case ComponentType::ColorActionComponent:
-            return registry->getComponentId<ColorActionComponent>();
-        case ComponentType::FogComponent:
-            return registry->getComponentId<FogComponent>();
-        case ComponentType::ImageComponent:
-            return registry->getComponentId<ImageComponent>();
-        case ComponentType::InstancedMeshComponent:
-            return registry->getComponentId<InstancedMeshComponent>();
-        case ComponentType::Joint2DComponent:
-            return registry->getComponentId<Joint2DComponent>();
-        case ComponentType::Joint3DComponent:
-            return registry->getComponentId<Joint3DComponent>();
-        case ComponentType::KeyframeTracksComponent:
-            return registry->getComponentId<KeyframeTracksComponent>();
-        case ComponentType::LightComponent:
-            return registry->getComponentId<LightComponent>();
-        case ComponentType::LinesComponent:
-            return registry->getComponentId<LinesComponent>();
-        case ComponentType::MeshPolygonComponent:
-            return registry->getComponentId<MeshPolygonComponent>();
-        case ComponentType::ModelComponent:
-            return registry->getComponentId<ModelComponent>();
-        case ComponentType::MorphTracksComponent:
-            return registry->getComponentId<MorphTracksComponent>();
-        case ComponentType::PanelComponent:
-            return registry->getComponentId<PanelComponent>();
-        case ComponentType::ParticlesComponent:
-            return registry->getComponentId<ParticlesComponent>();
-        case ComponentType::PointsComponent:
-            return registry->getComponentId<PointsComponent>();
-        case ComponentType::PolygonComponent:
-            return registry->getComponentId<PolygonComponent>();
-        case ComponentType::PositionActionComponent:
-            return registry->getComponentId<PositionActionComponent>();
-        case ComponentType::RotateTracksComponent:
-            return registry->getComponentId<RotateTracksComponent>();
-        case ComponentType::RotationActionComponent:
-            return registry->getComponentId<RotationActionComponent>();
-        case ComponentType::ScaleActionComponent:
-            return registry->getComponentId<ScaleActionComponent>();
-        case ComponentType::ScaleTracksComponent:
-            return registry->getComponentId<ScaleTracksComponent>();
-        case ComponentType::ScriptComponent:
-            return registry->getComponentId<ScriptComponent>();
-        case ComponentType::ScrollbarComponent:
-            return registry->getComponentId<ScrollbarComponent>();
-        case ComponentType::SkyComponent:
-            return registry->getComponentId<SkyComponent>();
-        case ComponentType::SpriteAnimationComponent:
-            return registry->getComponentId<SpriteAnimationComponent>();
-        case ComponentType::SpriteComponent:
-            return registry->getComponentId<SpriteComponent>();
-        case ComponentType::TerrainComponent:
-            return registry->getComponentId<TerrainComponent>();
-        case ComponentType::TextComponent:
-            return registry->getComponentId<TextComponent>();
-        case ComponentType::TextEditComponent:
-            return registry->getComponentId<TextEditComponent>();
-        case ComponentType::TilemapComponent:
-            return registry->getComponentId<TilemapComponent>();
-        case ComponentType::TimedActionComponent:
-            return registry->getComponentId<TimedActionComponent>();
-        case ComponentType::TranslateTracksComponent:
-            return registry->getComponentId<TranslateTracksComponent>();
-        case ComponentType::UIContainerComponent:
-            return registry->getComponentId<UIContainerComponent>();
-        default:
-            return 0;
+    // editor names are the names components were registered with
+    std::string name = getComponentName(compType);
+    if (name.empty()) {
+        return 0;
     }
+
+    return registry->getComponentId(name);
 }
 
 editor::ComponentType editor::Catalog::getComponentType(const std::string& componentName) {
@@ -2426,7 +2344,7 @@ int editor::Catalog::getChangedUpdateFlags(ComponentType compType, void* oldComp
     return flags;
 }
 
-void editor::Catalog::updateEntity(EntityRegistry* registry, Entity entity, int updateFlags){
+void editor::Catalog::updateEntity(EntityRegistry* registry, Entity entity, int updateFlags, int index){
     if (updateFlags & UpdateFlags_Transform){
         if (Transform* transform = registry->findComponent<Transform>(entity)){
             transform->needUpdate = true;
@@ -2539,9 +2457,29 @@ void editor::Catalog::updateEntity(EntityRegistry* registry, Entity entity, int
             model->needUpdateModel = true;
         }
     }
-    if (updateFlags & UpdateFlags_Tilemap){
+    if (updateFlags & (UpdateFlags_Tilemap | UpdateFlags_Tilemap_Tile | UpdateFlags_Tilemap_Count)){
         if (TilemapComponent* tilemap = registry->findComponent<TilemapComponent>(entity)){
-            tilemap->needUpdateTilemap = true;
+            if (updateFlags & UpdateFlags_Tilemap){
+                tilemap->needUpdateTilemap = true;
+            }
+            // tiles already in buffer slots only rewrite themselves, like Tilemap::addTile
+            if (updateFlags & UpdateFlags_Tilemap_Tile){
+                if (index >= 0 && (unsigned int)index < tilemap->renderedTiles){
+                    tilemap->changedTiles.push_back(index);
+                }else{
+                    tilemap->needUpdateTilemap = true;
+                }
+            }
+            if (updateFlags & UpdateFlags_Tilemap_Count){
+                if (tilemap->numTiles > tilemap->renderedTiles){
+                    tilemap->needUpdateTilemap = true;
+                }
+                for (unsigned int i = 0; i < tilemap->tileSubmeshes.size(); i++){
+                    if ((i < tilemap->numTiles) != (tilemap->tileSubmeshes[i] >= 0)){
+                        tilemap->changedTiles.push_back(i);
+                    }
+                }
+            }
         }
     }
 }
@@ -2807,7 +2745,7 @@ void editor::Catalog::copyPropertyValue(EntityRegistry* sourceRegistry, Entity s
     }
 
     // Apply any update flags that are associated with this property
-    updateEntity(targetRegistry, targetEntity, propIt->second.updateFlags);
+    updateEntity(targetRegistry, targetEntity, propIt->second.updateFlags, propIt->second.index);
 }
 
 editor::PropertyData editor::Catalog::getProperty(EntityRegistry* registry, Entity entity, ComponentType component, std::string propertyName){
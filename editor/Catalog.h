@@ -30,7 +30,9 @@ namespace doriax::editor{
         UpdateFlags_Joint2D             = 1 << 19,
         UpdateFlags_Joint3D             = 1 << 20,
         UpdateFlags_Model               = 1 << 21,
-        UpdateFlags_Tilemap             = 1 << 22
+        UpdateFlags_Tilemap             = 1 << 22,
+        UpdateFlags_Tilemap_Tile        = 1 << 23,
+        UpdateFlags_Tilemap_Count       = 1 << 24
     };
 
     // the order of components here affects properties window
@@ -107,6 +109,7 @@ namespace doriax::editor{
         int updateFlags;
         void* def;
         void* ref;
+        int index = -1; // element of array properties, for single element updates
     };
 
     class Catalog{
@@ -132,7 +135,7 @@ namespace doriax::editor{
 
         static int getChangedUpdateFlags(ComponentType compType, void* oldComp, void* newComp);
 
-        static void updateEntity(EntityRegistry* registry, Entity entity, int updateFlags);
+        static void updateEntity(EntityRegistry* registry, Entity entity, int updateFlags, int index = -1);
 
         static void copyComponent(EntityRegistry* sourceRegistry, Entity sourceEntity,
                                 EntityRegistry* targetRegistry, Entity targetEntity,
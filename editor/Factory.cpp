@@ -842,6 +842,8 @@ std::string editor::Factory::createTilemapComponent(int indentSpaces, EntityRegi
     code << ind << "tilemap.flipY = " << formatBool(tilemap.flipY) << ";\n";
     code << ind << "tilemap.textureScaleFactor = " << formatFloat(tilemap.textureScaleFactor) << ";\n";
     code << ind << "tilemap.reserveTiles = " << formatUInt(tilemap.reserveTiles) << ";\n";
+    code << ind << "tilemap.chunkSize = " << formatUInt(tilemap.chunkSize) << ";\n";
+    code << ind << "tilemap.cullChunks = " << formatBool(tilemap.cullChunks) << ";\n";
     for (unsigned int i = 0; i < tilemap.numTilesRect; i++) {
         if (!tilemap.tilesRect[i].name.empty()) {
             code << ind << "tilemap.tilesRect[" << i << "].name = " << formatString(tilemap.tilesRect[i].name) << ";\n";
@@ -1297,6 +1299,8 @@ std::string editor::Factory::createAnimationComponent(int indentSpaces, EntityRe
     code << ind << "animcomp.loop = " << formatBool(anim.loop) << ";\n";
     code << ind << "animcomp.duration = " << formatFloat(anim.duration) << ";\n";
     code << ind << "animcomp.ownedActions = " << formatBool(anim.ownedActions) << ";\n";
+    code << ind << "animcomp.compactClip = " << formatBool(anim.compactClip) << ";\n";
+    code << ind << "animcomp.quantizedClip = " << formatBool(anim.quantizedClip) << ";\n";
     code << ind << "animcomp.actions.clear();\n";
     for (size_t i = 0; i < anim.actions.size(); i++) {
         code << ind << "animcomp.actions.push_back({" << formatFloat(anim.actions[i].startTime) << ", " << formatFloat(anim.actions[i].duration) << ", " << formatEntity(anim.actions[i].action, entityVarNames) << ", " << formatUInt(anim.actions[i].track) << "});\n";
@@ -1313,6 +1317,7 @@ std::string editor::Factory::createModelComponent(int indentSpaces, EntityRegist
     code << ind << "ModelComponent modelcomp;\n";
     code << ind << "modelcomp.filename = \"" << model.filename << "\";\n";
     code << ind << "modelcomp.skeleton = " << formatEntity(model.skeleton, entityVarNames) << ";\n";
+    code << ind << "modelcomp.compactSkeleton = " << formatBool(model.compactSkeleton) << ";\n";
     if (!model.animations.empty()) {
         code << ind << "modelcomp.animations.clear();\n";
         for (size_t i = 0; i < model.animations.size(); i++) {
@@ -1365,6 +1370,7 @@ std::string editor::Factory::createKeyframeTracksComponent(int indentSpaces, Ent
     code << ind << "KeyframeTracksComponent kfcomp;\n";
     code << ind << "kfcomp.index = " << formatInt(kf.index) << ";\n";
     code << ind << "kfcomp.interpolation = " << formatFloat(kf.interpolation) << ";\n";
+    code << ind << "kfcomp.poseBone = " << formatInt(kf.poseBone) << ";\n";
     if (!kf.times.empty()) {
         code << ind << "kfcomp.times = {";
         for (size_t i = 0; i < kf.times.size(); i++) {
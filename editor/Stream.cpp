@@ -2522,15 +2522,17 @@ YAML::Node editor::Stream::encodeMeshComponent(const MeshComponent& mesh, bool e
     node["submeshes"] = submeshesNode;
     //node["numSubmeshes"] = mesh.numSubmeshes;
 
-    // Encode bones matrix array
-    YAML::Node bonesNode;
-    for(int i = 0; i < MAX_BONES; i++) {
-        bonesNode.push_back(encodeMatrix4(mesh.bonesMatrix[i]));
-    }
-    node["bonesMatrix"] = bonesNode;
+    // Encode bones matrix array, only skinned meshes have it
+    if (mesh.skinning.isAllocated()) {
+        YAML::Node bonesNode;
+        for(int i = 0; i < MAX_BONES; i++) {
+            bonesNode.push_back(encodeMatrix4(mesh.skinning->bonesMatrix[i]));
+        }
+        node["bonesMatrix"] = bonesNode;
 
-    node["normAdjustJoint"] = mesh.normAdjustJoint;
-    node["normAdjustWeight"] = mesh.normAdjustWeight;
+        node["normAdjustJoint"] = mesh.skinning->normAdjustJoint;
+        node["normAdjustWeight"] = mesh.skinning->normAdjustWeight;
+    }
 
     // Encode morph weights array
     YAML::Node morphWeightsNode;
@@ -2604,12 +2606,12 @@ MeshComponent editor::Stream::decodeMeshComponent(const YAML::Node& node, const
     if (node["bonesMatrix"]) {
         auto bonesNode = node["bonesMatrix"];
         for(int i = 0; i < MAX_BONES; i++) {
-            mesh.bonesMatrix[i] = decodeMatrix4(bonesNode[i]);
+            mesh.skinning->bonesMatrix[i] = decodeMatrix4(bonesNode[i]);
         }
     }
 
-    if (node["normAdjustJoint"]) mesh.normAdjustJoint = node["normAdjustJoint"].as<int>();
-    if (node["normAdjustWeight"]) mesh.normAdjustWeight = node["normAdjustWeight"].as<float>();
+    if (node["normAdjustJoint"]) mesh.skinning->normAdjustJoint = node["normAdjustJoint"].as<int>();
+    if (node["normAdjustWeight"]) mesh.skinning->normAdjustWeight = node["normAdjustWeight"].as<float>();
 
     // Decode morph weights
     if (node["morphWeights"]) {
@@ -2966,6 +2968,8 @@ YAML::Node editor::Stream::encodeTilemapComponent(const TilemapComponent& tilema
     node["flipY"] = tilemap.flipY;
     node["textureScaleFactor"] = tilemap.textureScaleFactor;
     node["reserveTiles"] = tilemap.reserveTiles;
+    node["chunkSize"] = tilemap.chunkSize;
+    node["cullChunks"] = tilemap.cullChunks;
 
     YAML::Node tilesRectNode;
     for (unsigned int i = 0; i < tilemap.numTilesRect; i++) {
@@ -2999,6 +3003,8 @@ TilemapComponent editor::Stream::decodeTilemapComponent(const YAML::Node& node,
     if (node["flipY"]) tilemap.flipY = node["flipY"].as<bool>();
     if (node["textureScaleFactor"]) tilemap.textureScaleFactor = node["textureScaleFactor"].as<float>();
     if (node["reserveTiles"]) tilemap.reserveTiles = node["reserveTiles"].as<unsigned int>();
+    if (node["chunkSize"]) tilemap.chunkSize = node["chunkSize"].as<unsigned int>();
+    if (node["cullChunks"]) tilemap.cullChunks = node["cullChunks"].as<bool>();
 
     if (node["tilesRect"]) {
         const YAML::Node& tilesRectNode = node["tilesRect"];
@@ -3039,6 +3045,7 @@ YAML::Node editor::Stream::encodeModelComponent(const ModelComponent& model) {
     }
 
     node["skeleton"] = static_cast<uint32_t>(model.skeleton);
+    node["compactSkeleton"] = model.compactSkeleton;
 
     if (!model.animations.empty()) {
         YAML::Node animsNode;
@@ -3083,6 +3090,7 @@ ModelComponent editor::Stream::decodeModelComponent(const YAML::Node& node, cons
     // Also check for the old modelPath for exact backward compatibility with old save files
     if (node["filename"]) model.filename = node["filename"].as<std::string>();
     if (node["skeleton"]) model.skeleton = static_cast<Entity>(node["skeleton"].as<uint32_t>());
+    if (node["compactSkeleton"]) model.compactSkeleton = node["compactSkeleton"].as<bool>();
 
     if (node["animations"]) {
         model.animations.clear();
@@ -3978,6 +3986,8 @@ YAML::Node editor::Stream::encodeAnimationComponent(const AnimationComponent& an
     node["loop"] = animation.loop;
     node["duration"] = animation.duration;
     node["ownedActions"] = animation.ownedActions;
+    node["compactClip"] = animation.compactClip;
+    node["quantizedClip"] = animation.quantizedClip;
 
     YAML::Node actionsNode;
     for (const auto& frame : animation.actions) {
@@ -4004,6 +4014,8 @@ AnimationComponent editor::Stream::decodeAnimationComponent(const YAML::Node& no
     if (node["loop"]) animation.loop = node["loop"].as<bool>();
     if (node["duration"]) animation.duration = node["duration"].as<float>();
     if (node["ownedActions"]) animation.ownedActions = node["ownedActions"].as<bool>();
+    if (node["compactClip"]) animation.compactClip = node["compactClip"].as<bool>();
+    if (node["quantizedClip"]) animation.quantizedClip = node["quantizedClip"].as<bool>();
 
     if (node["actions"]) {
         animation.actions.clear();
@@ -4055,6 +4067,7 @@ YAML::Node editor::Stream::encodeKeyframeTracksComponent(const KeyframeTracksCom
 
     node["index"] = tracks.index;
     node["interpolation"] = tracks.interpolation;
+    node["poseBone"] = tracks.poseBone;
 
     YAML::Node timesNode;
     for (float t : tracks.times) {
@@ -4074,6 +4087,7 @@ KeyframeTracksComponent editor::Stream::decodeKeyframeTracksComponent(const YAML
 
     if (node["index"]) tracks.index = node["index"].as<int>();
     if (node["interpolation"]) tracks.interpolation = node["interpolation"].as<float>();
+    if (node["poseBone"]) tracks.poseBone = node["poseBone"].as<int>();
 
     if (node["times"]) {
         tracks.times.clear();
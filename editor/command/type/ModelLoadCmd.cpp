@@ -84,6 +84,8 @@ bool editor::ModelLoadCmd::execute(){
     bool ret = false;
     if (ext == "obj"){
         ret = meshSys->loadOBJ(entity, modelPath, true);
+    }else if (ext == "dmodel"){
+        ret = meshSys->loadCookedModel(entity, modelPath, true, false, isNewModel);
     }else{
         ret = meshSys->loadGLTF(entity, modelPath, true, false, isNewModel);
     }
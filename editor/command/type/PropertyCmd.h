@@ -90,7 +90,7 @@ namespace doriax::editor{
                     }
                 }
 
-                Catalog::updateEntity(sceneProject->scene, entity, prop.updateFlags);
+                Catalog::updateEntity(sceneProject->scene, entity, prop.updateFlags, prop.index);
 
                 if (project->isEntityInBundle(sceneId, entity)){
                     project->bundlePropertyChanged(sceneId, entity, type, {propertyName});
@@ -123,7 +123,7 @@ namespace doriax::editor{
                     }
                 }
 
-                Catalog::updateEntity(sceneProject->scene, entity, prop.updateFlags);
+                Catalog::updateEntity(sceneProject->scene, entity, prop.updateFlags, prop.index);
 
                 if (project->isEntityInBundle(sceneId, entity)){
                     project->bundlePropertyChanged(sceneId, entity, type, {propertyName});
@@ -35,7 +35,7 @@ namespace doriax::editor{
         }
 
         inline static std::string getModelExtensions() {
-             return "gltf,glb,obj";
+             return "gltf,glb,obj,dmodel";
         }
 
         inline static bool isImageFile(const std::string& path) {
@@ -105,7 +105,7 @@ namespace doriax::editor{
 
         inline static bool isModelFile(const std::string& path) {
              static const std::unordered_set<std::string> modelExtensions = {
-                ".gltf", ".glb", ".obj"
+                ".gltf", ".glb", ".obj", ".dmodel"
             };
 
             std::string ext = std::filesystem::path(path).extension().string();
@@ -4023,7 +4023,7 @@ void editor::Properties::drawMeshComponent(ComponentType cpType, SceneProject* s
 }
 
 void editor::Properties::drawModelComponent(ComponentType cpType, SceneProject* sceneProject, std::vector<Entity> entities){
-    beginTable(cpType, getLabelSize("Model File"));
+    beginTable(cpType, getLabelSize("Compact Bones"));
 
     propertyHeader("Model File");
 
@@ -4126,6 +4126,10 @@ void editor::Properties::drawModelComponent(ComponentType cpType, SceneProject*
 
     propertyRow(RowPropertyType::LocalEntity, cpType, "skeleton", "Skeleton", sceneProject, entities);
 
+    RowSettings compactSettings;
+    compactSettings.help = "Bones without entities, applied when model file is loaded";
+    propertyRow(RowPropertyType::Bool, cpType, "compactSkeleton", "Compact Bones", sceneProject, entities, compactSettings);
+
     endTable();
 
     if (entities.size() == 1) {
@@ -4749,6 +4753,8 @@ void editor::Properties::drawTilemapComponent(ComponentType cpType, SceneProject
     propertyRow(RowPropertyType::Float, cpType, "textureScaleFactor", "Texture Scale", sceneProject, entities, settingsTexScale);
     propertyRowWithAutoButton(RowPropertyType::Bool, cpType, "flipY", "Flip Y", "automaticFlipY", "Automatic Flip Y", sceneProject, entities);
     propertyRow(RowPropertyType::UInt, cpType, "reserveTiles", "Reserve Tiles", sceneProject, entities, settingsInt);
+    propertyRow(RowPropertyType::UInt, cpType, "chunkSize", "Chunk Size", sceneProject, entities, settingsInt);
+    propertyRow(RowPropertyType::Bool, cpType, "cullChunks", "Cull Chunks", sceneProject, entities);
     endTable();
 
     if (entities.size() == 1) {
@@ -7585,11 +7591,13 @@ void editor::Properties::drawSpriteAnimationComponent(ComponentType cpType, Scen
 }
 
 void editor::Properties::drawAnimationComponent(ComponentType cpType, SceneProject* sceneProject, std::vector<Entity> entities){
-    beginTable(cpType, getLabelSize("Owned actions"));
+    beginTable(cpType, getLabelSize("Quantized clip"));
     propertyRow(RowPropertyType::String, cpType, "name", "Name", sceneProject, entities);
     propertyRow(RowPropertyType::Bool, cpType, "loop", "Loop", sceneProject, entities);
     propertyRow(RowPropertyType::Float, cpType, "duration", "Duration", sceneProject, entities);
     propertyRow(RowPropertyType::Bool, cpType, "ownedActions", "Owned actions", sceneProject, entities);
+    propertyRow(RowPropertyType::Bool, cpType, "compactClip", "Compact clip", sceneProject, entities);
+    propertyRow(RowPropertyType::Bool, cpType, "quantizedClip", "Quantized clip", sceneProject, entities);
     endTable();
 
     AnimationComponent& anim = sceneProject->scene->getComponent<AnimationComponent>(entities[0]);
@@ -7699,6 +7707,7 @@ void editor::Properties::drawKeyframeTracksComponent(ComponentType cpType, Scene
     beginTable(cpType, getLabelSize("Interpolation"));
     propertyRow(RowPropertyType::Int, cpType, "index", "Index", sceneProject, entities);
     propertyRow(RowPropertyType::Float, cpType, "interpolation", "Interpolation", sceneProject, entities);
+    propertyRow(RowPropertyType::Int, cpType, "poseBone", "Pose Bone", sceneProject, entities);
     endTable();
 
     drawTrackValues<KeyframeTracksComponent, float>(cpType, sceneProject, entities, RowPropertyType::Float, 0.0f, "keyframe", &KeyframeTracksComponent::times, "times");
@@ -140,6 +140,13 @@ namespace doriax {
         DYNAMIC
     };
 
+    // how transforms follow bodies when physics runs at a fixed time step
+    enum class PhysicsInterpolation{
+        NONE,        // last simulated pose
+        INTERPOLATE, // between the two last simulated poses, one step behind
+        EXTRAPOLATE  // ahead of the last simulated pose using last step motion
+    };
+
     enum class ResourceLoadState {
         NotStarted,
         Loading,
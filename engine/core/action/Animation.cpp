@@ -54,6 +54,30 @@ void Animation::setOwnedActions(bool ownedActions){
     animation.ownedActions = ownedActions;
 }
 
+bool Animation::isCompactClip() const{
+    AnimationComponent& animation = getComponent<AnimationComponent>();
+
+    return animation.compactClip;
+}
+
+void Animation::setCompactClip(bool compactClip){
+    AnimationComponent& animation = getComponent<AnimationComponent>();
+
+    animation.compactClip = compactClip;
+}
+
+bool Animation::isQuantizedClip() const{
+    AnimationComponent& animation = getComponent<AnimationComponent>();
+
+    return animation.quantizedClip;
+}
+
+void Animation::setQuantizedClip(bool quantizedClip){
+    AnimationComponent& animation = getComponent<AnimationComponent>();
+
+    animation.quantizedClip = quantizedClip;
+}
+
 const std::string &Animation::getName() const{
     AnimationComponent& animation = getComponent<AnimationComponent>();
 
@@ -24,6 +24,13 @@ namespace doriax{
         bool isOwnedActions() const;
         void setOwnedActions(bool ownedActions);
 
+        // pack keyframe tracks in a single clip when started
+        bool isCompactClip() const;
+        void setCompactClip(bool compactClip);
+
+        bool isQuantizedClip() const;
+        void setQuantizedClip(bool quantizedClip);
+
         const std::string &getName() const;
         void setName(const std::string &name);
 
@@ -112,6 +112,7 @@ void Particles::setPositionModifier(float fromTime, float toTime, Vector3 fromPo
     partAnim.positionModifier.fromPosition = fromPosition;
     partAnim.positionModifier.toPosition = toPosition;
     partAnim.positionModifier.function = Ease::getFunction(functionType);
+    partAnim.positionModifier.curve.clear();
 }
 
 void Particles::setVelocityInitializer(Vector3 velocity){
@@ -137,6 +138,7 @@ void Particles::setVelocityModifier(float fromTime, float toTime, Vector3 fromVe
     partAnim.velocityModifier.fromVelocity = fromVelocity;
     partAnim.velocityModifier.toVelocity = toVelocity;
     partAnim.velocityModifier.function = Ease::getFunction(functionType);
+    partAnim.velocityModifier.curve.clear();
 }
 
 void Particles::setAccelerationInitializer(Vector3 acceleration){
@@ -162,6 +164,7 @@ void Particles::setAccelerationModifier(float fromTime, float toTime, Vector3 fr
     partAnim.accelerationModifier.fromAcceleration = fromAcceleration;
     partAnim.accelerationModifier.toAcceleration = toAcceleration;
     partAnim.accelerationModifier.function = Ease::getFunction(functionType);
+    partAnim.accelerationModifier.curve.clear();
 }
 
 void Particles::setColorInitializer(Vector3 color){
@@ -187,6 +190,7 @@ void Particles::setColorModifier(float fromTime, float toTime, Vector3 fromColor
     partAnim.colorModifier.fromColor = fromColor;
     partAnim.colorModifier.toColor = toColor;
     partAnim.colorModifier.function = Ease::getFunction(functionType);
+    partAnim.colorModifier.curve.clear();
 }
 
 void Particles::setAlphaInitializer(float alpha){
@@ -212,6 +216,7 @@ void Particles::setAlphaModifier(float fromTime, float toTime, float fromAlpha,
     partAnim.alphaModifier.fromAlpha = fromAlpha;
     partAnim.alphaModifier.toAlpha = toAlpha;
     partAnim.alphaModifier.function = Ease::getFunction(functionType);
+    partAnim.alphaModifier.curve.clear();
 }
 
 void Particles::setSizeInitializer(float size){
@@ -237,6 +242,7 @@ void Particles::setSizeModifier(float fromTime, float toTime, float fromSize, fl
     partAnim.sizeModifier.fromSize = fromSize;
     partAnim.sizeModifier.toSize = toSize;
     partAnim.sizeModifier.function = Ease::getFunction(functionType);
+    partAnim.sizeModifier.curve.clear();
 }
 
 void Particles::setSpriteIntializer(std::vector<int> frames){
@@ -266,6 +272,7 @@ void Particles::setSpriteModifier(float fromTime, float toTime, std::vector<int>
     partAnim.spriteModifier.toTime = toTime;
     partAnim.spriteModifier.frames = frames;
     partAnim.spriteModifier.function = Ease::getFunction(functionType);
+    partAnim.spriteModifier.curve.clear();
 }
 
 void Particles::setRotationInitializer(Quaternion rotation){
@@ -306,6 +313,7 @@ void Particles::setRotationModifier(float fromTime, float toTime, float fromRota
     partAnim.rotationModifier.fromRotation = Quaternion(0, 0, fromRotation);
     partAnim.rotationModifier.toRotation = Quaternion(0, 0, toRotation);;
     partAnim.rotationModifier.function = Ease::getFunction(functionType);
+    partAnim.rotationModifier.curve.clear();
 }
 
 void Particles::setRotationModifier(float fromTime, float toTime, Quaternion fromRotation, Quaternion toRotation, EaseType functionType){
@@ -316,6 +324,7 @@ void Particles::setRotationModifier(float fromTime, float toTime, Quaternion fro
     partAnim.rotationModifier.fromRotation = fromRotation;
     partAnim.rotationModifier.toRotation = toRotation;
     partAnim.rotationModifier.function = Ease::getFunction(functionType);
+    partAnim.rotationModifier.curve.clear();
 }
 
 void Particles::setScaleInitializer(float scale){
@@ -356,5 +365,6 @@ void Particles::setScaleModifier(float fromTime, float toTime, Vector3 fromScale
     partAnim.scaleModifier.fromScale = fromScale;
     partAnim.scaleModifier.toScale = toScale;
     partAnim.scaleModifier.function = Ease::getFunction(functionType);
+    partAnim.scaleModifier.curve.clear();
 }
 
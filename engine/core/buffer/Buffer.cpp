@@ -60,6 +60,40 @@ Buffer& Buffer::operator=(const Buffer& rhs){
     return *this;
 }
 
+Buffer::Buffer(Buffer&& rhs) noexcept{
+    attributes = std::move(rhs.attributes);
+    count = rhs.count;
+    type = rhs.type;
+    usage = rhs.usage;
+
+    data = rhs.data;
+    size = rhs.size;
+    stride = rhs.stride;
+
+    renderAttributes = rhs.renderAttributes;
+    instanceBuffer = rhs.instanceBuffer;
+
+    render = rhs.render;
+}
+
+Buffer& Buffer::operator=(Buffer&& rhs) noexcept{
+    attributes = std::move(rhs.attributes);
+    count = rhs.count;
+    type = rhs.type;
+    usage = rhs.usage;
+
+    data = rhs.data;
+    size = rhs.size;
+    stride = rhs.stride;
+
+    renderAttributes = rhs.renderAttributes;
+    instanceBuffer = rhs.instanceBuffer;
+
+    render = rhs.render;
+
+    return *this;
+}
+
 bool Buffer::increase(size_t newSize){
     if (newSize >= size) {
         size = newSize;
@@ -143,7 +177,7 @@ Attribute* Buffer::getAttribute(AttributeType attribute){
     return NULL;
 }
 
-std::map<AttributeType, Attribute> Buffer::getAttributes() const{
+const std::map<AttributeType, Attribute>& Buffer::getAttributes() const{
     return attributes;
 }
 
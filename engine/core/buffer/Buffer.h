@@ -42,6 +42,9 @@ namespace doriax {
         Buffer(const Buffer& rhs);
         Buffer& operator=(const Buffer& rhs);
 
+        Buffer(Buffer&& rhs) noexcept;
+        Buffer& operator=(Buffer&& rhs) noexcept;
+
         virtual bool increase(size_t newSize);
         virtual void clearAll();
         virtual void clear();
@@ -56,7 +59,7 @@ namespace doriax {
         BufferRender* getRender();
 
         Attribute* getAttribute(AttributeType attribute);
-        std::map<AttributeType, Attribute> getAttributes() const;
+        const std::map<AttributeType, Attribute>& getAttributes() const;
 
         void addUInt16(AttributeType attribute, uint16_t value);
         void addUInt32(AttributeType attribute, uint32_t value);
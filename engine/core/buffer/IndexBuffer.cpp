@@ -36,6 +36,26 @@ IndexBuffer& IndexBuffer::operator=(const IndexBuffer& rhs){
     return *this;
 }
 
+IndexBuffer::IndexBuffer(IndexBuffer&& rhs) noexcept: Buffer(std::move(rhs)){
+    vectorBuffer = std::move(rhs.vectorBuffer);
+
+    data = vectorBuffer.empty() ? nullptr : &vectorBuffer[0];
+    rhs.data = nullptr;
+}
+
+IndexBuffer& IndexBuffer::operator=(IndexBuffer&& rhs) noexcept{
+    if (this != &rhs){
+        Buffer::operator =(std::move(rhs));
+
+        vectorBuffer = std::move(rhs.vectorBuffer);
+
+        data = vectorBuffer.empty() ? nullptr : &vectorBuffer[0];
+        rhs.data = nullptr;
+    }
+
+    return *this;
+}
+
 void IndexBuffer::createIndexAttribute(){
     Buffer::addAttribute(AttributeType::INDEX, AttributeDataType::UNSIGNED_SHORT, 1, 0);
     Buffer::setStride(sizeof(uint16_t));
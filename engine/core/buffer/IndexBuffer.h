@@ -22,6 +22,9 @@ namespace doriax {
         IndexBuffer(const IndexBuffer& rhs);
         IndexBuffer& operator=(const IndexBuffer& rhs);
 
+        IndexBuffer(IndexBuffer&& rhs) noexcept;
+        IndexBuffer& operator=(IndexBuffer&& rhs) noexcept;
+
         void createIndexAttribute();
 
         virtual bool increase(size_t newSize);
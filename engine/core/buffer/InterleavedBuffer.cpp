@@ -37,6 +37,28 @@ InterleavedBuffer& InterleavedBuffer::operator=(const InterleavedBuffer& rhs){
     return *this;
 }
 
+InterleavedBuffer::InterleavedBuffer(InterleavedBuffer&& rhs) noexcept: Buffer(std::move(rhs)){
+    vectorBuffer = std::move(rhs.vectorBuffer);
+    vertexSize = rhs.vertexSize;
+
+    data = vectorBuffer.empty() ? nullptr : &vectorBuffer[0];
+    rhs.data = nullptr;
+}
+
+InterleavedBuffer& InterleavedBuffer::operator=(InterleavedBuffer&& rhs) noexcept{
+    if (this != &rhs){
+        Buffer::operator =(std::move(rhs));
+
+        vectorBuffer = std::move(rhs.vectorBuffer);
+        vertexSize = rhs.vertexSize;
+
+        data = vectorBuffer.empty() ? nullptr : &vectorBuffer[0];
+        rhs.data = nullptr;
+    }
+
+    return *this;
+}
+
 bool InterleavedBuffer::increase(size_t newSize) {
     if (newSize >= vectorBuffer.size()) {
         try {
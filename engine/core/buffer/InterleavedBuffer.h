@@ -29,6 +29,9 @@ namespace doriax{
         InterleavedBuffer(const InterleavedBuffer& rhs);
         InterleavedBuffer& operator=(const InterleavedBuffer& rhs);
 
+        InterleavedBuffer(InterleavedBuffer&& rhs) noexcept;
+        InterleavedBuffer& operator=(InterleavedBuffer&& rhs) noexcept;
+
         virtual bool increase(size_t newSize);
         virtual void clearAll();
         virtual void clear();
@@ -0,0 +1,238 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef VERTEXWRITER_H
+#define VERTEXWRITER_H
+
+#include "Buffer.h"
+#include "Log.h"
+#include <cstring>
+#include <initializer_list>
+
+#define MAX_VERTEXWRITER_ATTRIBUTES 8
+
+namespace doriax {
+
+    // Appends whole vertices to a buffer with attribute offsets and stride resolved once.
+    // Attribute and buffer counts are updated by end() or when the writer goes out of scope.
+    class VertexWriter {
+    private:
+        Buffer* buffer;
+        AttributeType types[MAX_VERTEXWRITER_ATTRIBUTES];
+        Attribute* attributes[MAX_VERTEXWRITER_ATTRIBUTES];
+        size_t offsets[MAX_VERTEXWRITER_ATTRIBUTES];
+        size_t sizes[MAX_VERTEXWRITER_ATTRIBUTES];
+        unsigned int numAttributes;
+        size_t stride;
+        size_t packedSize; // one vertex with attributes packed in writer order
+        bool contiguous; // packed vertex is the same as buffer vertex, copied as one block
+        bool valid;
+
+        unsigned int first;
+        unsigned int count;
+
+        static size_t getDataTypeSize(AttributeDataType dataType){
+            switch (dataType){
+                case AttributeDataType::BYTE:
+                case AttributeDataType::UNSIGNED_BYTE:
+                    return 1;
+                case AttributeDataType::SHORT:
+                case AttributeDataType::UNSIGNED_SHORT:
+                    return 2;
+                default:
+                    return 4;
+            }
+        }
+
+        bool checkLayout() const{
+            if (!valid)
+                return false;
+            if (stride != buffer->getStride()){
+                Log::error("Vertex writer layout is outdated, buffer stride changed");
+                return false;
+            }
+            for (unsigned int i = 0; i < numAttributes; i++){
+                Attribute* attribute = buffer->getAttribute(types[i]);
+                if (attribute != attributes[i] || attribute->getOffset() != offsets[i] ||
+                    (attribute->getElements() * getDataTypeSize(attribute->getDataType())) != sizes[i]){
+                    Log::error("Vertex writer layout is outdated, buffer attributes changed");
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        unsigned char* reserveVertices(unsigned int vertices){
+            size_t end = (size_t)(first + count + vertices) * stride;
+            if (end > buffer->getSize()){
+                buffer->increase(end);
+                if (end > buffer->getSize() || !buffer->getData()){
+                    Log::error("Vertex writer cannot increase buffer");
+                    return nullptr;
+                }
+            }
+            return buffer->getData() + ((size_t)(first + count) * stride);
+        }
+
+        template<typename T>
+        void writeValue(unsigned char* vertex, unsigned int index, const T& value){
+            #ifndef NDEBUG
+            if (sizeof(T) != sizes[index]){
+                Log::error("Vertex writer value size does not match attribute size");
+                return;
+            }
+            #endif
+            memcpy(vertex + offsets[index], &value, sizeof(T));
+        }
+
+    public:
+        VertexWriter(Buffer& buffer, std::initializer_list<AttributeType> types){
+            this->buffer = &buffer;
+            this->numAttributes = 0;
+            this->stride = buffer.getStride();
+            this->packedSize = 0;
+            this->contiguous = true;
+            this->valid = true;
+            this->first = 0;
+            this->count = 0;
+
+            if (types.size() > MAX_VERTEXWRITER_ATTRIBUTES){
+                Log::error("Vertex writer supports up to %i attributes", MAX_VERTEXWRITER_ATTRIBUTES);
+                valid = false;
+                return;
+            }
+
+            for (AttributeType type : types){
+                Attribute* attribute = buffer.getAttribute(type);
+                if (!attribute){
+                    Log::error("Vertex writer attribute does not exist in buffer");
+                    valid = false;
+                    return;
+                }
+
+                unsigned int i = numAttributes++;
+                this->types[i] = type;
+                this->attributes[i] = attribute;
+                this->offsets[i] = attribute->getOffset();
+                this->sizes[i] = attribute->getElements() * getDataTypeSize(attribute->getDataType());
+
+                if (offsets[i] != packedSize)
+                    contiguous = false;
+                packedSize += sizes[i];
+
+                if (attribute->getCount() > first)
+                    first = attribute->getCount();
+            }
+
+            if (packedSize != stride)
+                contiguous = false;
+        }
+
+        ~VertexWriter(){
+            end();
+        }
+
+        VertexWriter(const VertexWriter&) = delete;
+        VertexWriter& operator=(const VertexWriter&) = delete;
+
+        bool isValid() const{
+            return valid;
+        }
+
+        // total vertices of buffer after written ones
+        unsigned int getCount() const{
+            return first + count;
+        }
+
+        // grows buffer once to fit more vertices
+        bool reserve(unsigned int vertices){
+            if (!valid)
+                return false;
+            return reserveVertices(vertices) != nullptr;
+        }
+
+        // one value per writer attribute, in writer order
+        template<typename... T>
+        void addVertex(const T&... values){
+            static_assert(sizeof...(T) <= MAX_VERTEXWRITER_ATTRIBUTES, "Too many vertex values");
+
+            if (!valid)
+                return;
+            if (sizeof...(T) != numAttributes){
+                Log::error("Vertex writer expects %u values", numAttributes);
+                return;
+            }
+
+            unsigned char* vertex = reserveVertices(1);
+            if (!vertex)
+                return;
+
+            unsigned int index = 0;
+            (writeValue(vertex, index++, values), ...);
+
+            count++;
+        }
+
+        // vertices with writer attributes packed in order at the start of each element
+        void addVertices(const void* vertices, unsigned int num, size_t vertexSize){
+            #ifndef NDEBUG
+            if (!checkLayout())
+                return;
+            #endif
+            if (!valid || num == 0)
+                return;
+            if (vertexSize < packedSize){
+                Log::error("Vertex writer source vertex is smaller than layout");
+                return;
+            }
+
+            unsigned char* dst = reserveVertices(num);
+            if (!dst)
+                return;
+
+            const unsigned char* src = (const unsigned char*)vertices;
+            if (contiguous && vertexSize == stride){
+                memcpy(dst, src, (size_t)num * stride);
+            }else{
+                for (unsigned int v = 0; v < num; v++){
+                    size_t srcOffset = 0;
+                    for (unsigned int i = 0; i < numAttributes; i++){
+                        memcpy(dst + offsets[i], src + srcOffset, sizes[i]);
+                        srcOffset += sizes[i];
+                    }
+                    dst += stride;
+                    src += vertexSize;
+                }
+            }
+
+            count += num;
+        }
+
+        template<typename V>
+        void addVertices(const V* vertices, unsigned int num){
+            addVertices((const void*)vertices, num, sizeof(V));
+        }
+
+        // updates attribute and buffer counts, writer can continue after it
+        void end(){
+            if (!valid || count == 0)
+                return;
+            #ifndef NDEBUG
+            if (!checkLayout())
+                return;
+            #endif
+
+            unsigned int total = first + count;
+            for (unsigned int i = 0; i < numAttributes; i++){
+                if (attributes[i]->getCount() < total)
+                    attributes[i]->setCount(total);
+            }
+            if (buffer->getCount() < total)
+                buffer->setCount(total);
+        }
+    };
+
+}
+
+#endif //VERTEXWRITER_H
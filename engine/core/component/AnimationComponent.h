@@ -16,6 +16,37 @@ namespace doriax{
         uint32_t track = 0; // Used for editor timeline organization
     };
 
+    enum class AnimationClipTrackType : uint8_t{
+        Translate,
+        Rotate,
+        Scale,
+        Morph
+    };
+
+    struct AnimationClipTrack{
+        AnimationClipTrackType type = AnimationClipTrackType::Translate;
+        Entity target = NULL_ENTITY;
+        int poseBone = -1;
+        float startTime = 0;
+        float duration = 0;
+        float speed = 1;
+        uint32_t timesOffset = 0; // tracks with equal times share the same range
+        uint32_t keysSize = 0;
+        uint32_t valuesOffset = 0;
+        uint32_t rangesOffset = 0; // min and step per component when quantized
+        uint32_t components = 0;
+        uint32_t cursor = 0; // last sampled key
+    };
+
+    // All keyframe tracks of an animation packed together, built when animation starts
+    struct AnimationClip{
+        std::vector<AnimationClipTrack> tracks;
+        std::vector<float> times;
+        std::vector<float> values;
+        std::vector<uint16_t> quantizedValues;
+        std::vector<float> ranges;
+    };
+
     struct DORIAX_API AnimationComponent{
         std::vector<ActionFrame> actions;
         bool ownedActions = false;
@@ -24,6 +55,10 @@ namespace doriax{
         std::string name;
 
         float duration = -1; // -1 is infinite
+
+        bool compactClip = false;
+        bool quantizedClip = false;
+        AnimationClip clip;
     };
 
     
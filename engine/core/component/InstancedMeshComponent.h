@@ -6,6 +6,7 @@
 #define INSTANCED_MESH_COMPONENT_H
 
 #include "math/Rect.h"
+#include "math/AABB.h"
 
 namespace doriax{
 
@@ -24,17 +25,35 @@ namespace doriax{
         Rect textureRect;
     };
 
+    // group of consecutive instances with its own bounds, used for culling
+    struct InstanceChunk{
+        AABB aabb; // local space bounds of visible instances
+        unsigned int start = 0;
+        unsigned int count = 0;
+        unsigned int numVisible = 0;
+        bool inFrustum = false;
+        bool needUpdate = true;
+    };
+
     struct DORIAX_API InstancedMeshComponent{
         ExternalBuffer buffer;
 
         std::vector<InstanceData> instances;
         std::vector<InstanceRenderData> renderInstances; //must be sorted
 
+        std::vector<InstanceChunk> chunks;
+        std::vector<InstanceRenderData> chunkInstances; // visible instances of each chunk, packed from chunk start
+        std::vector<size_t> changedInstances; // updated only these instances, without needUpdateInstances
+
         unsigned int maxInstances = 100;
         unsigned int numVisible = 0;
+        unsigned int chunkSize = 256;
 
         bool instancedBillboard = false;
         bool instancedCylindricalBillboard = false;
+        bool cullInstances = true; // chunks outside main camera are not drawn, off while mesh casts shadows
+        bool instancesCulled = false; // last culling used main camera frustum
+        bool externalRender = false; // renderInstances written directly (particles), instances are not used
 
         bool needUpdateBuffer = false;
         bool needUpdateInstances = true;
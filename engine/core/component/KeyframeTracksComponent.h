@@ -13,6 +13,7 @@ namespace doriax{
         std::vector<float> times;
         int index = 0;
         float interpolation = 0;
+        int poseBone = -1; // bone in target model pose instead of target transform
     };
 
 }
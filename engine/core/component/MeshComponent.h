@@ -6,7 +6,7 @@
 #define MESH_COMPONENT_H
 
 #include "Engine.h"
-#include "util/HybridArray.h"
+#include "util/PooledStorage.h"
 #include "math/Vector3.h"
 #include "math/Quaternion.h"
 #include "math/AABB.h"
@@ -37,6 +37,9 @@ namespace doriax{
         uint32_t shaderProperties = 0;
         uint32_t depthShaderProperties = 0;
 
+        // textures and pipeline state, groups opaque draws
+        uint16_t materialKey = 0;
+
         int slotVSParams = -1;
         int slotFSParams = -1;
         int slotFSLighting = -1;
@@ -75,23 +78,29 @@ namespace doriax{
         bool needUpdateDepthTexture = false;
     };
 
+    // same layout as skinning uniform block
+    struct MeshSkinning{
+        Matrix4 bonesMatrix[MAX_BONES];
+        float normAdjustJoint = 1;
+        float normAdjustWeight = 1;
+        float padding[2] = {0, 0};
+    };
+
     struct MeshComponent{
         bool loaded = false;
         bool loadCalled = false;
 
         InterleavedBuffer buffer;
         IndexBuffer indices;
-        HybridArray<ExternalBuffer, MAX_EXTERNAL_BUFFERS> eBuffers;
+        PooledArray<ExternalBuffer, MAX_EXTERNAL_BUFFERS> eBuffers;
         unsigned int numExternalBuffers = 0;
 
         unsigned int vertexCount = 0;
 
-        HybridArray<Submesh, MAX_SUBMESHES> submeshes;
+        PooledArray<Submesh, MAX_SUBMESHES> submeshes;
         unsigned int numSubmeshes = 0;
 
-        Matrix4 bonesMatrix[MAX_BONES];
-        float normAdjustJoint = 1;
-        float normAdjustWeight = 1;
+        PooledObject<MeshSkinning> skinning;
 
         float morphWeights[MAX_MORPHTARGETS];
 
@@ -14,8 +14,33 @@ namespace tinygltf {class Model;}
 
 namespace doriax{
 
+    class Data;
+
+    // Bone of a compact skeleton, parents are always before their children in pose
+    struct DORIAX_API SkeletonBone{
+        std::string name;
+        int nodeId = -1; // glTF node
+        int parent = -1; // index in pose, -1 for root
+        int index = -1; // skinning matrix
+
+        Vector3 bindPosition;
+        Quaternion bindRotation;
+        Vector3 bindScale = Vector3(1, 1, 1);
+
+        Matrix4 offsetMatrix; // inverse bind matrix
+
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale = Vector3(1, 1, 1);
+
+        Matrix4 modelMatrix; // bone to model space
+
+        Entity entity = NULL_ENTITY; // materialized bone, follows the pose
+    };
+
     struct DORIAX_API ModelComponent{
         tinygltf::Model* gltfModel = NULL;
+        Data* cookedData = NULL; // buffers and textures of cooked model point into it
 
         Matrix4 inverseDerivedTransform;
         
@@ -24,6 +49,11 @@ namespace doriax{
         std::map<std::string, Entity> bonesNameMapping;
         std::map<int, Entity> bonesIdMapping;
 
+        // bones are kept in pose instead of entities, set before loading
+        bool compactSkeleton = false;
+        std::vector<SkeletonBone> pose;
+        bool needUpdatePose = false;
+
         std::map<std::string, int> morphNameMapping;
 
         std::vector<Entity> animations;
@@ -31,6 +31,8 @@ namespace doriax{
         Vector3 toPosition = Vector3(0,0,0);
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleVelocityInitializer{
@@ -46,6 +48,8 @@ namespace doriax{
         Vector3 toVelocity = Vector3(0,0,0);
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleAccelerationInitializer{
@@ -61,6 +65,8 @@ namespace doriax{
         Vector3 toAcceleration = Vector3(0,0,0);
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleColorInitializer{
@@ -78,6 +84,8 @@ namespace doriax{
         Vector3 toColor = Vector3(0,0,0);
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
 
         bool useSRGB = true;
     };
@@ -95,6 +103,8 @@ namespace doriax{
         float toAlpha= 0;
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleSizeInitializer{
@@ -110,6 +120,8 @@ namespace doriax{
         float toSize = 0;
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleSpriteInitializer{
@@ -123,6 +135,8 @@ namespace doriax{
         std::vector<int> frames;
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct ParticleRotationInitializer{
@@ -140,6 +154,8 @@ namespace doriax{
         Quaternion toRotation;
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
 
         bool shortestPath = false;
     };
@@ -159,24 +175,37 @@ namespace doriax{
         Vector3 toScale = Vector3(1,1,1);
 
         FunctionSubscribe<float(float)> function = std::function<float(float)>(Ease::linear);
-    };
-
-    struct ParticleData{
-        float life = 1;
-        Vector3 velocity = Vector3(0,0,0);
-        Vector3 acceleration = Vector3(0,0,0);
-
-        float time = 0;
+        std::vector<float> curve; // function baked in a table
+        unsigned int curveVersion = 0; // function version of baked curve
     };
 
     struct DORIAX_API ParticlesComponent{
-        std::vector<ParticleData> particles;
+        // alive particles are packed in [0, numParticles), one array per attribute
+        std::vector<float> life;
+        std::vector<float> time;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> velocityZ;
+        std::vector<float> accelerationX;
+        std::vector<float> accelerationY;
+        std::vector<float> accelerationZ;
+        std::vector<Vector4> color;
+        std::vector<float> size;
+        std::vector<Quaternion> rotation;
+        std::vector<float> angle; // 2D rotation of points, in radians
+        std::vector<Vector3> scale;
+        std::vector<Rect> textureRect;
+
+        unsigned int numParticles = 0;
+        unsigned int numEmitted = 0;
 
         unsigned int maxParticles = 100;
 
         // animation
         float newParticlesCount = 0;
-        int lastUsedParticle = 0;
         bool emitter = false;
 
         bool loop = true;
@@ -54,6 +54,7 @@ namespace doriax{
         bool autoTransparency = true;
 
         bool hasTextureRect = false;
+        bool externalRender = false; // renderPoints written directly (particles), points are not used
 
         bool needUpdate = true;
         bool needUpdateBuffer = false;
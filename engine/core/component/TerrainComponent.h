@@ -6,6 +6,8 @@
 #define TERRAIN_COMPONENT_H
 
 #define MAX_TERRAINGRID 16
+// heightmap texels per side of each min/max pyramid base cell
+#define TERRAIN_HEIGHT_BLOCK 8
 
 #include "buffer/InterleavedBuffer.h"
 #include "buffer/IndexBuffer.h"
@@ -32,6 +34,21 @@ namespace doriax{
         float visible = false;
     };
 
+    struct TerrainHeightLevel{
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> minValues;
+        std::vector<uint8_t> maxValues;
+    };
+
+    // min and max heightmap values, each level halves the previous one
+    struct TerrainHeightPyramid{
+        std::string id; // heightmap it was built from
+        int width = 0;
+        int height = 0;
+        std::vector<TerrainHeightLevel> levels;
+    };
+
     struct DORIAX_API TerrainComponent{
         // 0 for fullRes and 1 for halfRes
         InterleavedBuffer nodesbuffer[2];
@@ -54,6 +71,8 @@ namespace doriax{
 
         size_t grid[MAX_TERRAINGRID]; //root nodes
 
+        TerrainHeightPyramid heightPyramid;
+
         //-----u_vs_terrainParams
         Vector3 eyePos;
         float terrainSize = 200;
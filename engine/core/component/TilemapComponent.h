@@ -6,7 +6,10 @@
 #define TILEMAP_COMPONENT_H
 
 #include "util/HybridArray.h"
+#include "math/AABB.h"
 #include "Engine.h"
+#include <vector>
+#include <unordered_map>
 
 namespace doriax{
 
@@ -24,6 +27,14 @@ namespace doriax{
         float height;
     };
 
+    // tiles inside one grid cell of the tilemap, with their bounds, used for culling
+    struct TilemapChunk{
+        AABB aabb; // local space bounds of its tiles
+        std::vector<unsigned int> tiles; // rendered tile slots in this cell
+        bool inFrustum = false;
+        bool needUpdate = true;
+    };
+
     struct DORIAX_API TilemapComponent{
         unsigned int width = 0;
         unsigned int height = 0;
@@ -33,8 +44,8 @@ namespace doriax{
 
         float textureScaleFactor = 0.0;
 
-        unsigned int reserveTiles = 10;
-        unsigned int renderedTiles = 0;
+        unsigned int reserveTiles = 10; // extra tile slots in buffers, adding tiles does not reload mesh
+        unsigned int renderedTiles = 0; // tile slots in buffers, 4 vertices each
         
         HybridArray<TileRectData, MAX_TILEMAP_TILESRECT> tilesRect;
         unsigned int numTilesRect = 0;
@@ -42,7 +53,19 @@ namespace doriax{
         HybridArray<TileData, MAX_TILEMAP_TILES> tiles;
         unsigned int numTiles = 0;
 
+        std::vector<TilemapChunk> chunks;
+        std::unordered_map<uint64_t, unsigned int> chunkCells; // grid cell to chunk index
+        Vector2 chunkCellSize; // local size of grid cells
+        std::vector<int> tileSubmeshes; // submesh of each tile slot, -1 when not rendered
+        std::vector<int> tileChunks; // chunk of each tile slot, -1 when not rendered
+        std::vector<size_t> changedTiles; // rewrite only these tiles, without needUpdateTilemap
+
+        unsigned int chunkSize = 16; // grid cells have chunkSize x chunkSize of the largest tile
+        bool cullChunks = true; // chunks outside main camera are not drawn, off while mesh casts shadows
+        bool chunksCulled = false; // last culling used main camera frustum
+
         bool needUpdateTilemap = true;
+        bool needUpdateIndices = false;
     };
 
 }
@@ -4,59 +4,121 @@
 
 #ifndef COMPONENTARRAY_H
 #define COMPONENTARRAY_H
-    
+
 #include <array>
 #include <cassert>
-#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <functional>
 #include <stdexcept>
-#include <numeric>
+#include <limits>
 #include <memory>
+#include <cstdint>
 #include "Entity.h"
 #include "Log.h"
 
 namespace doriax {
 
+    // Ordered: removal keeps relative order of remaining components (needed by Transform
+    // hierarchy and by arrays sorted by Transform)
+    // Unordered: removal moves last component into the hole, O(1)
+    enum class ComponentStorage {
+        Ordered,
+        Unordered
+    };
+
     class DORIAX_API ComponentArrayBase{
+    protected:
+        // incremented whenever relative order of stored components changes
+        uint32_t version = 0;
+        // incremented whenever dense index of a stored component changes (reorders and removals)
+        uint32_t indexVersion = 0;
+
     public:
         virtual ~ComponentArrayBase() = default;
         virtual void entityDestroyed(Entity entity) = 0;
+
+        virtual bool hasEntity(Entity entity) const = 0;
+        virtual size_t getIndex(Entity entity) const = 0;
+        virtual Entity getEntity(size_t index) const = 0;
+        virtual size_t size() const = 0;
+
+        uint32_t getVersion() const {
+            return version;
+        }
+
+        uint32_t getIndexVersion() const {
+            return indexVersion;
+        }
     };
 
 
+    // Sparse set: dense component and entity arrays plus a paged entity->index table
     template<typename T>
     class ComponentArray : public ComponentArrayBase{
     private:
+        static constexpr size_t SPARSE_PAGE_SIZE = 4096;
+        static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+
         std::vector<T> componentArray{};
-        std::unordered_map<Entity, size_t> entityToIndexMap{};
-        std::unordered_map<size_t, Entity> indexToEntityMap{};
+        std::vector<Entity> entityArray{};
+        std::vector<std::vector<size_t>> sparsePages{};
+        ComponentStorage storage;
+
+        size_t sparseGet(Entity entity) const{
+            size_t page = entity / SPARSE_PAGE_SIZE;
+            if (page >= sparsePages.size() || sparsePages[page].empty()){
+                return INVALID_INDEX;
+            }
+            return sparsePages[page][entity % SPARSE_PAGE_SIZE];
+        }
+
+        void sparseSet(Entity entity, size_t index){
+            size_t page = entity / SPARSE_PAGE_SIZE;
+            if (page >= sparsePages.size()){
+                sparsePages.resize(page + 1);
+            }
+            if (sparsePages[page].empty()){
+                sparsePages[page].assign(SPARSE_PAGE_SIZE, INVALID_INDEX);
+            }
+            sparsePages[page][entity % SPARSE_PAGE_SIZE] = index;
+        }
+
+        void updateSparseRange(size_t first, size_t last){
+            for (size_t i = first; i <= last; i++){
+                sparseSet(entityArray[i], i);
+            }
+        }
 
         void moveRange(size_t start, size_t length, size_t dst){
-            typename std::vector<T>::iterator first, middle, last;
+            size_t first, middle, last;
             if (start < dst){
-                first  = componentArray.begin() + start;
-                middle = first + length;
-                last   = componentArray.begin() + dst + length;
+                first  = start;
+                middle = start + length;
+                last   = dst + length;
             }else{
-                first  = componentArray.begin() + dst;
-                middle = componentArray.begin() + start;
-                last   = middle + length;
+                first  = dst;
+                middle = start;
+                last   = start + length;
             }
-            std::rotate(first, middle, last);
+            std::rotate(componentArray.begin() + first, componentArray.begin() + middle, componentArray.begin() + last);
+            std::rotate(entityArray.begin() + first, entityArray.begin() + middle, entityArray.begin() + last);
+
+            updateSparseRange(first, last - 1);
+            version++;
+            indexVersion++;
         }
 
     public:
-        void insert(Entity entity, T component) {
-            if (entityToIndexMap.find(entity) == entityToIndexMap.end()){
+        ComponentArray(ComponentStorage storage = ComponentStorage::Ordered): storage(storage) {}
 
-                size_t newIndex = componentArray.size();
+        void insert(Entity entity, T component) {
+            if (sparseGet(entity) == INVALID_INDEX){
 
-                entityToIndexMap[entity] = newIndex;
-                indexToEntityMap[newIndex] = entity;
+                sparseSet(entity, componentArray.size());
 
-                componentArray.push_back(component);
+                componentArray.push_back(std::move(component));
+                entityArray.push_back(entity);
 
             } else {
                 Log::error("Component added to same entity more than once");
@@ -64,23 +126,34 @@ namespace doriax {
         }
 
         void remove(Entity entity) {
+            size_t indexOfRemovedEntity = sparseGet(entity);
+
+            if (indexOfRemovedEntity != INVALID_INDEX){
+
+                size_t lastIndex = componentArray.size() - 1;
+                if (indexOfRemovedEntity != lastIndex){
+                    indexVersion++;
+                }
 
-            if (entityToIndexMap.find(entity) != entityToIndexMap.end()){
-
-                // Remove component
-                size_t indexOfRemovedEntity = entityToIndexMap[entity];
-                componentArray.erase(componentArray. begin() + indexOfRemovedEntity);
-                size_t componentSize = componentArray.size();
-                
-                // Update maps
-                for (size_t i = indexOfRemovedEntity; i < componentSize; i++){
-                    Entity temp = indexToEntityMap[i+1];
-                    entityToIndexMap[temp] = i;
-                    indexToEntityMap[i] = temp;
+                if (storage == ComponentStorage::Unordered){
+                    if (indexOfRemovedEntity != lastIndex){
+                        componentArray[indexOfRemovedEntity] = std::move(componentArray[lastIndex]);
+                        entityArray[indexOfRemovedEntity] = entityArray[lastIndex];
+                        sparseSet(entityArray[indexOfRemovedEntity], indexOfRemovedEntity);
+                        version++;
+                    }
+                    componentArray.pop_back();
+                    entityArray.pop_back();
+                }else{
+                    componentArray.erase(componentArray.begin() + indexOfRemovedEntity);
+                    entityArray.erase(entityArray.begin() + indexOfRemovedEntity);
+
+                    for (size_t i = indexOfRemovedEntity; i < lastIndex; i++){
+                        sparseSet(entityArray[i], i);
+                    }
                 }
-                
-                entityToIndexMap.erase(entity);
-                indexToEntityMap.erase(componentSize);
+
+                sparseSet(entity, INVALID_INDEX);
 
             } else {
                 Log::error("Removing non-existent component");
@@ -89,138 +162,103 @@ namespace doriax {
 
         void moveEntityRangeToIndex(Entity start, Entity end, size_t newIndex){
 
-            size_t startIndex = entityToIndexMap[start];
-            size_t endIndex = entityToIndexMap[end];
+            size_t startIndex = getIndex(start);
+            size_t endIndex = getIndex(end);
             size_t length = endIndex - startIndex + 1;
-            size_t oldIndex = startIndex;
 
-            if (newIndex < 0 || (newIndex + length) > componentArray.size()){
+            if ((newIndex + length) > componentArray.size()){
                 Log::error("Cannot move entity range out of array");
                 return;
             }
 
-            std::vector<Entity> tmp(length);
-            for (int i = 0; i < length; i++){
-                tmp[i] = indexToEntityMap[oldIndex+i];
-            }
-
-            if (oldIndex > newIndex){
-                for (size_t i = oldIndex+length-1; i > newIndex+length-1; i--){
-                    Entity moved = indexToEntityMap[i-length];
-                    entityToIndexMap[moved] = i;
-                    indexToEntityMap[i] = moved;
-                }
-            }else{
-                for (size_t i = oldIndex; i < newIndex; i++){
-                    Entity moved = indexToEntityMap[i+length];
-                    entityToIndexMap[moved] = i;
-                    indexToEntityMap[i] = moved;
-                }
-            }
-
-            for (int i = 0; i < tmp.size(); i++){
-                entityToIndexMap[tmp[i]] = newIndex+i;
-                indexToEntityMap[newIndex+i] = tmp[i];
+            if (startIndex != newIndex){
+                moveRange(startIndex, length, newIndex);
             }
-
-            moveRange(oldIndex, length, newIndex);
         }
 
         void moveEntityToIndex(Entity entity, size_t newIndex){
 
-            size_t oldIndex = entityToIndexMap[entity];
+            size_t oldIndex = getIndex(entity);
 
-            if (oldIndex > newIndex){
-                for (size_t i = oldIndex; i > newIndex; i--){
-                    Entity moved = indexToEntityMap[i-1];
-                    entityToIndexMap[moved] = i;
-                    indexToEntityMap[i] = moved;
-                }
-            }else{
-                for (size_t i = oldIndex; i < newIndex; i++){
-                    Entity moved = indexToEntityMap[i+1];
-                    entityToIndexMap[moved] = i;
-                    indexToEntityMap[i] = moved;
-                }
+            if (newIndex >= componentArray.size()){
+                Log::error("Cannot move entity out of array");
+                return;
             }
 
-            entityToIndexMap[entity] = newIndex;
-            indexToEntityMap[newIndex] = entity;
-
-            moveRange(oldIndex, 1, newIndex);
+            if (oldIndex != newIndex){
+                moveRange(oldIndex, 1, newIndex);
+            }
         }
 
+        // Reorders to follow the order of otherComponent, components without it go to the end
         template<typename C>
         void sortByComponent(std::shared_ptr<ComponentArray<C>> otherComponent) {
-            // Create a vector of indices [0, 1, ..., N-1]
-            std::vector<size_t> indices(componentArray.size());
-            std::iota(indices.begin(), indices.end(), 0);
-
-            // Sort indices based on the key in otherComponent
-            std::sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
-                Entity ea = indexToEntityMap[a];
-                Entity eb = indexToEntityMap[b];
+            sortByArray(*otherComponent);
+        }
 
-                bool hasA = otherComponent->hasEntity(ea);
-                bool hasB = otherComponent->hasEntity(eb);
+        void sortByArray(const ComponentArrayBase& otherComponent) {
+            std::vector<size_t> indices;
+            indices.reserve(componentArray.size());
 
-                if (!hasA && !hasB) return false;
-                if (!hasA) return false;
-                if (!hasB) return true;
+            for (size_t i = 0; i < otherComponent.size(); i++){
+                size_t index = sparseGet(otherComponent.getEntity(i));
+                if (index != INVALID_INDEX){
+                    indices.push_back(index);
+                }
+            }
 
-                size_t indexA = otherComponent->getIndex(ea);
-                size_t indexB = otherComponent->getIndex(eb);
-                return indexA < indexB;
-            });
+            if (indices.size() != componentArray.size()){
+                for (size_t i = 0; i < entityArray.size(); i++){
+                    if (!otherComponent.hasEntity(entityArray[i])){
+                        indices.push_back(i);
+                    }
+                }
+            }
 
-            // Create new arrays/maps
-            std::vector<T> newComponentArray(componentArray.size());
-            std::unordered_map<Entity, size_t> newEntityToIndexMap;
-            std::unordered_map<size_t, Entity> newIndexToEntityMap;
+            std::vector<T> newComponentArray;
+            std::vector<Entity> newEntityArray;
+            newComponentArray.reserve(componentArray.size());
+            newEntityArray.reserve(entityArray.size());
 
             for (size_t newIndex = 0; newIndex < indices.size(); ++newIndex) {
                 size_t oldIndex = indices[newIndex];
-                Entity entity = indexToEntityMap[oldIndex];
-                newComponentArray[newIndex] = componentArray[oldIndex];
-                newEntityToIndexMap[entity] = newIndex;
-                newIndexToEntityMap[newIndex] = entity;
+                newComponentArray.push_back(std::move(componentArray[oldIndex]));
+                newEntityArray.push_back(entityArray[oldIndex]);
             }
 
-            // Assign new arrays/maps back
             componentArray = std::move(newComponentArray);
-            entityToIndexMap = std::move(newEntityToIndexMap);
-            indexToEntityMap = std::move(newIndexToEntityMap);
-        }
-
-        bool hasEntity(Entity entity) {
-            auto it = entityToIndexMap.find(entity);
+            entityArray = std::move(newEntityArray);
 
-            if (it == entityToIndexMap.end()) {
-                 return false;
+            if (!entityArray.empty()){
+                updateSparseRange(0, entityArray.size() - 1);
             }
+            version++;
+            indexVersion++;
+        }
 
-            return true;
+        bool hasEntity(Entity entity) const override {
+            return sparseGet(entity) != INVALID_INDEX;
         }
 
         T* findComponent(Entity entity) {
-            auto it = entityToIndexMap.find(entity);
+            size_t index = sparseGet(entity);
 
-            if (it == entityToIndexMap.end()) {
+            if (index == INVALID_INDEX) {
                  return NULL;
             }
 
-            return &componentArray[it->second];
+            return &componentArray[index];
         }
 
         T& getComponent(Entity entity) {
-            try{
-
-                return componentArray[entityToIndexMap.at(entity)];
+            size_t index = sparseGet(entity);
 
-            }catch (const std::out_of_range& e){
-                Log::error("Retrieving non-existent component: %s", e.what());
-                throw;
+            if (index == INVALID_INDEX){
+                Log::error("Retrieving non-existent component of entity: %u", entity);
+                throw std::out_of_range("component not found for entity");
             }
+
+            return componentArray[index];
         }
 
         T* findComponentFromIndex(size_t index) {
@@ -242,32 +280,36 @@ namespace doriax {
             }
         }
 
-        size_t getIndex(Entity entity){
-            try{
-
-                return entityToIndexMap.at(entity);
+        size_t getIndex(Entity entity) const override {
+            size_t index = sparseGet(entity);
 
-            }catch (const std::out_of_range& e){
-                Log::error("Retrieving non-existent component: %s", e.what());
-                throw;
+            if (index == INVALID_INDEX){
+                Log::error("Retrieving non-existent component of entity: %u", entity);
+                throw std::out_of_range("component not found for entity");
             }
+
+            return index;
         }
 
-        Entity getEntity(size_t index){
-            if (indexToEntityMap.find(index) == indexToEntityMap.end()){
+        Entity getEntity(size_t index) const override {
+            if (index >= entityArray.size()){
                 Log::error("Entity not found");
                 return NULL_ENTITY;
             }
 
-            return indexToEntityMap[index];
+            return entityArray[index];
         }
 
-        size_t size(){
+        size_t size() const override {
             return componentArray.size();
         }
 
+        ComponentStorage getStorage() const {
+            return storage;
+        }
+
         void entityDestroyed(Entity entity) override {
-            if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+            if (hasEntity(entity)) {
                 remove(entity);
             }
         }
@@ -0,0 +1,25 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#include "ComponentManager.h"
+#include <mutex>
+
+using namespace doriax;
+
+size_t ComponentManager::getTypeIndex(const char* typeName){
+    static std::mutex typeMutex;
+    static std::unordered_map<std::string, size_t> typeIndices;
+
+    std::lock_guard<std::mutex> lock(typeMutex);
+
+    auto it = typeIndices.find(typeName);
+    if (it != typeIndices.end()){
+        return it->second;
+    }
+
+    size_t typeIndex = typeIndices.size();
+    typeIndices[typeName] = typeIndex;
+
+    return typeIndex;
+}
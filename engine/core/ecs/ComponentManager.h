@@ -7,32 +7,64 @@
 
 #include <any>
 #include <memory>
+#include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include "ComponentArray.h"
+#include "Signature.h"
 #include "Log.h"
 
 namespace doriax {
 
 	using ComponentId = unsigned char;
 
+	#define NULL_COMPONENT_ID 255
+
 
 	class DORIAX_API ComponentManager {
 	private:
-		std::unordered_map<std::string, ComponentId> componentTypeIds{};
-		std::unordered_map<std::string, std::shared_ptr<ComponentArrayBase>> componentArrays{};
-		ComponentId nextComponentIdId{};
+		// indexed by type index
+		std::vector<ComponentId> typeComponentIds{};
+		// indexed by ComponentId
+		std::vector<std::shared_ptr<ComponentArrayBase>> componentArrays{};
+		// readable names given at registration, for string lookups (scripting and editor)
+		std::unordered_map<std::string, ComponentId> componentNameIds{};
+
+		// Process wide, so engine and editor modules agree on the same index
+		static size_t getTypeIndex(const char* typeName);
+
+		template<typename T>
+		static size_t getTypeIndex() {
+			static const size_t typeIndex = getTypeIndex(typeid(T).name());
+			return typeIndex;
+		}
+
+		template<typename T>
+		ComponentArray<T>* getComponentArrayPtr() const {
+			return static_cast<ComponentArray<T>*>(componentArrays[getComponentId<T>()].get());
+		}
 
 	public:
 		template<typename T>
-		void registerComponent() {
-			const char* typeName = typeid(T).name();
+		void registerComponent(const std::string& name, ComponentStorage storage = ComponentStorage::Ordered) {
+			size_t typeIndex = getTypeIndex<T>();
+
+			if (typeIndex >= typeComponentIds.size()){
+				typeComponentIds.resize(typeIndex + 1, NULL_COMPONENT_ID);
+			}
+
+			if (componentArrays.size() >= Signature().size()){
+				Log::error("Maximum number of component types reached");
+				return;
+			}
 
-			if (componentTypeIds.find(typeName) == componentTypeIds.end()){
+			if (typeComponentIds[typeIndex] == NULL_COMPONENT_ID){
 
-				componentTypeIds.insert({typeName, nextComponentIdId});
-				componentArrays.insert({typeName, std::make_shared<ComponentArray<T>>()});
+				ComponentId componentId = static_cast<ComponentId>(componentArrays.size());
 
-				++nextComponentIdId;
+				typeComponentIds[typeIndex] = componentId;
+				componentArrays.push_back(std::make_shared<ComponentArray<T>>(storage));
+				componentNameIds[name] = componentId;
 
 			} else {
 				Log::error("Registering component type more than once");
@@ -42,57 +74,69 @@ namespace doriax {
 
 		template<typename T>
 		ComponentId getComponentId() const{
-			const char* typeName = typeid(T).name();
+			size_t typeIndex = getTypeIndex<T>();
 
-			if (componentTypeIds.find(typeName) == componentTypeIds.end())
+			if (typeIndex >= typeComponentIds.size() || typeComponentIds[typeIndex] == NULL_COMPONENT_ID){
 				Log::error("Component not registered before use");
+				throw std::out_of_range("component not registered");
+			}
 
-			return componentTypeIds.at(typeName);
+			return typeComponentIds[typeIndex];
 		}
 
-		template<typename T>
-		std::shared_ptr<ComponentArray<T>> getComponentArray() const {
-			const char* typeName = typeid(T).name();
+		ComponentId getComponentId(const std::string& name) const{
+			auto it = componentNameIds.find(name);
 
-			if (componentTypeIds.find(typeName) == componentTypeIds.end())
-				Log::error("Component not registered before use");
+			if (it == componentNameIds.end()){
+				Log::error("Component not registered: %s", name.c_str());
+				return NULL_COMPONENT_ID;
+			}
 
-			return std::static_pointer_cast<ComponentArray<T>>(componentArrays.at(typeName));
+			return it->second;
+		}
+
+		std::shared_ptr<ComponentArrayBase> getComponentArray(ComponentId componentId) const {
+			return componentArrays.at(componentId);
+		}
+
+		template<typename T>
+		std::shared_ptr<ComponentArray<T>> getComponentArray() const {
+			return std::static_pointer_cast<ComponentArray<T>>(componentArrays[getComponentId<T>()]);
 		}
 
 		template<typename T>
 		void addComponent(Entity entity, T component) {
-			getComponentArray<T>()->insert(entity, component);
+			getComponentArrayPtr<T>()->insert(entity, std::move(component));
 		}
 
 		template<typename T>
 		void removeComponent(Entity entity) {
-			getComponentArray<T>()->remove(entity);
+			getComponentArrayPtr<T>()->remove(entity);
 		}
 
 		template<typename T>
 		T* findComponent(Entity entity) const {
-			return getComponentArray<T>()->findComponent(entity);
+			return getComponentArrayPtr<T>()->findComponent(entity);
 		}
 
 		template<typename T>
 		T& getComponent(Entity entity) const {
-			return getComponentArray<T>()->getComponent(entity);
+			return getComponentArrayPtr<T>()->getComponent(entity);
 		}
 
 		template<typename T>
 	    T* findComponentFromIndex(size_t index) const{
-		    return getComponentArray<T>()->findComponentFromIndex(index);
+		    return getComponentArrayPtr<T>()->findComponentFromIndex(index);
 	    }
 
 		template<typename T>
 	    T& getComponentFromIndex(size_t index) const {
-		    return getComponentArray<T>()->getComponentFromIndex(index);
+		    return getComponentArrayPtr<T>()->getComponentFromIndex(index);
 	    }
 
 		void entityDestroyed(Entity entity) {
-			for (auto const& pair : componentArrays) {
-				pair.second->entityDestroyed(entity);
+			for (auto const& componentArray : componentArrays) {
+				componentArray->entityDestroyed(entity);
 			}
 		}
 	};
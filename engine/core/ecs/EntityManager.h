@@ -5,10 +5,13 @@
 #ifndef ENTITYMANAGER_H
 #define ENTITYMANAGER_H
 
-#include <map>
 #include <vector>
+#include <algorithm>
+#include <functional>
 #include <string>
 #include <limits>
+#include <cstdint>
+#include <unordered_map>
 #include "Entity.h"
 #include "Signature.h"
 #include "Log.h"
@@ -16,8 +19,9 @@
 namespace doriax{
 
     struct EntityMetadata{
-        std::string name;
         Signature signature;
+        uint32_t generation = 0; // incremented when entity is destroyed
+        bool created = false;
     };
 
     class DORIAX_API EntityManager {
@@ -26,18 +30,71 @@ namespace doriax{
         static constexpr Entity LAST_SYSTEM_ENTITY  = 100;
         static constexpr Entity FIRST_USER_ENTITY   = LAST_SYSTEM_ENTITY + 1;
 
+        static constexpr size_t METADATA_PAGE_SIZE = 4096;
+
         Entity lastUserEntity = LAST_SYSTEM_ENTITY; // next user entity starts at 101
-        std::map<Entity, EntityMetadata> metadata;
+        size_t numEntities = 0;
+
+        // indexed by entity id, pages are allocated on demand
+        std::vector<std::vector<EntityMetadata>> metadata;
+        // free system ids, sorted descending so back() is the lowest one
+        std::vector<Entity> freeSystemEntities;
+        // names are rarely accessed, kept out of metadata
+        std::unordered_map<Entity, std::string> names;
+
+        const EntityMetadata* findMetadata(Entity entity) const {
+            size_t page = entity / METADATA_PAGE_SIZE;
+            if (page >= metadata.size() || metadata[page].empty()){
+                return nullptr;
+            }
+            const EntityMetadata& data = metadata[page][entity % METADATA_PAGE_SIZE];
+            return data.created ? &data : nullptr;
+        }
+
+        EntityMetadata* findMetadata(Entity entity) {
+            return const_cast<EntityMetadata*>(static_cast<const EntityManager*>(this)->findMetadata(entity));
+        }
+
+        EntityMetadata& getSlot(Entity entity) {
+            size_t page = entity / METADATA_PAGE_SIZE;
+            if (page >= metadata.size()){
+                metadata.resize(page + 1);
+            }
+            if (metadata[page].empty()){
+                metadata[page].resize(METADATA_PAGE_SIZE);
+            }
+            return metadata[page][entity % METADATA_PAGE_SIZE];
+        }
+
+        void create(Entity entity) {
+            EntityMetadata& data = getSlot(entity);
+            data.signature.reset();
+            data.created = true;
+            numEntities++;
+
+            if (entity >= FIRST_SYSTEM_ENTITY && entity <= LAST_SYSTEM_ENTITY){
+                auto it = std::find(freeSystemEntities.begin(), freeSystemEntities.end(), entity);
+                if (it != freeSystemEntities.end()){
+                    freeSystemEntities.erase(it);
+                }
+            }
+        }
 
     public:
 
+        EntityManager() {
+            for (Entity e = LAST_SYSTEM_ENTITY; e >= FIRST_SYSTEM_ENTITY; --e){
+                freeSystemEntities.push_back(e);
+            }
+        }
+
         static constexpr Entity firstSystemEntity() { return FIRST_SYSTEM_ENTITY; }
         static constexpr Entity lastSystemEntity()  { return LAST_SYSTEM_ENTITY; }
         static constexpr Entity firstUserEntity()   { return FIRST_USER_ENTITY; }
 
         bool recreateEntity(Entity entity) { // for internal editor use only
-            if (!isCreated(entity)){
-                metadata[entity];
+            if (entity != NULL_ENTITY && !isCreated(entity)){
+                create(entity);
                 return true;
             }
             return false;
@@ -57,14 +114,13 @@ namespace doriax{
 
         // System entity in range [1,100], first free slot
         Entity createSystemEntity() {
-            for (Entity e = FIRST_SYSTEM_ENTITY; e <= LAST_SYSTEM_ENTITY; ++e){
-                if (metadata.count(e) == 0){
-                    metadata[e];
-                    return e;
-                }
+            if (freeSystemEntities.empty()){
+                Log::error("No free system entity slot available in range [1..100]");
+                return NULL_ENTITY;
             }
-            Log::error("No free system entity slot available in range [1..100]");
-            return NULL_ENTITY;
+            Entity entity = freeSystemEntities.back();
+            create(entity);
+            return entity;
         }
 
         // User entity in range [101..max], monotonically increasing, skipping used ids
@@ -86,63 +142,106 @@ namespace doriax{
                     candidate = FIRST_USER_ENTITY;
                 }
 
-                if (metadata.count(candidate) == 0){
+                if (!isCreated(candidate)){
                     break;
                 }
             }
 
             lastUserEntity = candidate;
-            metadata[candidate];
+            create(candidate);
             return candidate;
         }
 
         bool isCreated(Entity entity) const {
-            return metadata.count(entity) > 0;
+            return findMetadata(entity) != nullptr;
         }
 
         void destroy(Entity entity) {
-            metadata.erase(entity);
+            EntityMetadata* data = findMetadata(entity);
+            if (!data){
+                return;
+            }
+
+            data->signature.reset();
+            data->created = false;
+            data->generation++;
+            numEntities--;
+
+            names.erase(entity);
+
+            if (entity >= FIRST_SYSTEM_ENTITY && entity <= LAST_SYSTEM_ENTITY){
+                auto it = std::lower_bound(freeSystemEntities.begin(), freeSystemEntities.end(), entity, std::greater<Entity>());
+                freeSystemEntities.insert(it, entity);
+            }
+        }
+
+        // Changes every time the entity id is destroyed, to detect stale handles
+        uint32_t getGeneration(Entity entity) const {
+            size_t page = entity / METADATA_PAGE_SIZE;
+            if (page >= metadata.size() || metadata[page].empty()){
+                return 0;
+            }
+            return metadata[page][entity % METADATA_PAGE_SIZE].generation;
+        }
+
+        bool isAlive(Entity entity, uint32_t generation) const {
+            return isCreated(entity) && getGeneration(entity) == generation;
         }
 
         std::vector<Entity> getEntityList() const{
             std::vector<Entity> list;
-            for (auto const& [key, val] : metadata){
-                list.push_back(key);
+            list.reserve(numEntities);
+            for (size_t page = 0; page < metadata.size() && list.size() < numEntities; page++){
+                for (size_t i = 0; i < metadata[page].size(); i++){
+                    if (metadata[page][i].created){
+                        list.push_back(static_cast<Entity>(page * METADATA_PAGE_SIZE + i));
+                    }
+                }
             }
             return list;
         }
 
         void setSignature(Entity entity, Signature signature) {
-            if (metadata.count(entity)==0){
+            EntityMetadata* data = findMetadata(entity);
+            if (!data){
                 Log::error("Entity does not exist to set signature");
+                return;
             }
-            metadata[entity].signature = signature;
+            data->signature = signature;
         }
 
         Signature getSignature(Entity entity) const{
-            if (metadata.count(entity)==0){
+            const EntityMetadata* data = findMetadata(entity);
+            if (!data){
                 Log::error("Entity does not exist to get signature");
                 return Signature();
             }
-            return metadata.at(entity).signature;
+            return data->signature;
         }
 
         void setName(Entity entity, const std::string& name) {
-            if (metadata.count(entity)==0){
+            if (!isCreated(entity)){
                 Log::error("Entity does not exist to set name");
+                return;
             }
-            metadata[entity].name = name;
+            names[entity] = name;
         }
 
-        std::string getName(Entity entity) const{
-            if (metadata.count(entity)==0){
+        const std::string& getName(Entity entity) const{
+            static const std::string emptyName;
+
+            if (!isCreated(entity)){
                 Log::error("Entity does not exist to get name");
-                return std::string();
+                return emptyName;
+            }
+            auto it = names.find(entity);
+            if (it == names.end()){
+                return emptyName;
             }
-            return metadata.at(entity).name;
+            return it->second;
         }
     };
 
 }
 
-#endif //ENTITYMANAGER_H
\ No newline at end of file
+#endif //ENTITYMANAGER_H
@@ -0,0 +1,112 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef ENTITYVIEW_H
+#define ENTITYVIEW_H
+
+#include <memory>
+#include <vector>
+#include "Entity.h"
+#include "Signature.h"
+#include "ComponentArray.h"
+
+namespace doriax {
+
+    // Entities matching a signature query, kept up to date incrementally by EntityRegistry.
+    // Iteration follows the order of the component array given at creation.
+    class DORIAX_API EntityView {
+    private:
+        Signature required;
+        Signature excluded;
+        std::shared_ptr<ComponentArrayBase> orderArray;
+
+        // stores last known signature of each matching entity
+        ComponentArray<Signature> entries;
+        // dense index in order array of each entry, rebuilt when entries or order array indices change
+        std::vector<size_t> componentIndices;
+        uint32_t orderVersion;
+        uint32_t orderIndexVersion;
+        bool needSort;
+        bool needIndices;
+
+        void updateIfNeeded(){
+            if (needSort || orderVersion != orderArray->getVersion()){
+                entries.sortByArray(*orderArray);
+                orderVersion = orderArray->getVersion();
+                needSort = false;
+                needIndices = true;
+            }
+            if (needIndices || orderIndexVersion != orderArray->getIndexVersion()){
+                componentIndices.resize(entries.size());
+                for (size_t i = 0; i < entries.size(); i++){
+                    componentIndices[i] = orderArray->getIndex(entries.getEntity(i));
+                }
+                orderIndexVersion = orderArray->getIndexVersion();
+                needIndices = false;
+            }
+        }
+
+    public:
+        EntityView(Signature required, Signature excluded, std::shared_ptr<ComponentArrayBase> orderArray):
+            required(required), excluded(excluded), orderArray(orderArray), entries(ComponentStorage::Ordered){
+            this->orderVersion = orderArray->getVersion();
+            this->orderIndexVersion = orderArray->getIndexVersion();
+            this->needSort = false;
+            this->needIndices = false;
+        }
+
+        bool matches(Signature signature) const{
+            return ((signature & required) == required) && (signature & excluded).none();
+        }
+
+        bool isQuery(Signature required, Signature excluded, const ComponentArrayBase* orderArray) const{
+            return this->required == required && this->excluded == excluded && this->orderArray.get() == orderArray;
+        }
+
+        void signatureChanged(Entity entity, Signature signature){
+            Signature* entry = entries.findComponent(entity);
+            if (matches(signature)){
+                if (entry){
+                    *entry = signature;
+                }else{
+                    entries.insert(entity, signature);
+                    needSort = true;
+                }
+            }else if (entry){
+                entries.remove(entity);
+                needIndices = true;
+            }
+        }
+
+        void entityDestroyed(Entity entity){
+            if (entries.hasEntity(entity)){
+                entries.remove(entity);
+                needIndices = true;
+            }
+        }
+
+        // brings order and cached indices up to date, only compares versions when nothing changed.
+        // Check it on every iteration: callbacks in a loop body can add or remove entities of the view.
+        size_t size(){
+            updateIfNeeded();
+            return entries.size();
+        }
+
+        Entity getEntity(size_t index) const{
+            return entries.getEntity(index);
+        }
+
+        Signature getSignature(size_t index){
+            return entries.getComponentFromIndex(index);
+        }
+
+        // index of entity in the order component array, to access it without lookup
+        size_t getComponentIndex(size_t index) const{
+            return componentIndices[index];
+        }
+    };
+
+}
+
+#endif //ENTITYVIEW_H
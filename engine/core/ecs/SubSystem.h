@@ -9,6 +9,7 @@
 #include "Entity.h"
 #include "Signature.h"
 #include "ComponentManager.h"
+#include "EntityView.h"
 #include <set>
 
 namespace doriax{
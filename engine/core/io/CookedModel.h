@@ -0,0 +1,122 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef COOKEDMODEL_H
+#define COOKEDMODEL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#define COOKEDMODEL_MAGIC "DXMD"
+#define COOKEDMODEL_VERSION 2
+#define COOKEDMODEL_ALIGNMENT 16
+
+namespace doriax {
+
+    enum class CookedTextureSource : uint8_t {
+        NONE,
+        PATH,
+        DATA // decoded pixels stored in cooked model
+    };
+
+    // Cooked model is a sequence of little-endian records. Blocks of buffer and texture
+    // data are aligned to COOKEDMODEL_ALIGNMENT so they are used in place after reading.
+    class CookedModelWriter {
+    private:
+        std::vector<unsigned char> data;
+
+    public:
+        const std::vector<unsigned char>& getData() const{
+            return data;
+        }
+
+        void write(const void* value, size_t size){
+            const unsigned char* bytes = (const unsigned char*)value;
+            data.insert(data.end(), bytes, bytes + size);
+        }
+
+        template<typename T>
+        void write(const T& value){
+            static_assert(std::is_trivially_copyable<T>::value, "Cooked model values must be trivially copyable");
+            write(&value, sizeof(T));
+        }
+
+        void writeString(const std::string& value){
+            write<uint32_t>((uint32_t)value.size());
+            write(value.data(), value.size());
+        }
+
+        void writeBlock(const void* value, size_t size){
+            write<uint64_t>((uint64_t)size);
+            data.resize((data.size() + COOKEDMODEL_ALIGNMENT - 1) & ~(size_t)(COOKEDMODEL_ALIGNMENT - 1), 0);
+            write(value, size);
+        }
+    };
+
+    // Reads records in place, any read past the end marks reader as failed
+    class CookedModelReader {
+    private:
+        const unsigned char* data;
+        size_t size;
+        size_t offset;
+        bool failed;
+
+    public:
+        CookedModelReader(const unsigned char* data, size_t size): data(data), size(size), offset(0), failed(false){
+        }
+
+        bool isFailed() const{
+            return failed;
+        }
+
+        bool read(void* value, size_t valueSize){
+            if (failed || valueSize > size - offset){
+                failed = true;
+                memset(value, 0, valueSize);
+                return false;
+            }
+            memcpy(value, data + offset, valueSize);
+            offset += valueSize;
+            return true;
+        }
+
+        template<typename T>
+        T read(){
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        std::string readString(){
+            uint32_t length = read<uint32_t>();
+            if (failed || length > size - offset){
+                failed = true;
+                return "";
+            }
+            std::string value((const char*)(data + offset), length);
+            offset += length;
+            return value;
+        }
+
+        // pointer to block inside data, valid while data is alive
+        const unsigned char* readBlock(size_t& blockSize){
+            uint64_t length = read<uint64_t>();
+            size_t start = (offset + COOKEDMODEL_ALIGNMENT - 1) & ~(size_t)(COOKEDMODEL_ALIGNMENT - 1);
+            if (failed || start > size || length > size - start){
+                failed = true;
+                blockSize = 0;
+                return nullptr;
+            }
+            offset = start + (size_t)length;
+            blockSize = (size_t)length;
+            return data + start;
+        }
+    };
+
+}
+
+#endif //COOKEDMODEL_H
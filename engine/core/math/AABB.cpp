@@ -3,6 +3,7 @@
 #include "Plane.h"
 #include "Log.h"
 #include "OBB.h"
+#include "MathSIMD.h"
 
 using namespace doriax;
 
@@ -263,6 +264,37 @@ AABB& AABB::transform( const Matrix4& matrix ) {
     if( mBoxType != BOXTYPE_FINITE )
         return *this;
 
+#ifdef DORIAX_SIMD
+    const float* m = matrix;
+    simd4f c0 = simd4fLoad(m);
+    simd4f c1 = simd4fLoad(m + 4);
+    simd4f c2 = simd4fLoad(m + 8);
+    simd4f c3 = simd4fLoad(m + 12);
+
+    simd4f x[2] = { simd4fMul(c0, simd4fSplat(mMinimum.x)), simd4fMul(c0, simd4fSplat(mMaximum.x)) };
+    simd4f y[2] = { simd4fMul(c1, simd4fSplat(mMinimum.y)), simd4fMul(c1, simd4fSplat(mMaximum.y)) };
+    simd4f z[2] = { simd4fMul(c2, simd4fSplat(mMinimum.z)), simd4fMul(c2, simd4fSplat(mMaximum.z)) };
+    simd4f one = simd4fSplat(1.0f);
+
+    simd4f vmin = one;
+    simd4f vmax = one;
+    for (int i = 0; i < 8; i++){
+        // same operation order as Matrix4 * Vector3
+        simd4f corner = simd4fAdd(simd4fAdd(simd4fAdd(x[(i >> 2) & 1], y[(i >> 1) & 1]), z[i & 1]), c3);
+        corner = simd4fMul(corner, simd4fDiv(one, simd4fSplatW(corner)));
+
+        vmin = (i == 0) ? corner : simd4fMin(vmin, corner);
+        vmax = (i == 0) ? corner : simd4fMax(vmax, corner);
+    }
+
+    float fmin[4], fmax[4];
+    simd4fStore(fmin, vmin);
+    simd4fStore(fmax, vmax);
+
+    setExtents(Vector3(fmin[0], fmin[1], fmin[2]), Vector3(fmax[0], fmax[1], fmax[2]));
+
+    return *this;
+#else
     Vector3 oldMin, oldMax, currentCorner;
 
     oldMin = mMinimum;
@@ -303,6 +335,16 @@ AABB& AABB::transform( const Matrix4& matrix ) {
     merge( matrix * currentCorner );
 
     return *this;
+#endif
+}
+
+void AABB::transformBoxes(size_t count, const Matrix4* matrices, const AABB* boxes, AABB* out){
+    for (size_t i = 0; i < count; i++){
+        if (&out[i] != &boxes[i]){
+            out[i] = boxes[i];
+        }
+        out[i].transform(matrices[i]);
+    }
 }
 
 void AABB::setNull() {
@@ -85,6 +85,8 @@ namespace doriax{
         AABB& merge( const Vector3& point );
 
         AABB& transform( const Matrix4& matrix );
+        // out[i] = matrices[i] * boxes[i], 'out' can alias 'boxes'
+        static void transformBoxes(size_t count, const Matrix4* matrices, const AABB* boxes, AABB* out);
 
         void setNull();
         bool isNull(void) const;
@@ -0,0 +1,80 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef MATHSIMD_H
+#define MATHSIMD_H
+
+// Internal 4-wide float helpers for math classes, with scalar fallback.
+// Define NO_SIMD_SUPPORT to force the scalar path.
+
+#ifndef NO_SIMD_SUPPORT
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define DORIAX_SIMD_SSE
+#       include <xmmintrin.h>
+#   elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#       define DORIAX_SIMD_NEON
+#       include <arm_neon.h>
+#   endif
+#endif
+
+#if defined(DORIAX_SIMD_SSE) || defined(DORIAX_SIMD_NEON)
+#   define DORIAX_SIMD
+#endif
+
+#ifdef DORIAX_SIMD
+
+namespace doriax {
+
+#ifdef DORIAX_SIMD_SSE
+
+    typedef __m128 simd4f;
+
+    inline simd4f simd4fLoad(const float* p) { return _mm_loadu_ps(p); }
+    inline void simd4fStore(float* p, simd4f v) { _mm_storeu_ps(p, v); }
+    inline simd4f simd4fSet(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+    inline simd4f simd4fSplat(float v) { return _mm_set1_ps(v); }
+    inline simd4f simd4fAdd(simd4f a, simd4f b) { return _mm_add_ps(a, b); }
+    inline simd4f simd4fSub(simd4f a, simd4f b) { return _mm_sub_ps(a, b); }
+    inline simd4f simd4fMul(simd4f a, simd4f b) { return _mm_mul_ps(a, b); }
+    inline simd4f simd4fDiv(simd4f a, simd4f b) { return _mm_div_ps(a, b); }
+    inline simd4f simd4fMin(simd4f a, simd4f b) { return _mm_min_ps(a, b); }
+    inline simd4f simd4fMax(simd4f a, simd4f b) { return _mm_max_ps(a, b); }
+    inline simd4f simd4fSplatW(simd4f v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+#else
+
+    typedef float32x4_t simd4f;
+
+    inline simd4f simd4fLoad(const float* p) { return vld1q_f32(p); }
+    inline void simd4fStore(float* p, simd4f v) { vst1q_f32(p, v); }
+    inline simd4f simd4fSet(float x, float y, float z, float w) { const float v[4] = {x, y, z, w}; return vld1q_f32(v); }
+    inline simd4f simd4fSplat(float v) { return vdupq_n_f32(v); }
+    inline simd4f simd4fAdd(simd4f a, simd4f b) { return vaddq_f32(a, b); }
+    inline simd4f simd4fSub(simd4f a, simd4f b) { return vsubq_f32(a, b); }
+    inline simd4f simd4fMul(simd4f a, simd4f b) { return vmulq_f32(a, b); }
+    inline simd4f simd4fMin(simd4f a, simd4f b) { return vminq_f32(a, b); }
+    inline simd4f simd4fMax(simd4f a, simd4f b) { return vmaxq_f32(a, b); }
+    inline simd4f simd4fSplatW(simd4f v) { return vdupq_n_f32(vgetq_lane_f32(v, 3)); }
+#   if defined(__aarch64__) || defined(_M_ARM64)
+    inline simd4f simd4fDiv(simd4f a, simd4f b) { return vdivq_f32(a, b); }
+#   else
+    // ARMv7 NEON has no exact division
+    inline simd4f simd4fDiv(simd4f a, simd4f b) {
+        float va[4], vb[4];
+        vst1q_f32(va, a);
+        vst1q_f32(vb, b);
+        return simd4fSet(va[0] / vb[0], va[1] / vb[1], va[2] / vb[2], va[3] / vb[3]);
+    }
+#   endif
+
+#endif
+
+    // a + b * c, kept as separate multiply and add to match scalar results
+    inline simd4f simd4fMulAdd(simd4f a, simd4f b, simd4f c) { return simd4fAdd(a, simd4fMul(b, c)); }
+
+}
+
+#endif //DORIAX_SIMD
+
+#endif //MATHSIMD_H
@@ -9,6 +9,7 @@
 #include "Quaternion.h"
 #include "AABB.h"
 #include "OBB.h"
+#include "MathSIMD.h"
 
 using namespace doriax;
 
@@ -56,13 +57,28 @@ Matrix4& Matrix4::operator=(const Matrix4 &m){
 Matrix4 Matrix4::operator *(const Matrix4 &m) const{
     Matrix4 prod;
 
+#ifdef DORIAX_SIMD
+    simd4f c0 = simd4fLoad(matrix[0]);
+    simd4f c1 = simd4fLoad(matrix[1]);
+    simd4f c2 = simd4fLoad(matrix[2]);
+    simd4f c3 = simd4fLoad(matrix[3]);
+
+    for (int c=0;c<4;c++){
+        simd4f col = simd4fMul(c0, simd4fSplat(m.matrix[c][0]));
+        col = simd4fMulAdd(col, c1, simd4fSplat(m.matrix[c][1]));
+        col = simd4fMulAdd(col, c2, simd4fSplat(m.matrix[c][2]));
+        col = simd4fMulAdd(col, c3, simd4fSplat(m.matrix[c][3]));
+        simd4fStore(prod.matrix[c], col);
+    }
+#else
     for (int c=0;c<4;c++)
         for (int r=0;r<4;r++)
-            prod.set(c,r,
-                m.get(c,0)*get(0,r) +
-                m.get(c,1)*get(1,r) +
-                m.get(c,2)*get(2,r) +
-                m.get(c,3)*get(3,r));
+            prod.matrix[c][r] =
+                m.matrix[c][0]*matrix[0][r] +
+                m.matrix[c][1]*matrix[1][r] +
+                m.matrix[c][2]*matrix[2][r] +
+                m.matrix[c][3]*matrix[3][r];
+#endif
 
     return prod;
 }
@@ -88,28 +104,26 @@ std::string Matrix4::toString() const{
 
 Matrix4 Matrix4::operator +(const Matrix4 &m) const{
     Matrix4 prod;
-    Vector4 resul;
-    int i;
-    for(i=0; i<4; ++i){
-        resul = row(i) + m.row(i);
-        prod.set(0, i, resul.x);
-        prod.set(1, i, resul.y);
-        prod.set(2, i, resul.z);
-        prod.set(3, i, resul.w);
+    for (int c=0;c<4;c++){
+#ifdef DORIAX_SIMD
+        simd4fStore(prod.matrix[c], simd4fAdd(simd4fLoad(matrix[c]), simd4fLoad(m.matrix[c])));
+#else
+        for (int r=0;r<4;r++)
+            prod.matrix[c][r] = matrix[c][r] + m.matrix[c][r];
+#endif
     }
     return prod;
 }
 
 Matrix4 Matrix4::operator -(const Matrix4 &m) const{
     Matrix4 prod;
-    Vector4 resul;
-    int i;
-    for(i=0; i<4; ++i){
-        resul = row(i) - m.row(i);
-        prod.set(0, i, resul.x);
-        prod.set(1, i, resul.y);
-        prod.set(2, i, resul.z);
-        prod.set(3, i, resul.w);
+    for (int c=0;c<4;c++){
+#ifdef DORIAX_SIMD
+        simd4fStore(prod.matrix[c], simd4fSub(simd4fLoad(matrix[c]), simd4fLoad(m.matrix[c])));
+#else
+        for (int r=0;r<4;r++)
+            prod.matrix[c][r] = matrix[c][r] - m.matrix[c][r];
+#endif
     }
     return prod;
 }
@@ -129,6 +143,18 @@ Matrix4& Matrix4::operator*=(float scalar) {
 }
 
 Vector3 Matrix4::operator*(const Vector3 &v) const{
+#ifdef DORIAX_SIMD
+    simd4f prodv = simd4fMul(simd4fLoad(matrix[0]), simd4fSplat(v.x));
+    prodv = simd4fMulAdd(prodv, simd4fLoad(matrix[1]), simd4fSplat(v.y));
+    prodv = simd4fMulAdd(prodv, simd4fLoad(matrix[2]), simd4fSplat(v.z));
+    prodv = simd4fAdd(prodv, simd4fLoad(matrix[3]));
+    prodv = simd4fMul(prodv, simd4fDiv(simd4fSplat(1.0f), simd4fSplatW(prodv)));
+
+    float prod[4];
+    simd4fStore(prod, prodv);
+
+    return Vector3(prod[0],prod[1],prod[2]);
+#else
     float prod[4] = { 0,0,0,0 };
 
     for (int r=0;r<4;r++)
@@ -142,18 +168,27 @@ Vector3 Matrix4::operator*(const Vector3 &v) const{
     float div = 1.0 / prod[3];
 
     return Vector3(prod[0]*div,prod[1]*div,prod[2]*div);
+#endif
 }
 
 Vector4 Matrix4::operator*(const Vector4 &v) const{
 
     float prod[4] = { 0,0,0,0 };
 
+#ifdef DORIAX_SIMD
+    simd4f prodv = simd4fMul(simd4fLoad(matrix[0]), simd4fSplat(v.x));
+    prodv = simd4fMulAdd(prodv, simd4fLoad(matrix[1]), simd4fSplat(v.y));
+    prodv = simd4fMulAdd(prodv, simd4fLoad(matrix[2]), simd4fSplat(v.z));
+    prodv = simd4fMulAdd(prodv, simd4fLoad(matrix[3]), simd4fSplat(v.w));
+    simd4fStore(prod, prodv);
+#else
     int i, j;
     for(j=0; j<4; ++j) {
         prod[j] = 0.f;
         for(i=0; i<4; ++i)
             prod[j] += get(i,j) * v[i];
     }
+#endif
 
     return Vector4(prod[0] ,prod[1] ,prod[2], prod[3]);
 }
@@ -320,9 +355,21 @@ Matrix4 Matrix4::inverse() const{
 Matrix4 Matrix4::transpose() const{
     Matrix4 tmp;
 
+#ifdef DORIAX_SIMD_SSE
+    __m128 c0 = _mm_loadu_ps(matrix[0]);
+    __m128 c1 = _mm_loadu_ps(matrix[1]);
+    __m128 c2 = _mm_loadu_ps(matrix[2]);
+    __m128 c3 = _mm_loadu_ps(matrix[3]);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(tmp.matrix[0], c0);
+    _mm_storeu_ps(tmp.matrix[1], c1);
+    _mm_storeu_ps(tmp.matrix[2], c2);
+    _mm_storeu_ps(tmp.matrix[3], c3);
+#else
     for (int i=0;i<4;i++)
         for (int j=0;j<4;j++)
-            tmp.set(j,i,get(i,j));
+            tmp.matrix[j][i] = matrix[i][j];
+#endif
 
     return tmp;
 }
@@ -731,4 +778,57 @@ void Matrix4::decomposeQDU(Vector3& position, Vector3& scale, Quaternion& rotati
 
 void Matrix4::decompose(Vector3& position, Vector3& scale, Quaternion& rotation) const{
     decomposeQDU(position, scale, rotation);
-}
\ No newline at end of file
+}
+
+Matrix4 Matrix4::composeMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale){
+    // same result as translateMatrix * getRotationMatrix * scaleMatrix, without the products
+    Matrix4 r = rotation.getRotationMatrix();
+
+    for (int i=0;i<3;i++){
+        r.matrix[0][i] *= scale.x;
+        r.matrix[1][i] *= scale.y;
+        r.matrix[2][i] *= scale.z;
+    }
+
+    r.matrix[3][0] = position.x;
+    r.matrix[3][1] = position.y;
+    r.matrix[3][2] = position.z;
+
+    return r;
+}
+
+void Matrix4::composeMatrices(size_t count, const Vector3* positions, const Quaternion* rotations, const Vector3* scales, Matrix4* out){
+    for (size_t i = 0; i < count; i++){
+        out[i] = composeMatrix(positions[i], rotations[i], scales[i]);
+    }
+}
+
+void Matrix4::multiplyMatrices(size_t count, const Matrix4& lhs, const Matrix4* rhs, Matrix4* out){
+#ifdef DORIAX_SIMD
+    simd4f c0 = simd4fLoad(lhs.matrix[0]);
+    simd4f c1 = simd4fLoad(lhs.matrix[1]);
+    simd4f c2 = simd4fLoad(lhs.matrix[2]);
+    simd4f c3 = simd4fLoad(lhs.matrix[3]);
+
+    for (size_t i = 0; i < count; i++){
+        const Matrix4& m = rhs[i];
+        float prod[4][4];
+
+        for (int c=0;c<4;c++){
+            simd4f col = simd4fMul(c0, simd4fSplat(m.matrix[c][0]));
+            col = simd4fMulAdd(col, c1, simd4fSplat(m.matrix[c][1]));
+            col = simd4fMulAdd(col, c2, simd4fSplat(m.matrix[c][2]));
+            col = simd4fMulAdd(col, c3, simd4fSplat(m.matrix[c][3]));
+            simd4fStore(prod[c], col);
+        }
+
+        // rhs and out can be the same array
+        memcpy(out[i].matrix, prod, sizeof(prod));
+    }
+#else
+    for (size_t i = 0; i < count; i++){
+        out[i] = lhs * rhs[i];
+    }
+#endif
+}
+
@@ -79,6 +79,9 @@ namespace doriax {
         static Matrix4 scaleMatrix(const float sf);
         static Matrix4 scaleMatrix(const Vector3& sf);
 
+        // translate * rotate * scale
+        static Matrix4 composeMatrix(const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
         static Matrix4 lookAtMatrix(Vector3 eye, Vector3 center, Vector3 up);
         static Matrix4 frustumMatrix(float left, float right, float bottom, float top, float near, float far);
         static Matrix4 orthoMatrix(float l, float r, float b, float t, float n, float f);
@@ -87,6 +90,10 @@ namespace doriax {
         void decomposeStandard(Vector3& position, Vector3& scale, Quaternion& rotation) const;
         void decomposeQDU(Vector3& position, Vector3& scale, Quaternion& rotation) const;
         void decompose(Vector3& position, Vector3& scale, Quaternion& rotation) const;
+
+        // batch versions, 'out' can alias the input arrays
+        static void composeMatrices(size_t count, const Vector3* positions, const Quaternion* rotations, const Vector3* scales, Matrix4* out);
+        static void multiplyMatrices(size_t count, const Matrix4& lhs, const Matrix4* rhs, Matrix4* out);
     };
     
 }
@@ -416,9 +416,12 @@ void Mesh::addInstance(InstanceData instance){
     if (instmesh.maxInstances < instmesh.instances.size()){
         instmesh.maxInstances = instmesh.maxInstances * 2;
         mesh.needReload = true;
-    }
 
-    instmesh.needUpdateInstances = true;
+        instmesh.needUpdateInstances = true;
+    }else{
+        // last chunk grows or a new chunk is added, other chunks are kept
+        instmesh.changedInstances.push_back(instmesh.instances.size() - 1);
+    }
 }
 
 void Mesh::addInstance(Vector3 position){
@@ -480,7 +483,7 @@ void Mesh::updateInstance(size_t index, InstanceData instance){
 
     instmesh.instances.at(index) = instance;
 
-    instmesh.needUpdateInstances = true;
+    instmesh.changedInstances.push_back(index);
 }
 
 void Mesh::updateInstance(size_t index, Vector3 position){
@@ -553,13 +556,62 @@ void Mesh::setInstanceVisible(size_t index, bool visible) const{
         if (instmesh.instances.at(index).visible != visible){
             instmesh.instances.at(index).visible = visible;
 
-            instmesh.needUpdateInstances = true;
+            instmesh.changedInstances.push_back(index);
         }
     }else{
         Log::error("There is no instanced mesh component in this mesh");
     }
 }
 
+void Mesh::setInstanceCulling(bool instanceCulling){
+    createInstancedMesh();
+    InstancedMeshComponent& instmesh = getComponent<InstancedMeshComponent>();
+
+    if (instmesh.cullInstances != instanceCulling){
+        instmesh.cullInstances = instanceCulling;
+
+        instmesh.needUpdateInstances = true;
+    }
+}
+
+bool Mesh::isInstanceCulling() const{
+    if (hasInstancedMesh()){
+        InstancedMeshComponent& instmesh = getComponent<InstancedMeshComponent>();
+
+        return instmesh.cullInstances;
+    }
+
+    return false;
+}
+
+void Mesh::setInstanceChunkSize(unsigned int chunkSize){
+    createInstancedMesh();
+    InstancedMeshComponent& instmesh = getComponent<InstancedMeshComponent>();
+
+    if (chunkSize == 0){
+        Log::error("Instance chunk size must be greater than zero");
+        return;
+    }
+
+    if (instmesh.chunkSize != chunkSize){
+        instmesh.chunkSize = chunkSize;
+        instmesh.chunks.clear();
+
+        instmesh.needUpdateInstances = true;
+    }
+}
+
+unsigned int Mesh::getInstanceChunkSize() const{
+    if (hasInstancedMesh()){
+        InstancedMeshComponent& instmesh = getComponent<InstancedMeshComponent>();
+
+        return instmesh.chunkSize;
+    }
+
+    Log::error("There is no instanced mesh component in this mesh");
+    return 0;
+}
+
 void Mesh::updateInstances(){
     if (hasInstancedMesh()){
         InstancedMeshComponent& instmesh = getComponent<InstancedMeshComponent>();
@@ -120,6 +120,12 @@ namespace doriax{
         bool isInstanceVisible(size_t index);
         void setInstanceVisible(size_t index, bool visible) const;
 
+        void setInstanceCulling(bool instanceCulling);
+        bool isInstanceCulling() const;
+
+        void setInstanceChunkSize(unsigned int chunkSize);
+        unsigned int getInstanceChunkSize() const;
+
         void updateInstances();
         size_t getNumInstances();
 
@@ -41,6 +41,9 @@ bool Model::loadModel(const std::string& filename){
     if (ext.compare("obj") == 0) {
         if (!loadOBJ(filename))
             return false;
+    }else if (ext.compare("dmodel") == 0) {
+        if (!loadCookedModel(filename))
+            return false;
     }else{
         if (!loadGLTF(filename))
             return false;
@@ -92,6 +95,35 @@ bool Model::loadGLTF(const std::string& filename){
     return ret;
 }
 
+bool Model::loadCookedModel(const std::string& filename){
+    MeshComponent& mesh = getComponent<MeshComponent>();
+    ModelComponent& model = getComponent<ModelComponent>();
+
+    if (isEntityOwned()){
+        scene->getSystem<MeshSystem>()->clearBoneMapping(model);
+        scene->getSystem<MeshSystem>()->clearAnimationMapping(model);
+    }
+
+    bool ret = scene->getSystem<MeshSystem>()->loadCookedModel(entity, filename);
+
+    if (ret){
+        if (isEntityOwned()){
+            for (Entity anim : model.animations){
+                if (scene->getSignature(anim).test(scene->getComponentId<AnimationComponent>())){
+                    scene->getComponent<AnimationComponent>(anim).ownedActions = true;
+                }
+            }
+        }
+        mesh.needReload = true;
+    }
+
+    return ret;
+}
+
+bool Model::cookModel(const std::string& filename){
+    return scene->getSystem<MeshSystem>()->cookModel(entity, filename);
+}
+
 Animation Model::getAnimation(int index){
     ModelComponent& model = getComponent<ModelComponent>();
 
@@ -120,9 +152,29 @@ Animation Model::findAnimation(const std::string& name){
     throw std::out_of_range("vector animations is out of range");
 }
 
+void Model::setCompactSkeleton(bool compactSkeleton){
+    ModelComponent& model = getComponent<ModelComponent>();
+
+    model.compactSkeleton = compactSkeleton;
+}
+
+bool Model::isCompactSkeleton() const{
+    ModelComponent& model = getComponent<ModelComponent>();
+
+    return model.compactSkeleton;
+}
+
 Bone Model::getBone(const std::string& name){
     ModelComponent& model = getComponent<ModelComponent>();
 
+    if (!model.bonesNameMapping.count(name)){
+        for (int i = 0; i < (int)model.pose.size(); i++){
+            if (model.pose[i].name == name){
+                return Bone(scene, scene->getSystem<MeshSystem>()->createSkeletonBoneEntity(entity, model, i));
+            }
+        }
+    }
+
     try{
         return Bone(scene, model.bonesNameMapping.at(name));
     }catch (const std::out_of_range& e){
@@ -134,6 +186,14 @@ Bone Model::getBone(const std::string& name){
 Bone Model::getBone(int id){
     ModelComponent& model = getComponent<ModelComponent>();
 
+    if (!model.bonesIdMapping.count(id)){
+        for (int i = 0; i < (int)model.pose.size(); i++){
+            if (model.pose[i].nodeId == id){
+                return Bone(scene, scene->getSystem<MeshSystem>()->createSkeletonBoneEntity(entity, model, i));
+            }
+        }
+    }
+
     try{
         return Bone(scene, model.bonesIdMapping.at(id));
     }catch (const std::out_of_range& e){
@@ -22,10 +22,18 @@ namespace doriax{
 
         bool loadOBJ(const std::string& filename);
         bool loadGLTF(const std::string& filename);
+        bool loadCookedModel(const std::string& filename);
+
+        // writes loaded model as .dmodel, skinned models need compact skeleton
+        bool cookModel(const std::string& filename);
 
         Animation getAnimation(int index);
         Animation findAnimation(const std::string& name);
 
+        // bones are not entities, getBone creates one that follows the pose
+        void setCompactSkeleton(bool compactSkeleton);
+        bool isCompactSkeleton() const;
+
         Bone getBone(const std::string& name);
         Bone getBone(int id);
 
@@ -196,14 +196,23 @@ void Tilemap::addTile(int id, const std::string& name, int rectId, Vector2 posit
 
     if (tilemap.tiles.validIndex(id)){
         tilemap.tiles[id] = {name, rectId, position, width, height};
+
+        // tiles inside buffer slots only rewrite their chunks
+        unsigned int first = (unsigned int)id;
         if ((unsigned int)(id + 1) > tilemap.numTiles){
+            first = tilemap.numTiles;
             tilemap.numTiles = id + 1;
         }
+        if ((unsigned int)id < tilemap.renderedTiles){
+            for (unsigned int i = first; i <= (unsigned int)id; i++){
+                tilemap.changedTiles.push_back(i);
+            }
+        }else{
+            tilemap.needUpdateTilemap = true;
+        }
     }else{
         Log::error("Error adding tile with id %i", id);
     }
-
-    tilemap.needUpdateTilemap = true;
 }
 
 void Tilemap::addTile(const std::string& name, int rectId, Vector2 position, float width, float height){
@@ -290,6 +299,44 @@ unsigned int Tilemap::getReserveTiles() const{
     return tilemap.reserveTiles;
 }
 
+void Tilemap::setChunkCulling(bool chunkCulling){
+    TilemapComponent& tilemap = getComponent<TilemapComponent>();
+
+    if (tilemap.cullChunks != chunkCulling){
+        tilemap.cullChunks = chunkCulling;
+
+        tilemap.needUpdateIndices = true;
+    }
+}
+
+bool Tilemap::isChunkCulling() const{
+    TilemapComponent& tilemap = getComponent<TilemapComponent>();
+
+    return tilemap.cullChunks;
+}
+
+void Tilemap::setChunkSize(unsigned int chunkSize){
+    TilemapComponent& tilemap = getComponent<TilemapComponent>();
+
+    if (chunkSize == 0){
+        Log::error("Tilemap chunk size must be greater than zero");
+        return;
+    }
+
+    if (tilemap.chunkSize != chunkSize){
+        tilemap.chunkSize = chunkSize;
+        tilemap.chunks.clear();
+
+        tilemap.needUpdateTilemap = true;
+    }
+}
+
+unsigned int Tilemap::getChunkSize() const{
+    TilemapComponent& tilemap = getComponent<TilemapComponent>();
+
+    return tilemap.chunkSize;
+}
+
 unsigned int Tilemap::getWidth(){
     TilemapComponent& tilemap = getComponent<TilemapComponent>();
 
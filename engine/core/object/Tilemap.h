@@ -52,6 +52,12 @@ namespace doriax{
         void setReserveTiles(unsigned int reserveTiles);
         unsigned int getReserveTiles() const;
 
+        void setChunkCulling(bool chunkCulling);
+        bool isChunkCulling() const;
+
+        void setChunkSize(unsigned int chunkSize);
+        unsigned int getChunkSize() const;
+
         unsigned int getWidth();
         unsigned int getHeight();
 
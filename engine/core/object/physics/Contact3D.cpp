@@ -3,6 +3,7 @@
 //
 
 #include "Contact3D.h"
+#include "Log.h"
 
 #include "Jolt/Jolt.h"
 #include "Jolt/Physics/Body/Body.h"
@@ -12,10 +13,35 @@ using namespace doriax;
 
 Contact3D::Contact3D(Scene* scene, const JPH::Body* body1, const JPH::Body* body2, const JPH::ContactManifold* contactManifold, JPH::ContactSettings* contactSettings){
     this->scene = scene;
-    this->body1 = body1;
-    this->body2 = body2;
     this->contactManifold = contactManifold;
     this->contactSettings = contactSettings;
+
+    this->baseOffset = Vector3(contactManifold->mBaseOffset.GetX(), contactManifold->mBaseOffset.GetY(), contactManifold->mBaseOffset.GetZ());
+    this->worldSpaceNormal = Vector3(contactManifold->mWorldSpaceNormal.GetX(), contactManifold->mWorldSpaceNormal.GetY(), contactManifold->mWorldSpaceNormal.GetZ());
+    this->penetrationDepth = contactManifold->mPenetrationDepth;
+    this->shapeIndex1 = body1->GetShape()->GetSubShapeUserData(contactManifold->mSubShapeID1);
+    this->shapeIndex2 = body2->GetShape()->GetSubShapeUserData(contactManifold->mSubShapeID2);
+    this->pointsOn1 = contactManifold->mRelativeContactPointsOn1.data();
+    this->pointsOn2 = contactManifold->mRelativeContactPointsOn2.data();
+    this->numPoints1 = contactManifold->mRelativeContactPointsOn1.size();
+    this->numPoints2 = contactManifold->mRelativeContactPointsOn2.size();
+}
+
+Contact3D::Contact3D(Scene* scene, Vector3 baseOffset, Vector3 worldSpaceNormal, float penetrationDepth, size_t shapeIndex1, size_t shapeIndex2,
+                     const JPH::Vec3* pointsOn1, size_t numPoints1, const JPH::Vec3* pointsOn2, size_t numPoints2, JPH::ContactSettings* contactSettings){
+    this->scene = scene;
+    this->contactManifold = nullptr;
+    this->contactSettings = contactSettings;
+
+    this->baseOffset = baseOffset;
+    this->worldSpaceNormal = worldSpaceNormal;
+    this->penetrationDepth = penetrationDepth;
+    this->shapeIndex1 = shapeIndex1;
+    this->shapeIndex2 = shapeIndex2;
+    this->pointsOn1 = pointsOn1;
+    this->pointsOn2 = pointsOn2;
+    this->numPoints1 = numPoints1;
+    this->numPoints2 = numPoints2;
 }
 
 Contact3D::~Contact3D(){
@@ -23,20 +49,23 @@ Contact3D::~Contact3D(){
 }
 
 Contact3D::Contact3D(const Contact3D& rhs){
-    scene = rhs.scene;
-    body1 = rhs.body1;
-    body2 = rhs.body2;
-    contactManifold = rhs.contactManifold;
-    contactSettings = rhs.contactSettings;
+    *this = rhs;
 }
 
 Contact3D& Contact3D::operator=(const Contact3D& rhs){
     scene = rhs.scene;
-    body1 = rhs.body1;
-    body2 = rhs.body2;
     contactManifold = rhs.contactManifold;
     contactSettings = rhs.contactSettings;
-    
+    baseOffset = rhs.baseOffset;
+    worldSpaceNormal = rhs.worldSpaceNormal;
+    penetrationDepth = rhs.penetrationDepth;
+    shapeIndex1 = rhs.shapeIndex1;
+    shapeIndex2 = rhs.shapeIndex2;
+    pointsOn1 = rhs.pointsOn1;
+    pointsOn2 = rhs.pointsOn2;
+    numPoints1 = rhs.numPoints1;
+    numPoints2 = rhs.numPoints2;
+
     return *this;
 }
 
@@ -49,35 +78,51 @@ JPH::ContactSettings* Contact3D::getJoltContactSettings() const{
 }
 
 Vector3 Contact3D::getBaseOffset() const{
-    return Vector3(contactManifold->mBaseOffset.GetX(), contactManifold->mBaseOffset.GetY(), contactManifold->mBaseOffset.GetZ());
+    return baseOffset;
 }
 
 Vector3 Contact3D::getWorldSpaceNormal() const{
-    return Vector3(contactManifold->mWorldSpaceNormal.GetX(), contactManifold->mWorldSpaceNormal.GetY(), contactManifold->mWorldSpaceNormal.GetZ());
+    return worldSpaceNormal;
 }
 
 float Contact3D::getPenetrationDepth() const{
-    return contactManifold->mPenetrationDepth;
+    return penetrationDepth;
 }
 
 size_t Contact3D::getShapeIndex1() const{
-    return body1->GetShape()->GetSubShapeUserData(contactManifold->mSubShapeID1);
+    return shapeIndex1;
 }
 
 size_t Contact3D::getShapeIndex2() const{
-    return body2->GetShape()->GetSubShapeUserData(contactManifold->mSubShapeID2);
+    return shapeIndex2;
 }
 
 Vector3 Contact3D::getRelativeContactPointsOnA(size_t index) const{
-    JPH::Vec3 point = contactManifold->mRelativeContactPointsOn1[index];
+    if (index >= numPoints1){
+        Log::error("Contact point %lu is out of range", (unsigned long)index);
+        return Vector3::ZERO;
+    }
+    JPH::Vec3 point = pointsOn1[index];
     return Vector3(point.GetX(), point.GetY(), point.GetZ());
 }
 
 Vector3 Contact3D::getRelativeContactPointsOnB(size_t index) const{
-    JPH::Vec3 point = contactManifold->mRelativeContactPointsOn2[index];
+    if (index >= numPoints2){
+        Log::error("Contact point %lu is out of range", (unsigned long)index);
+        return Vector3::ZERO;
+    }
+    JPH::Vec3 point = pointsOn2[index];
     return Vector3(point.GetX(), point.GetY(), point.GetZ());
 }
 
+size_t Contact3D::getNumContactPointsOnA() const{
+    return numPoints1;
+}
+
+size_t Contact3D::getNumContactPointsOnB() const{
+    return numPoints2;
+}
+
 float Contact3D::getCombinedFriction() const{
     return contactSettings->mCombinedFriction;
 }
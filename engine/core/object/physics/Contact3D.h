@@ -16,13 +16,24 @@ namespace doriax{
     class DORIAX_API Contact3D{
     private:
         Scene* scene;
-        const JPH::Body* body1;
-        const JPH::Body* body2;
         const JPH::ContactManifold* contactManifold;
         JPH::ContactSettings* contactSettings;
 
+        Vector3 baseOffset;
+        Vector3 worldSpaceNormal;
+        float penetrationDepth;
+        size_t shapeIndex1;
+        size_t shapeIndex2;
+        const JPH::Vec3* pointsOn1;
+        const JPH::Vec3* pointsOn2;
+        size_t numPoints1;
+        size_t numPoints2;
+
     public:
         Contact3D(Scene* scene, const JPH::Body* body1, const JPH::Body* body2, const JPH::ContactManifold* contactManifold, JPH::ContactSettings* contactSettings);
+        // from a contact recorded during the step, manifold is not available
+        Contact3D(Scene* scene, Vector3 baseOffset, Vector3 worldSpaceNormal, float penetrationDepth, size_t shapeIndex1, size_t shapeIndex2,
+                  const JPH::Vec3* pointsOn1, size_t numPoints1, const JPH::Vec3* pointsOn2, size_t numPoints2, JPH::ContactSettings* contactSettings);
         virtual ~Contact3D();
 
         Contact3D(const Contact3D& rhs);
@@ -39,6 +50,8 @@ namespace doriax{
         size_t getShapeIndex2() const;
         Vector3 getRelativeContactPointsOnA(size_t index) const;
         Vector3 getRelativeContactPointsOnB(size_t index) const;
+        size_t getNumContactPointsOnA() const;
+        size_t getNumContactPointsOnB() const;
 
 
         // ContactSettings
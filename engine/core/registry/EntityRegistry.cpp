@@ -3,53 +3,53 @@
 using namespace doriax;
 
 EntityRegistry::EntityRegistry() {
-    registerComponent<MeshComponent>();
-    registerComponent<ModelComponent>();
-    registerComponent<BoneComponent>();
-    registerComponent<SkyComponent>();
-    registerComponent<FogComponent>();
-    registerComponent<UIContainerComponent>();
-    registerComponent<UILayoutComponent>();
-    registerComponent<SpriteComponent>();
-    registerComponent<SpriteAnimationComponent>();
-    registerComponent<Transform>();
-    registerComponent<CameraComponent>();
-    registerComponent<LightComponent>();
-    registerComponent<ActionComponent>();
-    registerComponent<TimedActionComponent>();
-    registerComponent<PositionActionComponent>();
-    registerComponent<RotationActionComponent>();
-    registerComponent<ScaleActionComponent>();
-    registerComponent<ColorActionComponent>();
-    registerComponent<AlphaActionComponent>();
-    registerComponent<ParticlesComponent>();
-    registerComponent<PointsComponent>();
-    registerComponent<LinesComponent>();
-    registerComponent<TextComponent>();
-    registerComponent<UIComponent>();
-    registerComponent<ImageComponent>();
-    registerComponent<ButtonComponent>();
-    registerComponent<PanelComponent>();
-    registerComponent<ScrollbarComponent>();
-    registerComponent<TextEditComponent>();
-    registerComponent<MeshPolygonComponent>();
-    registerComponent<PolygonComponent>();
-    registerComponent<AnimationComponent>();
-    registerComponent<KeyframeTracksComponent>();
-    registerComponent<MorphTracksComponent>();
-    registerComponent<RotateTracksComponent>();
-    registerComponent<TranslateTracksComponent>();
-    registerComponent<ScaleTracksComponent>();
-    registerComponent<ScriptComponent>();
-    registerComponent<TerrainComponent>();
-    registerComponent<AudioComponent>();
-    registerComponent<TilemapComponent>();
-    registerComponent<Body2DComponent>();
-    registerComponent<Joint2DComponent>();
-    registerComponent<Body3DComponent>();
-    registerComponent<Joint3DComponent>();
-    registerComponent<InstancedMeshComponent>();
-    registerComponent<BundleComponent>();
+    registerComponent<MeshComponent>("MeshComponent");
+    registerComponent<ModelComponent>("ModelComponent");
+    registerComponent<BoneComponent>("BoneComponent");
+    registerComponent<SkyComponent>("SkyComponent");
+    registerComponent<FogComponent>("FogComponent");
+    registerComponent<UIContainerComponent>("UIContainerComponent");
+    registerComponent<UILayoutComponent>("UILayoutComponent");
+    registerComponent<SpriteComponent>("SpriteComponent");
+    registerComponent<SpriteAnimationComponent>("SpriteAnimationComponent");
+    registerComponent<Transform>("Transform");
+    registerComponent<CameraComponent>("CameraComponent");
+    registerComponent<LightComponent>("LightComponent");
+    registerComponent<ActionComponent>("ActionComponent");
+    registerComponent<TimedActionComponent>("TimedActionComponent", ComponentStorage::Unordered);
+    registerComponent<PositionActionComponent>("PositionActionComponent", ComponentStorage::Unordered);
+    registerComponent<RotationActionComponent>("RotationActionComponent", ComponentStorage::Unordered);
+    registerComponent<ScaleActionComponent>("ScaleActionComponent", ComponentStorage::Unordered);
+    registerComponent<ColorActionComponent>("ColorActionComponent", ComponentStorage::Unordered);
+    registerComponent<AlphaActionComponent>("AlphaActionComponent", ComponentStorage::Unordered);
+    registerComponent<ParticlesComponent>("ParticlesComponent");
+    registerComponent<PointsComponent>("PointsComponent");
+    registerComponent<LinesComponent>("LinesComponent");
+    registerComponent<TextComponent>("TextComponent");
+    registerComponent<UIComponent>("UIComponent");
+    registerComponent<ImageComponent>("ImageComponent");
+    registerComponent<ButtonComponent>("ButtonComponent");
+    registerComponent<PanelComponent>("PanelComponent");
+    registerComponent<ScrollbarComponent>("ScrollbarComponent");
+    registerComponent<TextEditComponent>("TextEditComponent");
+    registerComponent<MeshPolygonComponent>("MeshPolygonComponent");
+    registerComponent<PolygonComponent>("PolygonComponent");
+    registerComponent<AnimationComponent>("AnimationComponent");
+    registerComponent<KeyframeTracksComponent>("KeyframeTracksComponent", ComponentStorage::Unordered);
+    registerComponent<MorphTracksComponent>("MorphTracksComponent", ComponentStorage::Unordered);
+    registerComponent<RotateTracksComponent>("RotateTracksComponent", ComponentStorage::Unordered);
+    registerComponent<TranslateTracksComponent>("TranslateTracksComponent", ComponentStorage::Unordered);
+    registerComponent<ScaleTracksComponent>("ScaleTracksComponent", ComponentStorage::Unordered);
+    registerComponent<ScriptComponent>("ScriptComponent");
+    registerComponent<TerrainComponent>("TerrainComponent");
+    registerComponent<AudioComponent>("AudioComponent");
+    registerComponent<TilemapComponent>("TilemapComponent");
+    registerComponent<Body2DComponent>("Body2DComponent", ComponentStorage::Unordered);
+    registerComponent<Joint2DComponent>("Joint2DComponent", ComponentStorage::Unordered);
+    registerComponent<Body3DComponent>("Body3DComponent", ComponentStorage::Unordered);
+    registerComponent<Joint3DComponent>("Joint3DComponent", ComponentStorage::Unordered);
+    registerComponent<InstancedMeshComponent>("InstancedMeshComponent");
+    registerComponent<BundleComponent>("BundleComponent");
 }
 
 EntityRegistry::EntityRegistry(EntityPool defaultPool) : EntityRegistry() {
@@ -57,10 +57,15 @@ EntityRegistry::EntityRegistry(EntityPool defaultPool) : EntityRegistry() {
 }
 
 EntityRegistry::~EntityRegistry(){
+    // newest first: ordered arrays (Transform, MeshComponent) then remove from the end
     std::vector<Entity> entityList = entityManager.getEntityList();
     while(entityList.size() > 0){
-        destroyEntity(entityList.front());
-        // some entities can destroy other entities (ex: models)
+        for (auto it = entityList.rbegin(); it != entityList.rend(); ++it){
+            // some entities can destroy other entities (ex: models)
+            if (entityManager.isCreated(*it)){
+                destroyEntity(*it);
+            }
+        }
         entityList = entityManager.getEntityList();
     }
 }
@@ -205,6 +210,10 @@ bool EntityRegistry::isEntityCreated(Entity entity) const {
     return entityManager.isCreated(entity);
 }
 
+uint32_t EntityRegistry::getEntityGeneration(Entity entity) const {
+    return entityManager.getGeneration(entity);
+}
+
 bool EntityRegistry::recreateEntity(Entity entity) {
     return entityManager.recreateEntity(entity);
 }
@@ -214,6 +223,35 @@ void EntityRegistry::destroyEntity(Entity entity) {
 
     componentManager.entityDestroyed(entity);
     entityManager.destroy(entity);
+
+    for (auto& view : views){
+        view->entityDestroyed(entity);
+    }
+}
+
+void EntityRegistry::updateViews(Entity entity, Signature signature){
+    for (auto& view : views){
+        view->signatureChanged(entity, signature);
+    }
+}
+
+std::shared_ptr<EntityView> EntityRegistry::getView(Signature required, Signature excluded, ComponentId orderBy){
+    std::shared_ptr<ComponentArrayBase> orderArray = componentManager.getComponentArray(orderBy);
+
+    for (auto& view : views){
+        if (view->isQuery(required, excluded, orderArray.get())){
+            return view;
+        }
+    }
+
+    auto view = std::make_shared<EntityView>(required, excluded, orderArray);
+    for (size_t i = 0; i < orderArray->size(); i++){
+        Entity entity = orderArray->getEntity(i);
+        view->signatureChanged(entity, entityManager.getSignature(entity));
+    }
+    views.push_back(view);
+
+    return view;
 }
 
 Signature EntityRegistry::getSignature(Entity entity) const {
@@ -224,7 +262,7 @@ void EntityRegistry::setEntityName(Entity entity, const std::string& name) {
     entityManager.setName(entity, name);
 }
 
-std::string EntityRegistry::getEntityName(Entity entity) const {
+const std::string& EntityRegistry::getEntityName(Entity entity) const {
     return entityManager.getName(entity);
 }
 
@@ -333,8 +371,10 @@ EntityPool EntityRegistry::getDefaultEntityPool() const {
 
 void EntityRegistry::clear() {
     std::vector<Entity> entities = getEntityList();
-    for (Entity entity : entities) {
-        destroyEntity(entity);
+    for (auto it = entities.rbegin(); it != entities.rend(); ++it) {
+        if (entityManager.isCreated(*it)) {
+            destroyEntity(*it);
+        }
     }
     // Reset user counter to just before the user range
     entityManager.setLastUserEntity(EntityManager::lastSystemEntity());
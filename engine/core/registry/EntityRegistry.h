@@ -4,6 +4,7 @@
 #include "Entity.h"
 #include "EntityManager.h"
 #include "ComponentManager.h"
+#include "EntityView.h"
 #include "Signature.h"
 #include <memory>
 
@@ -63,10 +64,12 @@ namespace doriax {
         EntityManager entityManager;
         ComponentManager componentManager;
         EntityPool defaultPool = EntityPool::User;
+        std::vector<std::shared_ptr<EntityView>> views;
 
         void sortComponentsByTransform(Signature entitySignature);
         void moveChildAux(Entity entity, bool increase, bool stopIfFound);
         void changeTransformChildren(Entity entity);
+        void updateViews(Entity entity, Signature signature);
 
     protected:
         virtual void onComponentAdded(Entity entity, ComponentId componentId) { (void)entity; (void)componentId; }
@@ -86,6 +89,7 @@ namespace doriax {
         bool recreateEntity(Entity entity); // for internal editor use only
 
         bool isEntityCreated(Entity entity) const;
+        uint32_t getEntityGeneration(Entity entity) const; // to detect stale entity handles
 
         void destroyEntity(Entity entity);
 
@@ -101,7 +105,7 @@ namespace doriax {
         Signature getSignature(Entity entity) const;
 
         void setEntityName(Entity entity, const std::string& name);
-        std::string getEntityName(Entity entity) const;
+        const std::string& getEntityName(Entity entity) const;
 
         Entity findOldestParent(Entity entity);
         bool isParentOf(Entity parent, Entity child);
@@ -118,8 +122,8 @@ namespace doriax {
         // Component methods
 
         template<typename T>
-        void registerComponent(){
-            componentManager.registerComponent<T>();
+        void registerComponent(const std::string& name, ComponentStorage storage = ComponentStorage::Ordered){
+            componentManager.registerComponent<T>(name, storage);
         }
 
         template<typename T>
@@ -133,6 +137,7 @@ namespace doriax {
             auto signature = entityManager.getSignature(entity);
             signature.set(componentManager.getComponentId<T>(), true);
             entityManager.setSignature(entity, signature);
+            updateViews(entity, signature);
 
             onComponentAdded(entity, componentManager.getComponentId<T>());
         }
@@ -148,7 +153,8 @@ namespace doriax {
             componentManager.removeComponent<T>(entity);
             auto signature = entityManager.getSignature(entity);
             signature.set(componentManager.getComponentId<T>(), false);
-            entityManager.setSignature(entity, signature); 
+            entityManager.setSignature(entity, signature);
+            updateViews(entity, signature);
         }
 
         template<typename T>
@@ -176,10 +182,33 @@ namespace doriax {
             return componentManager.getComponentId<T>();
         }
 
+        // by name given at registration, NULL_COMPONENT_ID if not registered
+        ComponentId getComponentId(const std::string& name) const{
+            return componentManager.getComponentId(name);
+        }
+
         template<typename T>
         std::shared_ptr<ComponentArray<T>> getComponentArray() const{
             return componentManager.getComponentArray<T>();
         }
+
+        // View methods
+
+        template<typename... T>
+        Signature getComponentSignature() const{
+            Signature signature;
+            (signature.set(getComponentId<T>()), ...);
+            return signature;
+        }
+
+        // Entities having all required components and none of excluded, in orderBy array order
+        std::shared_ptr<EntityView> getView(Signature required, Signature excluded, ComponentId orderBy);
+
+        // Entities having all listed components, in order of the first one
+        template<typename T, typename... Others>
+        std::shared_ptr<EntityView> getView(Signature excluded = Signature()){
+            return getView(getComponentSignature<T, Others...>(), excluded, getComponentId<T>());
+        }
     };
 
 } // namespace doriax
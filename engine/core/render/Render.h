@@ -6,6 +6,7 @@
 #define Render_h
 
 #include "Export.h"
+#include <stdint.h>
 
 
 namespace doriax{
@@ -196,6 +197,17 @@ namespace doriax{
         PIP_DEPTH   = 1 << 2
     };
 
+    // State changes of last frame, elided are redundant ones skipped by backend
+    struct DrawStateStats{
+        uint32_t draws = 0;
+        uint32_t pipelinesApplied = 0;
+        uint32_t pipelinesElided = 0;
+        uint32_t bindingsApplied = 0;
+        uint32_t bindingsElided = 0;
+        uint32_t uniformsApplied = 0;
+        uint32_t uniformsElided = 0;
+    };
+
     //-------Start shader definition--------
     enum class ShaderLang{
         GLSL,
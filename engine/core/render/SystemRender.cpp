@@ -43,4 +43,8 @@ void SystemRender::addQueueCommand(void (*custom_cb)(void* custom_data), void* c
     }else{
         custom_cb(custom_data);
     }
-}
\ No newline at end of file
+}
+
+DrawStateStats SystemRender::getDrawStateStats(){
+    return SokolSystem::getDrawStateStats();
+}
@@ -6,6 +6,7 @@
 #define SystemRender_h
 
 #include "Export.h"
+#include "Render.h"
 #include <stdint.h>
 
 namespace doriax{
@@ -19,6 +20,9 @@ namespace doriax{
 
         static void scheduleCleanup(void (*cleanupFunc)(void* cleanupData), void* cleanupData, int32_t numFramesToDefer = 0);
         static void addQueueCommand(void (*custom_cb)(void* custom_data), void* custom_data);
+
+        // redundant state changes skipped by backend on last frame
+        static DrawStateStats getDrawStateStats();
     };
 }
 
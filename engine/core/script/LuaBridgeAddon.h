@@ -83,6 +83,7 @@ namespace luabridge
     template<> struct Stack<Shape2DType> : EnumWrapper<Shape2DType>{};
     template<> struct Stack<Shape3DType> : EnumWrapper<Shape3DType>{};
     template<> struct Stack<BodyType> : EnumWrapper<BodyType>{};
+    template<> struct Stack<PhysicsInterpolation> : EnumWrapper<PhysicsInterpolation>{};
     template<> struct Stack<Joint2DType> : EnumWrapper<Joint2DType>{};
 
     template <>
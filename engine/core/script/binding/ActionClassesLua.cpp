@@ -221,6 +221,8 @@ void LuaBinding::registerActionClasses(lua_State *L){
         .addConstructor <void(Scene*), void(Scene*, Entity)> ()
         .addProperty("loop", &Animation::isLoop, &Animation::setLoop)
         .addProperty("ownedActions", &Animation::isOwnedActions, &Animation::setOwnedActions)
+        .addProperty("compactClip", &Animation::isCompactClip, &Animation::setCompactClip)
+        .addProperty("quantizedClip", &Animation::isQuantizedClip, &Animation::setQuantizedClip)
         .addProperty("name", &Animation::getName, &Animation::setName)
         .addFunction("addActionFrame", 
             luabridge::overload<float, float, Entity, Entity>(&Animation::addActionFrame),
@@ -527,6 +527,7 @@ void LuaBinding::registerCoreClasses(lua_State *L){
         .addFunction("setEntityName", &EntityRegistry::setEntityName)
         .addFunction("getEntityName", &EntityRegistry::getEntityName)
         .addFunction("getSignature", &EntityRegistry::getSignature)
+        .addFunction("getComponentId", (ComponentId(EntityRegistry::*)(const std::string&)const)&EntityRegistry::getComponentId)
         .addFunction("addEntityChild", &EntityRegistry::addEntityChild)
         .addFunction("moveChildToIndex", &EntityRegistry::moveChildToIndex)
         .addFunction("moveChildToTop", &EntityRegistry::moveChildToTop)
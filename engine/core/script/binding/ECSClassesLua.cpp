@@ -135,6 +135,8 @@ void LuaBinding::registerECSClasses(lua_State *L){
         .addFunction("createTorus", &MeshSystem::createTorus)
         .addFunction("loadGLTF", &MeshSystem::loadGLTF)
         .addFunction("loadOBJ", &MeshSystem::loadOBJ)
+        .addFunction("loadCookedModel", &MeshSystem::loadCookedModel)
+        .addFunction("cookModel", &MeshSystem::cookModel)
         .addFunction("createInstancedMesh", &MeshSystem::createInstancedMesh)
         .addFunction("removeInstancedMesh", &MeshSystem::removeInstancedMesh)
         .endClass();
@@ -148,6 +150,14 @@ void LuaBinding::registerECSClasses(lua_State *L){
             luabridge::overload<float, float, float>(&PhysicsSystem::setGravity))
         .addProperty("pointsToMeterScale2D", &PhysicsSystem::getPointsToMeterScale2D,  &PhysicsSystem::setPointsToMeterScale2D)
         .addProperty("lock3DBodies", &PhysicsSystem::isLock3DBodies, &PhysicsSystem::setLock3DBodies)
+        .addProperty("fixedTimeStep", &PhysicsSystem::getFixedTimeStep, &PhysicsSystem::setFixedTimeStep)
+        .addProperty("interpolation", &PhysicsSystem::getInterpolation, &PhysicsSystem::setInterpolation)
+        .addFunction("getInterpolationAlpha", &PhysicsSystem::getInterpolationAlpha)
+        .addProperty("workerCount2D", &PhysicsSystem::getWorkerCount2D, &PhysicsSystem::setWorkerCount2D)
+        .addProperty("maxBodies3D", &PhysicsSystem::getMaxBodies3D, &PhysicsSystem::setMaxBodies3D)
+        .addProperty("maxBodyPairs3D", &PhysicsSystem::getMaxBodyPairs3D, &PhysicsSystem::setMaxBodyPairs3D)
+        .addProperty("maxContactConstraints3D", &PhysicsSystem::getMaxContactConstraints3D, &PhysicsSystem::setMaxContactConstraints3D)
+        .addProperty("tempAllocatorSize3D", &PhysicsSystem::getTempAllocatorSize3D, &PhysicsSystem::setTempAllocatorSize3D)
         .addProperty("beginContact2D", [] (PhysicsSystem* self, lua_State* L) { return &self->beginContact2D; }, [] (PhysicsSystem* self, lua_State* L) { self->beginContact2D = L; })
         .addProperty("endContact2D", [] (PhysicsSystem* self, lua_State* L) { return &self->endContact2D; }, [] (PhysicsSystem* self, lua_State* L) { self->endContact2D = L; })
         .addProperty("beginSensorContact2D", [] (PhysicsSystem* self, lua_State* L) { return &self->beginSensorContact2D; }, [] (PhysicsSystem* self, lua_State* L) { self->beginSensorContact2D = L; })
@@ -272,6 +282,8 @@ void LuaBinding::registerECSClasses(lua_State *L){
         .addProperty("loop", &AnimationComponent::loop)
         .addProperty("m", &AnimationComponent::name)
         .addProperty("duration", &AnimationComponent::duration)
+        .addProperty("compactClip", &AnimationComponent::compactClip)
+        .addProperty("quantizedClip", &AnimationComponent::quantizedClip)
         .endClass();
 
     luabridge::getGlobalNamespace(L)
@@ -528,7 +540,7 @@ void LuaBinding::registerECSClasses(lua_State *L){
     luabridge::getGlobalNamespace(L)
         .beginClass<ParticlesComponent>("ParticlesComponent")
         .addProperty("newParticlesCount", &ParticlesComponent::newParticlesCount)
-        .addProperty("lastUsedParticle", &ParticlesComponent::lastUsedParticle)
+        .addProperty("numParticles", &ParticlesComponent::numParticles)
         .addProperty("emitter", &ParticlesComponent::emitter)
         .addProperty("loop", &ParticlesComponent::loop)
         .addProperty("rate", &ParticlesComponent::rate)
@@ -621,6 +633,8 @@ void LuaBinding::registerECSClasses(lua_State *L){
         .addProperty("numTiles", &TilemapComponent::numTiles)
         //.addProperty("tilesRect", &TilemapComponent::tilesRect)
         //.addProperty("tiles", &TilemapComponent::tiles)
+        .addProperty("chunkSize", &TilemapComponent::chunkSize)
+        .addProperty("cullChunks", &TilemapComponent::cullChunks)
         .addProperty("needUpdateTilemap", &TilemapComponent::needUpdateTilemap)
         .endClass();
 
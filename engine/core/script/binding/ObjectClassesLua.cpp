@@ -101,6 +101,13 @@ void LuaBinding::registerObjectClasses(lua_State *L){
         .addVariable("DYNAMIC", BodyType::DYNAMIC)
         .endNamespace();
 
+    luabridge::getGlobalNamespace(L)
+        .beginNamespace("PhysicsInterpolation")
+        .addVariable("NONE", PhysicsInterpolation::NONE)
+        .addVariable("INTERPOLATE", PhysicsInterpolation::INTERPOLATE)
+        .addVariable("EXTRAPOLATE", PhysicsInterpolation::EXTRAPOLATE)
+        .endNamespace();
+
     luabridge::getGlobalNamespace(L)
         .beginNamespace("Joint2DType")
         .addVariable("DISTANCE", Joint2DType::DISTANCE)
@@ -376,6 +383,8 @@ void LuaBinding::registerObjectClasses(lua_State *L){
         .addFunction("removeInstance", &Mesh::removeInstance)
         .addFunction("isInstanceVisible", &Mesh::isInstanceVisible)
         .addFunction("setInstanceVisible", &Mesh::setInstanceVisible)
+        .addProperty("instanceCulling", &Mesh::isInstanceCulling, &Mesh::setInstanceCulling)
+        .addProperty("instanceChunkSize", &Mesh::getInstanceChunkSize, &Mesh::setInstanceChunkSize)
         .addFunction("updateInstances", &Mesh::updateInstances)
         .addFunction("getNumInstances", &Mesh::getNumInstances)
         .addFunction("clearInstances", &Mesh::clearInstances)
@@ -464,6 +473,8 @@ void LuaBinding::registerObjectClasses(lua_State *L){
             luabridge::overload<int>(&Tilemap::getTile),
             luabridge::overload<const std::string&>(&Tilemap::getTile))
         .addProperty("reserveTiles", &Tilemap::getReserveTiles, &Tilemap::setReserveTiles)
+        .addProperty("chunkCulling", &Tilemap::isChunkCulling, &Tilemap::setChunkCulling)
+        .addProperty("chunkSize", &Tilemap::getChunkSize, &Tilemap::setChunkSize)
         .addFunction("getWidth", &Tilemap::getWidth)
         .addFunction("getHeight", &Tilemap::getHeight)
         .addFunction("clearAll", &Tilemap::clearAll)
@@ -474,9 +485,12 @@ void LuaBinding::registerObjectClasses(lua_State *L){
         .addConstructor <void (*) (Scene*), void (*) (Scene*, Entity)> ()
         .addFunction("loadOBJ", &Model::loadOBJ)
         .addFunction("loadGLTF", &Model::loadGLTF)
+        .addFunction("loadCookedModel", &Model::loadCookedModel)
+        .addFunction("cookModel", &Model::cookModel)
         .addFunction("loadModel", &Model::loadModel)
         .addFunction("getAnimation", &Model::getAnimation)
         .addFunction("findAnimation", &Model::findAnimation)
+        .addProperty("compactSkeleton", &Model::isCompactSkeleton, &Model::setCompactSkeleton)
         .addFunction("getBone", 
             luabridge::overload<int>(&Model::getBone),
             luabridge::overload<const std::string&>(&Model::getBone))
@@ -1115,6 +1129,8 @@ void LuaBinding::registerObjectClasses(lua_State *L){
         .addFunction("getShapeIndex2", &Contact3D::getShapeIndex2)
         .addFunction("getRelativeContactPointsOnA", &Contact3D::getRelativeContactPointsOnA)
         .addFunction("getRelativeContactPointsOnB", &Contact3D::getRelativeContactPointsOnB)
+        .addFunction("getNumContactPointsOnA", &Contact3D::getNumContactPointsOnA)
+        .addFunction("getNumContactPointsOnB", &Contact3D::getNumContactPointsOnB)
         .addProperty("combinedFriction", &Contact3D::getCombinedFriction, &Contact3D::setCombinedFriction)
         .addProperty("combinedRestitution", &Contact3D::getCombinedRestitution, &Contact3D::setCombinedRestitution)
         .addProperty("sensor", &Contact3D::isSensor, &Contact3D::setIsSensor)
@@ -8,7 +8,13 @@
 #include "util/Color.h"
 #include "util/Angle.h"
 #include "subsystem/MeshSystem.h"
+#include "subsystem/RenderSystem.h"
+#include "math/MathSIMD.h"
+#ifndef NO_THREAD_SUPPORT
+#include "thread/ThreadPoolManager.h"
+#endif
 
+#include <algorithm>
 #include <functional>
 #include <unordered_set>
 
@@ -23,6 +29,16 @@ void ActionSystem::actionStart(Entity entity){
     ActionComponent& action = scene->getComponent<ActionComponent>(entity);
     Signature signature = scene->getSignature(entity);
 
+    if (action.state == ActionState::Stopped && signature.test(scene->getComponentId<AnimationComponent>())){
+        AnimationComponent& animcomp = scene->getComponent<AnimationComponent>(entity);
+
+        if (animcomp.compactClip){
+            buildAnimationClip(animcomp);
+        }else{
+            animcomp.clip = AnimationClip();
+        }
+    }
+
     actionComponentStart(action);
 
     if (action.target != NULL_ENTITY){
@@ -97,6 +113,12 @@ void ActionSystem::actionStop(Entity entity){
 
             }
         }
+
+        if (signature.test(scene->getComponentId<ParticlesComponent>())){
+            ParticlesComponent& particles = scene->getComponent<ParticlesComponent>(entity);
+
+            particleActionStop(action.target, particles);
+        }
     }
 }
 
@@ -136,7 +158,11 @@ void ActionSystem::actionDestroy(ActionComponent& action){
 void ActionSystem::animationUpdate(double dt, Entity entity, ActionComponent& action, AnimationComponent& animcomp){
     int totalActionsPassed = 0;
 
-    for (int i = 0; i < animcomp.actions.size(); i++){
+    if (!animcomp.clip.tracks.empty()){
+        totalActionsPassed = animationClipUpdate(action, animcomp);
+    }
+
+    for (int i = 0; i < animcomp.actions.size() && animcomp.clip.tracks.empty(); i++){
 
         float timeDiff = action.timecount - animcomp.actions[i].startTime;
 
@@ -172,6 +198,287 @@ void ActionSystem::animationUpdate(double dt, Entity entity, ActionComponent& ac
     }
 }
 
+// First key with time >= currentTime (or last key), checking the previous index and the next one before searching
+static int findKeyframeIndex(const float* times, int size, float currentTime, int cursor){
+    if (cursor < 0 || cursor >= size){
+        cursor = 0;
+    }
+
+    for (int i = cursor; i < size && i <= cursor + 1; i++){
+        if ((i == size - 1 || times[i] >= currentTime) && (i == 0 || times[i-1] < currentTime)){
+            return i;
+        }
+    }
+
+    int index = (int)(std::lower_bound(times, times + size, currentTime) - times);
+
+    return std::min(index, size - 1);
+}
+
+static float getKeyframeInterpolation(const float* times, int index, float currentTime){
+    float interpolation = 0;
+
+    float previousTime = 0;
+    float nextTime = times[index];
+
+    if (index > 0){
+        previousTime = times[index-1];
+    }
+
+    if (nextTime > previousTime){
+        interpolation = (currentTime - previousTime) / (nextTime - previousTime);
+    }
+
+    if (interpolation > 1){
+        interpolation = 1;
+    }
+
+    return interpolation;
+}
+
+bool ActionSystem::buildAnimationClip(AnimationComponent& animcomp){
+    AnimationClip& clip = animcomp.clip;
+    clip = AnimationClip();
+
+    std::vector<float> trackValues;
+
+    for (int i = 0; i < animcomp.actions.size(); i++){
+        Entity trackEntity = animcomp.actions[i].action;
+        if (trackEntity == NULL_ENTITY || !scene->isEntityCreated(trackEntity)){
+            clip = AnimationClip();
+            return false;
+        }
+
+        Signature signature = scene->getSignature(trackEntity);
+        if (!signature.test(scene->getComponentId<ActionComponent>()) || !signature.test(scene->getComponentId<KeyframeTracksComponent>())){
+            clip = AnimationClip();
+            return false;
+        }
+
+        ActionComponent& trackaction = scene->getComponent<ActionComponent>(trackEntity);
+        KeyframeTracksComponent& keyframe = scene->getComponent<KeyframeTracksComponent>(trackEntity);
+
+        AnimationClipTrack track;
+        track.target = trackaction.target;
+        track.poseBone = keyframe.poseBone;
+        track.startTime = animcomp.actions[i].startTime;
+        track.duration = animcomp.actions[i].duration;
+        track.speed = trackaction.speed;
+        track.keysSize = (uint32_t)keyframe.times.size();
+
+        trackValues.clear();
+
+        if (signature.test(scene->getComponentId<TranslateTracksComponent>())){
+            TranslateTracksComponent& translatetracks = scene->getComponent<TranslateTracksComponent>(trackEntity);
+            track.type = AnimationClipTrackType::Translate;
+            track.components = 3;
+            for (const Vector3& value : translatetracks.values){
+                trackValues.insert(trackValues.end(), {value.x, value.y, value.z});
+            }
+        }else if (signature.test(scene->getComponentId<RotateTracksComponent>())){
+            RotateTracksComponent& rotatetracks = scene->getComponent<RotateTracksComponent>(trackEntity);
+            track.type = AnimationClipTrackType::Rotate;
+            track.components = 4;
+            for (const Quaternion& value : rotatetracks.values){
+                trackValues.insert(trackValues.end(), {value.w, value.x, value.y, value.z});
+            }
+        }else if (signature.test(scene->getComponentId<ScaleTracksComponent>())){
+            ScaleTracksComponent& scaletracks = scene->getComponent<ScaleTracksComponent>(trackEntity);
+            track.type = AnimationClipTrackType::Scale;
+            track.components = 3;
+            for (const Vector3& value : scaletracks.values){
+                trackValues.insert(trackValues.end(), {value.x, value.y, value.z});
+            }
+        }else if (signature.test(scene->getComponentId<MorphTracksComponent>())){
+            MorphTracksComponent& morphtracks = scene->getComponent<MorphTracksComponent>(trackEntity);
+            track.type = AnimationClipTrackType::Morph;
+            track.components = morphtracks.values.empty() ? 0 : (uint32_t)morphtracks.values[0].size();
+            for (const std::vector<float>& value : morphtracks.values){
+                if (value.size() != track.components){
+                    clip = AnimationClip();
+                    return false;
+                }
+                trackValues.insert(trackValues.end(), value.begin(), value.end());
+            }
+        }else{
+            clip = AnimationClip();
+            return false;
+        }
+
+        if (track.keysSize == 0 || track.components == 0 || trackValues.size() != (size_t)track.keysSize * track.components){
+            clip = AnimationClip();
+            return false;
+        }
+
+        // glTF samplers of the same channel usually share the input accessor
+        bool sharedTimes = false;
+        for (const AnimationClipTrack& other : clip.tracks){
+            if (other.keysSize == track.keysSize &&
+                std::equal(keyframe.times.begin(), keyframe.times.end(), clip.times.begin() + other.timesOffset)){
+                track.timesOffset = other.timesOffset;
+                sharedTimes = true;
+                break;
+            }
+        }
+        if (!sharedTimes){
+            track.timesOffset = (uint32_t)clip.times.size();
+            clip.times.insert(clip.times.end(), keyframe.times.begin(), keyframe.times.end());
+        }
+
+        if (animcomp.quantizedClip){
+            track.valuesOffset = (uint32_t)clip.quantizedValues.size();
+            track.rangesOffset = (uint32_t)clip.ranges.size();
+
+            for (uint32_t c = 0; c < track.components; c++){
+                float minValue = trackValues[c];
+                float maxValue = trackValues[c];
+                for (uint32_t k = 1; k < track.keysSize; k++){
+                    minValue = std::min(minValue, trackValues[k * track.components + c]);
+                    maxValue = std::max(maxValue, trackValues[k * track.components + c]);
+                }
+                clip.ranges.push_back(minValue);
+                clip.ranges.push_back((maxValue - minValue) / 65535.0f);
+            }
+
+            for (uint32_t k = 0; k < track.keysSize; k++){
+                for (uint32_t c = 0; c < track.components; c++){
+                    float minValue = clip.ranges[track.rangesOffset + c * 2];
+                    float step = clip.ranges[track.rangesOffset + c * 2 + 1];
+                    float quantized = (step > 0) ? (trackValues[k * track.components + c] - minValue) / step + 0.5f : 0;
+                    clip.quantizedValues.push_back((uint16_t)std::min(quantized, 65535.0f));
+                }
+            }
+        }else{
+            track.valuesOffset = (uint32_t)clip.values.size();
+            clip.values.insert(clip.values.end(), trackValues.begin(), trackValues.end());
+        }
+
+        clip.tracks.push_back(track);
+    }
+
+    return !clip.tracks.empty();
+}
+
+static void getClipValues(const AnimationClip& clip, const AnimationClipTrack& track, uint32_t key, float* out){
+    uint32_t offset = track.valuesOffset + key * track.components;
+
+    if (!clip.quantizedValues.empty()){
+        const float* range = &clip.ranges[track.rangesOffset];
+        for (uint32_t c = 0; c < track.components; c++){
+            out[c] = range[c * 2] + clip.quantizedValues[offset + c] * range[c * 2 + 1];
+        }
+    }else{
+        for (uint32_t c = 0; c < track.components; c++){
+            out[c] = clip.values[offset + c];
+        }
+    }
+}
+
+int ActionSystem::animationClipUpdate(ActionComponent& action, AnimationComponent& animcomp){
+    AnimationClip& clip = animcomp.clip;
+    int totalTracksPassed = 0;
+
+    std::vector<float>& previousValues = clipPreviousValues;
+    std::vector<float>& nextValues = clipNextValues;
+
+    Entity poseModelEntity = NULL_ENTITY;
+    ModelComponent* poseModel = nullptr;
+
+    for (AnimationClipTrack& track : clip.tracks){
+        float timeDiff = action.timecount - track.startTime;
+
+        if (timeDiff < 0){
+            continue;
+        }
+
+        if (timeDiff > (track.duration / track.speed)){
+            totalTracksPassed++;
+        }
+
+        if (track.target == NULL_ENTITY){
+            continue;
+        }
+
+        const float* times = &clip.times[track.timesOffset];
+        float currentTime = timeDiff * track.speed;
+
+        int index = findKeyframeIndex(times, (int)track.keysSize, currentTime, (int)track.cursor);
+        float interpolation = getKeyframeInterpolation(times, index, currentTime);
+        track.cursor = (uint32_t)index;
+
+        if (currentTime >= times[track.keysSize - 1]){
+            interpolation = 1;
+        }
+
+        previousValues.resize(track.components);
+        nextValues.resize(track.components);
+
+        getClipValues(clip, track, (index > 0) ? index - 1 : 0, previousValues.data());
+        getClipValues(clip, track, index, nextValues.data());
+
+        if (track.type == AnimationClipTrackType::Morph){
+            MeshComponent* mesh = scene->findComponent<MeshComponent>(track.target);
+            if (mesh){
+                for (uint32_t c = 0; c < track.components && c < MAX_MORPHTARGETS; c++){
+                    mesh->morphWeights[c] = previousValues[c] + interpolation * (nextValues[c] - previousValues[c]);
+                }
+            }
+            continue;
+        }
+
+        Vector3* position;
+        Quaternion* rotation;
+        Vector3* scale;
+
+        if (track.poseBone >= 0){
+            // tracks of the same model are together, model is searched once for all its bones
+            if (track.target != poseModelEntity){
+                poseModel = scene->findComponent<ModelComponent>(track.target);
+                poseModelEntity = track.target;
+            }
+            if (!poseModel || track.poseBone >= (int)poseModel->pose.size()){
+                continue;
+            }
+
+            SkeletonBone& bone = poseModel->pose[track.poseBone];
+            position = &bone.position;
+            rotation = &bone.rotation;
+            scale = &bone.scale;
+            poseModel->needUpdatePose = true;
+        }else{
+            Transform* transform = scene->findComponent<Transform>(track.target);
+            if (!transform){
+                continue;
+            }
+
+            position = &transform->position;
+            rotation = &transform->rotation;
+            scale = &transform->scale;
+            transform->needUpdate = true;
+        }
+
+        if (track.type == AnimationClipTrackType::Rotate){
+            Quaternion previousRotation(previousValues[0], previousValues[1], previousValues[2], previousValues[3]);
+            Quaternion nextRotation(nextValues[0], nextValues[1], nextValues[2], nextValues[3]);
+            if (!clip.quantizedValues.empty()){
+                previousRotation.normalize();
+                nextRotation.normalize();
+            }
+            *rotation = Quaternion::slerp(interpolation, previousRotation, nextRotation);
+        }else{
+            Vector3 previousValue(previousValues[0], previousValues[1], previousValues[2]);
+            Vector3 value = previousValue + interpolation * (Vector3(nextValues[0], nextValues[1], nextValues[2]) - previousValue);
+            if (track.type == AnimationClipTrackType::Translate){
+                *position = value;
+            }else{
+                *scale = value;
+            }
+        }
+    }
+
+    return totalTracksPassed;
+}
+
 void ActionSystem::animationDestroy(AnimationComponent& animcomp){
     if (animcomp.ownedActions){
         for (int i = 0; i < animcomp.actions.size(); i++){
@@ -333,25 +640,48 @@ void ActionSystem::alphaActionUIUpdate(double dt, ActionComponent& action, Timed
     ui.color.w = alphaaction.startAlpha + alpha;
 }
 
-int ActionSystem::findUnusedParticle(ParticlesComponent& particles){
-
-    for (int i=particles.lastUsedParticle; i<particles.particles.size(); i++){
-        if (particles.particles[i].life <= particles.particles[i].time){
-            particles.lastUsedParticle = i;
-            return i;
-        }
-    }
-
-    if (particles.loop){
-        for (int i=0; i<particles.lastUsedParticle; i++){
-            if (particles.particles[i].life <= particles.particles[i].time){
-                particles.lastUsedParticle = i;
-                return i;
-            }
-        }
+void ActionSystem::resizeParticles(ParticlesComponent& particles, size_t size){
+    particles.life.resize(size);
+    particles.time.resize(size);
+    particles.positionX.resize(size);
+    particles.positionY.resize(size);
+    particles.positionZ.resize(size);
+    particles.velocityX.resize(size);
+    particles.velocityY.resize(size);
+    particles.velocityZ.resize(size);
+    particles.accelerationX.resize(size);
+    particles.accelerationY.resize(size);
+    particles.accelerationZ.resize(size);
+    particles.color.resize(size);
+    particles.size.resize(size);
+    particles.rotation.resize(size);
+    particles.angle.resize(size);
+    particles.scale.resize(size);
+    particles.textureRect.resize(size);
+
+    if (particles.numParticles > size){
+        particles.numParticles = size;
     }
+}
 
-    return -1;
+void ActionSystem::moveParticle(ParticlesComponent& particles, size_t from, size_t to){
+    particles.life[to] = particles.life[from];
+    particles.time[to] = particles.time[from];
+    particles.positionX[to] = particles.positionX[from];
+    particles.positionY[to] = particles.positionY[from];
+    particles.positionZ[to] = particles.positionZ[from];
+    particles.velocityX[to] = particles.velocityX[from];
+    particles.velocityY[to] = particles.velocityY[from];
+    particles.velocityZ[to] = particles.velocityZ[from];
+    particles.accelerationX[to] = particles.accelerationX[from];
+    particles.accelerationY[to] = particles.accelerationY[from];
+    particles.accelerationZ[to] = particles.accelerationZ[from];
+    particles.color[to] = particles.color[from];
+    particles.size[to] = particles.size[from];
+    particles.rotation[to] = particles.rotation[from];
+    particles.angle[to] = particles.angle[from];
+    particles.scale[to] = particles.scale[from];
+    particles.textureRect[to] = particles.textureRect[from];
 }
 
 float ActionSystem::getFloatInitializerValue(float& min, float& max){
@@ -409,100 +739,72 @@ Rect ActionSystem::getSpriteInitializerValue(std::vector<int>& frames, PointsCom
     return Rect(0,0,1,1);
 }
 
-void ActionSystem::applyParticleInitializers(size_t idx, ParticlesComponent& particles, InstancedMeshComponent& instmesh, SpriteComponent* sprite){
+void ActionSystem::applyParticleInitializers(size_t idx, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points){
     ParticleLifeInitializer& lifeInit = particles.lifeInitializer;
-    particles.particles[idx].life = getFloatInitializerValue(lifeInit.minLife, lifeInit.maxLife);
+    particles.life[idx] = getFloatInitializerValue(lifeInit.minLife, lifeInit.maxLife);
+    particles.time[idx] = 0;
 
     ParticlePositionInitializer& posInit = particles.positionInitializer;
-    instmesh.instances[idx].position = getVector3InitializerValue(posInit.minPosition, posInit.maxPosition, false);
+    Vector3 position = getVector3InitializerValue(posInit.minPosition, posInit.maxPosition, false);
+    particles.positionX[idx] = position.x;
+    particles.positionY[idx] = position.y;
+    particles.positionZ[idx] = position.z;
 
     ParticleVelocityInitializer& velInit = particles.velocityInitializer;
-    particles.particles[idx].velocity = getVector3InitializerValue(velInit.minVelocity, velInit.maxVelocity, false);
+    Vector3 velocity = getVector3InitializerValue(velInit.minVelocity, velInit.maxVelocity, false);
+    particles.velocityX[idx] = velocity.x;
+    particles.velocityY[idx] = velocity.y;
+    particles.velocityZ[idx] = velocity.z;
 
     ParticleAccelerationInitializer& accInit = particles.accelerationInitializer;
-    particles.particles[idx].acceleration = getVector3InitializerValue(accInit.minAcceleration, accInit.maxAcceleration, false);
+    Vector3 acceleration = getVector3InitializerValue(accInit.minAcceleration, accInit.maxAcceleration, false);
+    particles.accelerationX[idx] = acceleration.x;
+    particles.accelerationY[idx] = acceleration.y;
+    particles.accelerationZ[idx] = acceleration.z;
 
     ParticleColorInitializer& colInit = particles.colorInitializer;
-    instmesh.instances[idx].color = getVector3InitializerValue(colInit.minColor, colInit.maxColor, false);
+    Vector3 color = getVector3InitializerValue(colInit.minColor, colInit.maxColor, false);
     if (colInit.useSRGB){
-        instmesh.instances[idx].color = Color::sRGBToLinear(instmesh.instances[idx].color);
+        color = Color::sRGBToLinear(color);
     }
+    particles.color[idx] = color;
 
     ParticleAlphaInitializer& alpInit = particles.alphaInitializer;
-    instmesh.instances[idx].color.w = getFloatInitializerValue(alpInit.minAlpha, alpInit.maxAlpha);
-
-    // size initializer is not applicable to instanced meshes
-
-    if (sprite){
-        ParticleSpriteInitializer& spriteInit = particles.spriteInitializer;
-        instmesh.instances[idx].textureRect = getSpriteInitializerValue(spriteInit.frames, *sprite);
-    }
+    particles.color[idx].w = getFloatInitializerValue(alpInit.minAlpha, alpInit.maxAlpha);
 
     ParticleRotationInitializer& rotInit = particles.rotationInitializer;
-    instmesh.instances[idx].rotation = getQuaternionInitializerValue(rotInit.minRotation, rotInit.maxRotation, rotInit.shortestPath);
-
-    ParticleScaleInitializer& scaInit = particles.scaleInitializer;
-    instmesh.instances[idx].scale = getVector3InitializerValue(scaInit.minScale, scaInit.maxScale, scaInit.linearSort);
-
-}
+    Quaternion rotation = getQuaternionInitializerValue(rotInit.minRotation, rotInit.maxRotation, rotInit.shortestPath);
 
-void ActionSystem::applyParticleInitializers(size_t idx, ParticlesComponent& particles, PointsComponent& points){
-    ParticleLifeInitializer& lifeInit = particles.lifeInitializer;
-    particles.particles[idx].life = getFloatInitializerValue(lifeInit.minLife, lifeInit.maxLife);
-
-    ParticlePositionInitializer& posInit = particles.positionInitializer;
-    points.points[idx].position = getVector3InitializerValue(posInit.minPosition, posInit.maxPosition, false);
-
-    ParticleVelocityInitializer& velInit = particles.velocityInitializer;
-    particles.particles[idx].velocity = getVector3InitializerValue(velInit.minVelocity, velInit.maxVelocity, false);
+    if (points){
+        ParticleSizeInitializer& sizeInit = particles.sizeInitializer;
+        particles.size[idx] = getFloatInitializerValue(sizeInit.minSize, sizeInit.maxSize);
 
-    ParticleAccelerationInitializer& accInit = particles.accelerationInitializer;
-    particles.particles[idx].acceleration = getVector3InitializerValue(accInit.minAcceleration, accInit.maxAcceleration, false);
-
-    ParticleColorInitializer& colInit = particles.colorInitializer;
-    points.points[idx].color = getVector3InitializerValue(colInit.minColor, colInit.maxColor, false);
-    if (colInit.useSRGB){
-        points.points[idx].color = Color::sRGBToLinear(points.points[idx].color);
-    }
-
-    ParticleAlphaInitializer& alpInit = particles.alphaInitializer;
-    points.points[idx].color.w = getFloatInitializerValue(alpInit.minAlpha, alpInit.maxAlpha);
+        ParticleSpriteInitializer& spriteInit = particles.spriteInitializer;
+        particles.textureRect[idx] = getSpriteInitializerValue(spriteInit.frames, *points);
 
-    ParticleSizeInitializer& sizeInit = particles.sizeInitializer;
-    points.points[idx].size = getFloatInitializerValue(sizeInit.minSize, sizeInit.maxSize);
+        particles.angle[idx] = Angle::defaultToRad(rotation.getRoll());
 
-    ParticleSpriteInitializer& spriteInit = particles.spriteInitializer;
-    points.points[idx].textureRect = getSpriteInitializerValue(spriteInit.frames, points);
+        // scale initializer is not applicable to points
+    }else{
+        // size initializer is not applicable to instanced meshes
 
-    ParticleRotationInitializer& rotInit = particles.rotationInitializer;
-    points.points[idx].rotation = Angle::defaultToRad(getQuaternionInitializerValue(rotInit.minRotation, rotInit.maxRotation, rotInit.shortestPath).getRoll());
+        if (sprite){
+            ParticleSpriteInitializer& spriteInit = particles.spriteInitializer;
+            particles.textureRect[idx] = getSpriteInitializerValue(spriteInit.frames, *sprite);
+        }else{
+            particles.textureRect[idx] = Rect(0,0,1,1);
+        }
 
-    // scale initializer is not applicable to points
-}
+        particles.rotation[idx] = rotation;
 
-float ActionSystem::getTimeFromParticleTime(float& time, float& fromTime, float& toTime){
-    if ((fromTime != toTime) && (time >= fromTime) && (time <= toTime)) {
-        return (time - fromTime) / (toTime - fromTime);
+        ParticleScaleInitializer& scaInit = particles.scaleInitializer;
+        particles.scale[idx] = getVector3InitializerValue(scaInit.minScale, scaInit.maxScale, scaInit.linearSort);
     }
-
-    return -1;
-}
-
-float ActionSystem::getFloatModifierValue(float& value, float& fromValue, float& toValue){
-    return fromValue + ((toValue - fromValue) * value);
-}
-
-Vector3 ActionSystem::getVector3ModifierValue(float& value, Vector3& fromValue, Vector3& toValue){
-    return fromValue + ((toValue - fromValue) * value);
-}
-
-Quaternion ActionSystem::getQuaternionModifierValue(float& value, Quaternion& fromValue, Quaternion& toValue, bool shortestPath){
-    return Quaternion::slerp(value, fromValue, toValue, shortestPath);
 }
 
 Rect ActionSystem::getSpriteModifierValue(float& value, std::vector<int>& frames, SpriteComponent& sprite){
     if (frames.size() > 0){
-        int id = frames[(int)(frames.size() * value)];
+        int id = frames[std::min((size_t)(frames.size() * value), frames.size() - 1)];
 
         if (sprite.framesRect.validIndex(id) && (unsigned int)id < sprite.numFramesRect){
             return sprite.framesRect[id].rect;
@@ -514,7 +816,7 @@ Rect ActionSystem::getSpriteModifierValue(float& value, std::vector<int>& frames
 
 Rect ActionSystem::getSpriteModifierValue(float& value, std::vector<int>& frames, PointsComponent& points){
     if (frames.size() > 0){
-        int id = frames[(int)(frames.size() * value)];
+        int id = frames[std::min((size_t)(frames.size() * value), frames.size() - 1)];
 
         if (points.framesRect.validIndex(id) && (unsigned int)id < points.numFramesRect){
             return points.framesRect[id].rect;
@@ -524,157 +826,246 @@ Rect ActionSystem::getSpriteModifierValue(float& value, std::vector<int>& frames
     return Rect(0,0,1,1);
 }
 
-void ActionSystem::applyParticleModifiers(size_t idx, ParticlesComponent& particles, InstancedMeshComponent& instmesh, SpriteComponent* sprite){
-    float particleTime = particles.particles[idx].time;
-    float value;
-    float time;
+void ActionSystem::bakeParticleCurve(FunctionSubscribe<float(float)>& function, std::vector<float>& curve){
+    curve.resize(PARTICLE_CURVE_SIZE + 1);
+    for (size_t i = 0; i <= PARTICLE_CURVE_SIZE; i++){
+        curve[i] = function.call(i / (float)PARTICLE_CURVE_SIZE);
+    }
+}
+
+void ActionSystem::bakeParticleCurves(ParticlesComponent& particles){
+    // only modifiers with a time range are used
+    auto bakeModifier = [this](auto& modifier){
+        // also rebakes when function was changed in place
+        if (modifier.fromTime != modifier.toTime && (modifier.curve.empty() || modifier.curveVersion != modifier.function.getVersion())){
+            bakeParticleCurve(modifier.function, modifier.curve);
+            modifier.curveVersion = modifier.function.getVersion();
+        }
+    };
 
-    ParticlePositionModifier& posMod = particles.positionModifier;
-    time = getTimeFromParticleTime(particleTime, posMod.fromTime, posMod.toTime);
-    value = posMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        instmesh.instances[idx].position = getVector3ModifierValue(value, posMod.fromPosition, posMod.toPosition);
+    bakeModifier(particles.positionModifier);
+    bakeModifier(particles.velocityModifier);
+    bakeModifier(particles.accelerationModifier);
+    bakeModifier(particles.colorModifier);
+    bakeModifier(particles.alphaModifier);
+    bakeModifier(particles.sizeModifier);
+    bakeModifier(particles.spriteModifier);
+    bakeModifier(particles.rotationModifier);
+    bakeModifier(particles.scaleModifier);
+}
+
+// calls 'apply' for particles inside modifier time range, with value of baked function
+template<typename Modifier, typename Apply>
+static void applyParticleModifier(ParticlesComponent& particles, size_t begin, size_t end, const Modifier& modifier, Apply apply){
+    if (modifier.fromTime == modifier.toTime || modifier.curve.empty())
+        return;
+
+    const float* curve = modifier.curve.data();
+    const float curveSize = (float)(modifier.curve.size() - 1);
+    const float invRange = 1.0f / (modifier.toTime - modifier.fromTime);
+
+    for (size_t i = begin; i < end; i++){
+        float time = particles.time[i];
+        if (time >= modifier.fromTime && time <= modifier.toTime){
+            float position = (time - modifier.fromTime) * invRange * curveSize;
+            size_t index = std::min((size_t)position, (size_t)curveSize - 1);
+            float value = curve[index] + (curve[index + 1] - curve[index]) * (position - index);
+
+            if (value >= 0 && value <= 1){
+                apply(i, value);
+            }
+        }
     }
+}
+
+void ActionSystem::applyParticleModifiers(size_t begin, size_t end, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points){
+    ParticlePositionModifier& posMod = particles.positionModifier;
+    applyParticleModifier(particles, begin, end, posMod, [&](size_t i, float value){
+        Vector3 position = posMod.fromPosition + ((posMod.toPosition - posMod.fromPosition) * value);
+        particles.positionX[i] = position.x;
+        particles.positionY[i] = position.y;
+        particles.positionZ[i] = position.z;
+    });
 
     ParticleVelocityModifier& velMod = particles.velocityModifier;
-    time = getTimeFromParticleTime(particleTime, velMod.fromTime, velMod.toTime);
-    value = velMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        particles.particles[idx].velocity = getVector3ModifierValue(value, velMod.fromVelocity, velMod.toVelocity);
-    }
+    applyParticleModifier(particles, begin, end, velMod, [&](size_t i, float value){
+        Vector3 velocity = velMod.fromVelocity + ((velMod.toVelocity - velMod.fromVelocity) * value);
+        particles.velocityX[i] = velocity.x;
+        particles.velocityY[i] = velocity.y;
+        particles.velocityZ[i] = velocity.z;
+    });
 
     ParticleAccelerationModifier& accMod = particles.accelerationModifier;
-    time = getTimeFromParticleTime(particleTime, accMod.fromTime, accMod.toTime);
-    value = accMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        particles.particles[idx].acceleration = getVector3ModifierValue(value, accMod.fromAcceleration, accMod.toAcceleration);
-    }
+    applyParticleModifier(particles, begin, end, accMod, [&](size_t i, float value){
+        Vector3 acceleration = accMod.fromAcceleration + ((accMod.toAcceleration - accMod.fromAcceleration) * value);
+        particles.accelerationX[i] = acceleration.x;
+        particles.accelerationY[i] = acceleration.y;
+        particles.accelerationZ[i] = acceleration.z;
+    });
 
     ParticleColorModifier& colMod = particles.colorModifier;
-    time = getTimeFromParticleTime(particleTime, colMod.fromTime, colMod.toTime);
-    value = colMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        instmesh.instances[idx].color = getVector3ModifierValue(value, colMod.fromColor, colMod.toColor);
+    applyParticleModifier(particles, begin, end, colMod, [&](size_t i, float value){
+        Vector3 color = colMod.fromColor + ((colMod.toColor - colMod.fromColor) * value);
         if (colMod.useSRGB){
-            instmesh.instances[idx].color = Color::sRGBToLinear(instmesh.instances[idx].color);
+            color = Color::sRGBToLinear(color);
         }
-    }
+        particles.color[i] = color;
+    });
 
     ParticleAlphaModifier& alpMod = particles.alphaModifier;
-    time = getTimeFromParticleTime(particleTime, alpMod.fromTime, alpMod.toTime);
-    value = alpMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        instmesh.instances[idx].color.w = getFloatModifierValue(value, alpMod.fromAlpha, alpMod.toAlpha);
-    }
+    applyParticleModifier(particles, begin, end, alpMod, [&](size_t i, float value){
+        particles.color[i].w = alpMod.fromAlpha + ((alpMod.toAlpha - alpMod.fromAlpha) * value);
+    });
+
+    ParticleRotationModifier& rotMod = particles.rotationModifier;
+    ParticleSpriteModifier& spriteMod = particles.spriteModifier;
+
+    if (points){
+        ParticleSizeModifier& sizeMod = particles.sizeModifier;
+        applyParticleModifier(particles, begin, end, sizeMod, [&](size_t i, float value){
+            particles.size[i] = sizeMod.fromSize + ((sizeMod.toSize - sizeMod.fromSize) * value);
+        });
 
-    // size modifier is not applicable to instanced meshes
+        applyParticleModifier(particles, begin, end, spriteMod, [&](size_t i, float value){
+            particles.textureRect[i] = getSpriteModifierValue(value, spriteMod.frames, *points);
+        });
 
-    if (sprite){
-        ParticleSpriteModifier& spriteMod = particles.spriteModifier;
-        time = getTimeFromParticleTime(particleTime, spriteMod.fromTime, spriteMod.toTime);
-        value = spriteMod.function.call(time);
-        if (value >= 0 && value <= 1){
-            instmesh.instances[idx].textureRect = getSpriteModifierValue(value, spriteMod.frames, *sprite);
+        applyParticleModifier(particles, begin, end, rotMod, [&](size_t i, float value){
+            particles.angle[i] = Angle::defaultToRad(Quaternion::slerp(value, rotMod.fromRotation, rotMod.toRotation, rotMod.shortestPath).getRoll());
+        });
+
+        // scale modifier is not applicable to points
+    }else{
+        // size modifier is not applicable to instanced meshes
+
+        if (sprite){
+            applyParticleModifier(particles, begin, end, spriteMod, [&](size_t i, float value){
+                particles.textureRect[i] = getSpriteModifierValue(value, spriteMod.frames, *sprite);
+            });
         }
-    }
 
-    ParticleRotationModifier& rotMod = particles.rotationModifier;
-    time = getTimeFromParticleTime(particleTime, rotMod.fromTime, rotMod.toTime);
-    value = rotMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        instmesh.instances[idx].rotation = getQuaternionModifierValue(value, rotMod.fromRotation, rotMod.toRotation, rotMod.shortestPath);
-    }
+        applyParticleModifier(particles, begin, end, rotMod, [&](size_t i, float value){
+            particles.rotation[i] = Quaternion::slerp(value, rotMod.fromRotation, rotMod.toRotation, rotMod.shortestPath);
+        });
 
-    ParticleScaleModifier& scaMod = particles.scaleModifier;
-    time = getTimeFromParticleTime(particleTime, scaMod.fromTime, scaMod.toTime);
-    value = scaMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        instmesh.instances[idx].scale = getVector3ModifierValue(value, scaMod.fromScale, scaMod.toScale);
+        ParticleScaleModifier& scaMod = particles.scaleModifier;
+        applyParticleModifier(particles, begin, end, scaMod, [&](size_t i, float value){
+            particles.scale[i] = scaMod.fromScale + ((scaMod.toScale - scaMod.fromScale) * value);
+        });
     }
-
 }
 
-void ActionSystem::applyParticleModifiers(size_t idx, ParticlesComponent& particles, PointsComponent& points){
-    float particleTime = particles.particles[idx].time;
-    float value;
-    float time;
+void ActionSystem::integrateParticles(size_t begin, size_t end, ParticlesComponent& particles, float dt){
+    float* px = particles.positionX.data();
+    float* py = particles.positionY.data();
+    float* pz = particles.positionZ.data();
+    float* vx = particles.velocityX.data();
+    float* vy = particles.velocityY.data();
+    float* vz = particles.velocityZ.data();
+    const float* ax = particles.accelerationX.data();
+    const float* ay = particles.accelerationY.data();
+    const float* az = particles.accelerationZ.data();
+    float* time = particles.time.data();
 
-    ParticlePositionModifier& posMod = particles.positionModifier;
-    time = getTimeFromParticleTime(particleTime, posMod.fromTime, posMod.toTime);
-    value = posMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].position = getVector3ModifierValue(value, posMod.fromPosition, posMod.toPosition);
-    }
+    const float halfDt = dt * 0.5f;
 
-    ParticleVelocityModifier& velMod = particles.velocityModifier;
-    time = getTimeFromParticleTime(particleTime, velMod.fromTime, velMod.toTime);
-    value = velMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        particles.particles[idx].velocity = getVector3ModifierValue(value, velMod.fromVelocity, velMod.toVelocity);
-    }
+    size_t i = begin;
 
-    ParticleAccelerationModifier& accMod = particles.accelerationModifier;
-    time = getTimeFromParticleTime(particleTime, accMod.fromTime, accMod.toTime);
-    value = accMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        particles.particles[idx].acceleration = getVector3ModifierValue(value, accMod.fromAcceleration, accMod.toAcceleration);
-    }
+#ifdef DORIAX_SIMD
+    simd4f simdDt = simd4fSplat(dt);
+    simd4f simdHalfDt = simd4fSplat(halfDt);
 
-    ParticleColorModifier& colMod = particles.colorModifier;
-    time = getTimeFromParticleTime(particleTime, colMod.fromTime, colMod.toTime);
-    value = colMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].color = getVector3ModifierValue(value, colMod.fromColor, colMod.toColor);
-        if (colMod.useSRGB){
-            points.points[idx].color = Color::sRGBToLinear(points.points[idx].color);
-        }
-    }
+    for (; i + 4 <= end; i += 4){
+        simd4f velX = simd4fMulAdd(simd4fLoad(vx + i), simd4fLoad(ax + i), simdHalfDt);
+        simd4f velY = simd4fMulAdd(simd4fLoad(vy + i), simd4fLoad(ay + i), simdHalfDt);
+        simd4f velZ = simd4fMulAdd(simd4fLoad(vz + i), simd4fLoad(az + i), simdHalfDt);
+        simd4fStore(vx + i, velX);
+        simd4fStore(vy + i, velY);
+        simd4fStore(vz + i, velZ);
 
-    ParticleAlphaModifier& alpMod = particles.alphaModifier;
-    time = getTimeFromParticleTime(particleTime, alpMod.fromTime, alpMod.toTime);
-    value = alpMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].color.w = getFloatModifierValue(value, alpMod.fromAlpha, alpMod.toAlpha);
+        simd4fStore(px + i, simd4fMulAdd(simd4fLoad(px + i), velX, simdDt));
+        simd4fStore(py + i, simd4fMulAdd(simd4fLoad(py + i), velY, simdDt));
+        simd4fStore(pz + i, simd4fMulAdd(simd4fLoad(pz + i), velZ, simdDt));
+
+        simd4fStore(time + i, simd4fAdd(simd4fLoad(time + i), simdDt));
     }
+#endif
+
+    for (; i < end; i++){
+        vx[i] += ax[i] * halfDt;
+        vy[i] += ay[i] * halfDt;
+        vz[i] += az[i] * halfDt;
 
-    ParticleSizeModifier& sizeMod = particles.sizeModifier;
-    time = getTimeFromParticleTime(particleTime, sizeMod.fromTime, sizeMod.toTime);
-    value = sizeMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].size = getFloatModifierValue(value, sizeMod.fromSize, sizeMod.toSize);
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        pz[i] += vz[i] * dt;
+
+        time[i] += dt;
     }
+}
 
-    ParticleSpriteModifier& spriteMod = particles.spriteModifier;
-    time = getTimeFromParticleTime(particleTime, spriteMod.fromTime, spriteMod.toTime);
-    value = spriteMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].textureRect = getSpriteModifierValue(value, spriteMod.frames, points);
+void ActionSystem::emitParticles(double dt, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points){
+    if (!particles.emitter)
+        return;
+
+    particles.newParticlesCount += dt * particles.rate;
+
+    int newparticles = (int)particles.newParticlesCount;
+    particles.newParticlesCount -= newparticles;
+    if (newparticles > particles.maxPerUpdate)
+        newparticles = particles.maxPerUpdate;
+
+    for(int i=0; i<newparticles; i++){
+        // free slots are always at the end, without loop each particle is emitted once
+        bool isFull = particles.numParticles >= particles.life.size();
+        if (isFull || (!particles.loop && particles.numEmitted >= particles.maxParticles)){
+            if (!particles.loop)
+                particles.emitter = false;
+            break;
+        }
+
+        applyParticleInitializers(particles.numParticles, particles, sprite, points);
+        particles.numParticles++;
+        particles.numEmitted++;
     }
+}
 
-    ParticleRotationModifier& rotMod = particles.rotationModifier;
-    time = getTimeFromParticleTime(particleTime, rotMod.fromTime, rotMod.toTime);
-    value = rotMod.function.call(time);
-    if (value >= 0 && value <= 1){
-        points.points[idx].rotation = Angle::defaultToRad(getQuaternionModifierValue(value, rotMod.fromRotation, rotMod.toRotation, rotMod.shortestPath).getRoll());
+void ActionSystem::removeDeadParticles(ParticlesComponent& particles){
+    size_t i = 0;
+    while (i < particles.numParticles){
+        if (particles.life[i] <= particles.time[i]){
+            // last alive particle takes the slot
+            particles.numParticles--;
+            if (i != particles.numParticles){
+                moveParticle(particles, particles.numParticles, i);
+            }
+        }else{
+            i++;
+        }
     }
+}
 
-    // scale modifier is not applicable to points
+void ActionSystem::processParticles(size_t count, const std::function<void(size_t begin, size_t end)>& func){
+    #ifndef NO_THREAD_SUPPORT
+        if (count > PARTICLES_CHUNK_SIZE){
+            ThreadPoolManager::getInstance().parallelFor(count, PARTICLES_CHUNK_SIZE, func);
+            return;
+        }
+    #endif
+    func(0, count);
 }
 
 void ActionSystem::particleActionStart(ParticlesComponent& particles, InstancedMeshComponent& instmesh, MeshComponent& mesh){
     // Creating particles
-    particles.particles.clear();
-    instmesh.instances.clear();
-    for (int i = 0; i < particles.maxParticles; i++){
-        particles.particles.push_back({});
-        particles.particles.back().life = 0;
-        particles.particles.back().time = 0;
+    resizeParticles(particles, particles.maxParticles);
+    particles.numParticles = 0;
+    particles.numEmitted = 0;
 
-        instmesh.instances.push_back({});
-        instmesh.instances.back().visible = false;
-
-        instmesh.needUpdateInstances = true;
-    }
+    instmesh.instances.clear();
+    instmesh.renderInstances.clear();
+    instmesh.numVisible = 0;
+    instmesh.externalRender = !instmesh.instancedBillboard;
+    instmesh.needUpdateInstances = true;
 
     if (instmesh.maxInstances != particles.maxParticles){
         instmesh.maxInstances = particles.maxParticles;
@@ -684,7 +1075,6 @@ void ActionSystem::particleActionStart(ParticlesComponent& particles, InstancedM
 
     particles.emitter = true;
     particles.newParticlesCount = 0;
-    particles.lastUsedParticle = 0;
 }
 
 void ActionSystem::particleActionStart(ParticlesComponent& particles, PointsComponent& points){
@@ -695,18 +1085,15 @@ void ActionSystem::particleActionStart(ParticlesComponent& particles, PointsComp
     }
 
     // Creating particles
-    particles.particles.clear();
-    points.points.clear();
-    for (int i = 0; i < particles.maxParticles; i++){
-        particles.particles.push_back({});
-        particles.particles.back().life = 0;
-        particles.particles.back().time = 0;
-
-        points.points.push_back({});
-        points.points.back().visible = false;
+    resizeParticles(particles, particles.maxParticles);
+    particles.numParticles = 0;
+    particles.numEmitted = 0;
 
-        points.needUpdate = true;
-    }
+    points.points.clear();
+    points.renderPoints.clear();
+    points.numVisible = 0;
+    points.externalRender = true;
+    points.needUpdate = true;
 
     if (points.maxPoints != particles.maxParticles){
         points.maxPoints = particles.maxParticles;
@@ -716,134 +1103,182 @@ void ActionSystem::particleActionStart(ParticlesComponent& particles, PointsComp
 
     particles.emitter = true;
     particles.newParticlesCount = 0;
-    particles.lastUsedParticle = 0;
 }
 
-void ActionSystem::particlesActionUpdate(double dt, Entity entity, Entity target, ActionComponent& action, ParticlesComponent& particles, InstancedMeshComponent& instmesh){
-    SpriteComponent* sprite = scene->findComponent<SpriteComponent>(target);
-
-    if (particles.emitter){
-        particles.newParticlesCount += dt * particles.rate;
-
-        int newparticles = (int)particles.newParticlesCount;
-        particles.newParticlesCount -= newparticles;
-        if (newparticles > particles.maxPerUpdate)
-            newparticles = particles.maxPerUpdate;
-
-        for(int i=0; i<newparticles; i++){
-            int particleIndex = findUnusedParticle(particles);
+// last particles are kept as regular instances and points, so target renders normally again
+void ActionSystem::particleActionStop(Entity target, ParticlesComponent& particles){
+    size_t count = particles.numParticles;
+
+    InstancedMeshComponent* instmesh = scene->findComponent<InstancedMeshComponent>(target);
+    if (instmesh && instmesh->externalRender){
+        instmesh->instances.resize(count);
+        for (size_t i = 0; i < count; i++){
+            InstanceData& instance = instmesh->instances[i];
+            instance.position = Vector3(particles.positionX[i], particles.positionY[i], particles.positionZ[i]);
+            instance.rotation = particles.rotation[i];
+            instance.scale = particles.scale[i];
+            instance.color = particles.color[i];
+            instance.textureRect = particles.textureRect[i];
+            instance.visible = true;
+        }
 
-            if (particleIndex >= 0){
-                particles.particles[particleIndex].time = 0;
-                applyParticleInitializers(particleIndex, particles, instmesh, sprite);
-                instmesh.needUpdateInstances = true;
-            }else{
-                if (!particles.loop)
-                    particles.emitter = false;
-                break;
-            }
+        instmesh->externalRender = false;
+        instmesh->needUpdateInstances = true;
+    }
+
+    PointsComponent* points = scene->findComponent<PointsComponent>(target);
+    if (points && points->externalRender){
+        points->points.resize(count);
+        for (size_t i = 0; i < count; i++){
+            PointData& point = points->points[i];
+            point.position = Vector3(particles.positionX[i], particles.positionY[i], particles.positionZ[i]);
+            point.color = particles.color[i];
+            point.size = particles.size[i];
+            point.rotation = particles.angle[i];
+            point.textureRect = particles.textureRect[i];
+            point.visible = true;
         }
+
+        points->externalRender = false;
+        points->needUpdate = true;
     }
+}
 
-    bool existParticles = false;
-    for(int i=0; i<particles.particles.size(); i++){
+void ActionSystem::particlesActionUpdate(double dt, Entity entity, Entity target, ActionComponent& action, ParticlesComponent& particles, InstancedMeshComponent& instmesh){
+    SpriteComponent* sprite = scene->findComponent<SpriteComponent>(target);
+    MeshComponent* mesh = scene->findComponent<MeshComponent>(target);
 
-        float life = particles.particles[i].life;
-        float time = particles.particles[i].time;
+    bakeParticleCurves(particles);
+    emitParticles(dt, particles, sprite, nullptr);
+    removeDeadParticles(particles);
 
-        if(life > time){
+    size_t count = particles.numParticles;
 
-            applyParticleModifiers(i, particles, instmesh, sprite);
+    // billboard rotation depends on camera, so it is composed by RenderSystem from instances
+    instmesh.externalRender = !instmesh.instancedBillboard;
+    if (instmesh.externalRender){
+        instmesh.renderInstances.resize(count);
+    }else{
+        instmesh.instances.resize(count);
+    }
 
-            Vector3 velocity = particles.particles[i].velocity;
-            Vector3 position = instmesh.instances[i].position;
-            Vector3 acceleration = particles.particles[i].acceleration;
+    processParticles(count, [&](size_t begin, size_t end){
+        applyParticleModifiers(begin, end, particles, sprite, nullptr);
+        integrateParticles(begin, end, particles, (float)dt);
 
-            velocity += acceleration * dt * 0.5f;
-            position += velocity * dt;
-            time += dt;
+        for (size_t i = begin; i < end; i++){
+            Vector3 position(particles.positionX[i], particles.positionY[i], particles.positionZ[i]);
 
-            particles.particles[i].time = time;
-            particles.particles[i].velocity = velocity;
-            instmesh.instances[i].position = position;
+            if (instmesh.externalRender){
+                InstanceRenderData& renderData = instmesh.renderInstances[i];
+                renderData.instanceMatrix = Matrix4::composeMatrix(position, particles.rotation[i], particles.scale[i]);
+                renderData.color = particles.color[i];
+                renderData.textureRect = particles.textureRect[i];
+            }else{
+                InstanceData& instance = instmesh.instances[i];
+                instance.position = position;
+                instance.rotation = particles.rotation[i];
+                instance.scale = particles.scale[i];
+                instance.color = particles.color[i];
+                instance.textureRect = particles.textureRect[i];
+                instance.visible = true;
+            }
+        }
+    });
+
+    if (instmesh.externalRender){
+        instmesh.numVisible = count;
+
+        if (mesh){
+            // positions bounds expanded by the largest instance
+            mesh->aabb = AABB::ZERO;
+            if (count > 0){
+                Vector3 minPosition(particles.positionX[0], particles.positionY[0], particles.positionZ[0]);
+                Vector3 maxPosition = minPosition;
+                float maxScale = 0;
+                for (size_t i = 0; i < count; i++){
+                    minPosition.x = std::min(minPosition.x, particles.positionX[i]);
+                    minPosition.y = std::min(minPosition.y, particles.positionY[i]);
+                    minPosition.z = std::min(minPosition.z, particles.positionZ[i]);
+                    maxPosition.x = std::max(maxPosition.x, particles.positionX[i]);
+                    maxPosition.y = std::max(maxPosition.y, particles.positionY[i]);
+                    maxPosition.z = std::max(maxPosition.z, particles.positionZ[i]);
+
+                    const Vector3& scale = particles.scale[i];
+                    maxScale = std::max(maxScale, std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z))));
+                }
 
-            existParticles = true;
+                const Vector3& verticesMin = mesh->verticesAABB.getMinimum();
+                const Vector3& verticesMax = mesh->verticesAABB.getMaximum();
+                Vector3 extent(std::max(std::abs(verticesMin.x), std::abs(verticesMax.x)),
+                               std::max(std::abs(verticesMin.y), std::abs(verticesMax.y)),
+                               std::max(std::abs(verticesMin.z), std::abs(verticesMax.z)));
+                Vector3 radius(extent.length() * maxScale);
 
-            instmesh.instances[i].visible = true;
-            instmesh.needUpdateInstances = true;
+                mesh->aabb.merge(AABB(minPosition - radius, maxPosition + radius));
+            }
+            mesh->needUpdateAABB = true;
 
-            //printf("1.Particle %i life %f time %f position %f %f %f\n", i, life, time, position.x, position.y, position.z);
-        }else{
-            instmesh.instances[i].visible = false;
+            if (mesh->loaded)
+                instmesh.needUpdateBuffer = true;
         }
     }
 
-    if (!existParticles && !particles.emitter){
+    instmesh.needUpdateInstances = true;
+
+    if (count == 0 && !particles.emitter){
         actionStop(entity);
         //onFinish.call(object);
     }
 }
 
 void ActionSystem::particlesActionUpdate(double dt, Entity entity, Entity target, ActionComponent& action, ParticlesComponent& particles, PointsComponent& points){
-    if (particles.emitter){
-        particles.newParticlesCount += dt * particles.rate;
+    bakeParticleCurves(particles);
+    emitParticles(dt, particles, nullptr, &points);
+    removeDeadParticles(particles);
 
-        int newparticles = (int)particles.newParticlesCount;
-        particles.newParticlesCount -= newparticles;
-        if (newparticles > particles.maxPerUpdate)
-            newparticles = particles.maxPerUpdate;
+    size_t count = particles.numParticles;
 
-        for(int i=0; i<newparticles; i++){
-            int particleIndex = findUnusedParticle(particles);
+    float sizeScale = RenderSystem::getPointSizeScale();
 
-            if (particleIndex >= 0){
-                particles.particles[particleIndex].time = 0;
-                applyParticleInitializers(particleIndex, particles, points);
-                points.needUpdate = true;
-            }else{
-                if (!particles.loop)
-                    particles.emitter = false;
-                break;
-            }
-        }
-    }
+    points.renderPoints.resize(count);
 
-    bool existParticles = false;
-    for(int i=0; i<particles.particles.size(); i++){
+    processParticles(count, [&](size_t begin, size_t end){
+        applyParticleModifiers(begin, end, particles, nullptr, &points);
+        integrateParticles(begin, end, particles, (float)dt);
 
-        float life = particles.particles[i].life;
-        float time = particles.particles[i].time;
-
-        if(life > time){
-            applyParticleModifiers(i, particles, points);
+        for (size_t i = begin; i < end; i++){
+            PointRenderData& renderData = points.renderPoints[i];
+            renderData.position = Vector3(particles.positionX[i], particles.positionY[i], particles.positionZ[i]);
+            renderData.color = particles.color[i];
+            renderData.size = particles.size[i] * sizeScale;
+            renderData.rotation = particles.angle[i];
+            renderData.textureRect = particles.textureRect[i];
+        }
+    });
 
-            Vector3 velocity = particles.particles[i].velocity;
-            Vector3 position = points.points[i].position;
-            Vector3 acceleration = particles.particles[i].acceleration;
+    points.numVisible = count;
+    points.externalRender = true;
+    points.needUpdate = true;
 
-            velocity += acceleration * dt * 0.5f;
-            position += velocity * dt;
-            time += dt;
+    if (points.loaded)
+        points.needUpdateBuffer = true;
 
-            particles.particles[i].time = time;
-            particles.particles[i].velocity = velocity;
-            points.points[i].position = position;
+    if (count == 0 && !particles.emitter){
+        actionStop(entity);
+        //onFinish.call(object);
+    }
+}
 
-            existParticles = true;
+SkeletonBone* ActionSystem::findPoseBone(Entity target, int poseBone){
+    ModelComponent* model = scene->findComponent<ModelComponent>(target);
 
-            points.points[i].visible = true;
-            points.needUpdate = true;
+    if (!model || poseBone >= (int)model->pose.size())
+        return nullptr;
 
-            //printf("1.Particle %i life %f time %f position %f %f %f\n", i, life, time, position.x, position.y, position.z);
-        }else{
-            points.points[i].visible = false;
-        }
-    }
+    model->needUpdatePose = true;
 
-    if (!existParticles && !particles.emitter){
-        actionStop(entity);
-        //onFinish.call(object);
-    }
+    return &model->pose[poseBone];
 }
 
 void ActionSystem::keyframeUpdate(double dt, ActionComponent& action, KeyframeTracksComponent& keyframe){
@@ -852,57 +1287,35 @@ void ActionSystem::keyframeUpdate(double dt, ActionComponent& action, KeyframeTr
 
     float currentTime = action.timecount;
 
-    keyframe.interpolation = 0;
-
-    keyframe.index = 0;
-    while (keyframe.index < (keyframe.times.size()-1) && keyframe.times[keyframe.index] < currentTime){
-        keyframe.index++;
-    }
-
-    float previousTime = 0;
-    float nextTime = keyframe.times[keyframe.index];
-
-    if (keyframe.index > 0){
-        previousTime = keyframe.times[keyframe.index-1];
-    }
-
-    if (nextTime > previousTime){
-        keyframe.interpolation = (currentTime - previousTime) / (nextTime - previousTime);
-    }
-
-    if (keyframe.interpolation > 1){
-        keyframe.interpolation = 1;
-    }
+    keyframe.index = findKeyframeIndex(keyframe.times.data(), (int)keyframe.times.size(), currentTime, keyframe.index);
+    keyframe.interpolation = getKeyframeInterpolation(keyframe.times.data(), keyframe.index, currentTime);
 }
 
-void ActionSystem::translateTracksUpdate(KeyframeTracksComponent& keyframe, TranslateTracksComponent& translatetracks, Transform& transform){
+void ActionSystem::translateTracksUpdate(KeyframeTracksComponent& keyframe, TranslateTracksComponent& translatetracks, Vector3& position){
     Vector3 previousTranslation = translatetracks.values[0];
     if (keyframe.index > 0){
         previousTranslation = translatetracks.values[keyframe.index-1];
     }
 
-    transform.position = previousTranslation + keyframe.interpolation * (translatetracks.values[keyframe.index] - previousTranslation);
-    transform.needUpdate = true;
+    position = previousTranslation + keyframe.interpolation * (translatetracks.values[keyframe.index] - previousTranslation);
 }
 
-void ActionSystem::scaleTracksUpdate(KeyframeTracksComponent& keyframe, ScaleTracksComponent& scaletracks, Transform& transform){
+void ActionSystem::scaleTracksUpdate(KeyframeTracksComponent& keyframe, ScaleTracksComponent& scaletracks, Vector3& scale){
     Vector3 previousScale = scaletracks.values[0];
     if (keyframe.index > 0){
         previousScale = scaletracks.values[keyframe.index-1];
     }
 
-    transform.scale = previousScale + keyframe.interpolation * (scaletracks.values[keyframe.index] - previousScale);
-    transform.needUpdate = true;
+    scale = previousScale + keyframe.interpolation * (scaletracks.values[keyframe.index] - previousScale);
 }
 
-void ActionSystem::rotateTracksUpdate(KeyframeTracksComponent& keyframe, RotateTracksComponent& rotatetracks, Transform& transform){
+void ActionSystem::rotateTracksUpdate(KeyframeTracksComponent& keyframe, RotateTracksComponent& rotatetracks, Quaternion& rotation){
     Quaternion previousRotation = rotatetracks.values[0];
     if (keyframe.index > 0){
         previousRotation = rotatetracks.values[keyframe.index-1];
     }
 
-    transform.rotation = Quaternion::slerp(keyframe.interpolation, previousRotation, rotatetracks.values[keyframe.index]);
-    transform.needUpdate = true;
+    rotation = Quaternion::slerp(keyframe.interpolation, previousRotation, rotatetracks.values[keyframe.index]);
 }
 
 void ActionSystem::morphTracksUpdate(KeyframeTracksComponent& keyframe, MorphTracksComponent& morpthtracks, MeshComponent& mesh){
@@ -1019,30 +1432,48 @@ void ActionSystem::processRunningAction(double dt, Entity entity, ActionComponen
         if (signature.test(scene->getComponentId<TranslateTracksComponent>())){
             TranslateTracksComponent& translatetracks = scene->getComponent<TranslateTracksComponent>(entity);
 
-            if (targetSignature.test(scene->getComponentId<Transform>())){
+            if (keyframe.poseBone >= 0){
+                SkeletonBone* bone = findPoseBone(action.target, keyframe.poseBone);
+
+                if (bone)
+                    translateTracksUpdate(keyframe, translatetracks, bone->position);
+            }else if (targetSignature.test(scene->getComponentId<Transform>())){
                 Transform& transform = scene->getComponent<Transform>(action.target);
 
-                translateTracksUpdate(keyframe, translatetracks, transform);
+                translateTracksUpdate(keyframe, translatetracks, transform.position);
+                transform.needUpdate = true;
             }
         }
 
         if (signature.test(scene->getComponentId<RotateTracksComponent>())){
             RotateTracksComponent& rotatetracks = scene->getComponent<RotateTracksComponent>(entity);
 
-            if (targetSignature.test(scene->getComponentId<Transform>())){
+            if (keyframe.poseBone >= 0){
+                SkeletonBone* bone = findPoseBone(action.target, keyframe.poseBone);
+
+                if (bone)
+                    rotateTracksUpdate(keyframe, rotatetracks, bone->rotation);
+            }else if (targetSignature.test(scene->getComponentId<Transform>())){
                 Transform& transform = scene->getComponent<Transform>(action.target);
 
-                rotateTracksUpdate(keyframe, rotatetracks, transform);
+                rotateTracksUpdate(keyframe, rotatetracks, transform.rotation);
+                transform.needUpdate = true;
             }
         }
 
         if (signature.test(scene->getComponentId<ScaleTracksComponent>())){
             ScaleTracksComponent& scaletracks = scene->getComponent<ScaleTracksComponent>(entity);
 
-            if (targetSignature.test(scene->getComponentId<Transform>())){
+            if (keyframe.poseBone >= 0){
+                SkeletonBone* bone = findPoseBone(action.target, keyframe.poseBone);
+
+                if (bone)
+                    scaleTracksUpdate(keyframe, scaletracks, bone->scale);
+            }else if (targetSignature.test(scene->getComponentId<Transform>())){
                 Transform& transform = scene->getComponent<Transform>(action.target);
 
-                scaleTracksUpdate(keyframe, scaletracks, transform);
+                scaleTracksUpdate(keyframe, scaletracks, transform.scale);
+                transform.needUpdate = true;
             }
         }
 
@@ -1250,7 +1681,17 @@ void ActionSystem::onComponentAdded(Entity entity, ComponentId componentId) {
 void ActionSystem::onComponentRemoved(Entity entity, ComponentId componentId) {
 	if (componentId == scene->getComponentId<ActionComponent>()) {
 		ActionComponent& action = scene->getComponent<ActionComponent>(entity);
+		if (ParticlesComponent* particles = scene->findComponent<ParticlesComponent>(entity)){
+			if (action.target != NULL_ENTITY && !action.ownedTarget){
+				particleActionStop(action.target, *particles);
+			}
+		}
 		actionDestroy(action);
+	} else if (componentId == scene->getComponentId<ParticlesComponent>()) {
+		ActionComponent* action = scene->findComponent<ActionComponent>(entity);
+		if (action && action->target != NULL_ENTITY){
+			particleActionStop(action->target, scene->getComponent<ParticlesComponent>(entity));
+		}
 	} else if (componentId == scene->getComponentId<AnimationComponent>()) {
 		AnimationComponent& animation = scene->getComponent<AnimationComponent>(entity);
 		animationDestroy(animation);
@@ -29,6 +29,7 @@
 #include "component/RotateTracksComponent.h"
 #include "component/ScaleTracksComponent.h"
 #include "component/MorphTracksComponent.h"
+#include "component/ModelComponent.h"
 
 namespace doriax{
 
@@ -36,6 +37,14 @@ namespace doriax{
 
     private:
 
+		// samples of baked modifier functions, in [0, 1]
+		static const size_t PARTICLE_CURVE_SIZE = 256;
+		// particles per worker chunk
+		static const size_t PARTICLES_CHUNK_SIZE = 4096;
+
+		std::vector<float> clipPreviousValues;
+		std::vector<float> clipNextValues;
+
 		void actionStateChange(Entity entity, ActionComponent& action);
 
 		void actionComponentStart(ActionComponent& action);
@@ -46,6 +55,8 @@ namespace doriax{
 		void actionDestroy(ActionComponent& action);
 
 		void animationUpdate(double dt, Entity entity, ActionComponent& action, AnimationComponent& animcomp);
+		bool buildAnimationClip(AnimationComponent& animcomp);
+		int animationClipUpdate(ActionComponent& action, AnimationComponent& animcomp);
 		void animationDestroy(AnimationComponent& animcomp);
 
 		// Sprite action functions
@@ -67,35 +78,38 @@ namespace doriax{
 		void alphaActionUIUpdate(double dt, ActionComponent& action, TimedActionComponent& timedaction, AlphaActionComponent& alphaaction, UIComponent& ui);
 
 		//Particle helpers functions
-		int findUnusedParticle(ParticlesComponent& particles);
-
 		float getFloatInitializerValue(float& min, float& max);
 		Vector3 getVector3InitializerValue(Vector3& min, Vector3& max, bool linearSort);
 		Quaternion getQuaternionInitializerValue(Quaternion& min, Quaternion& max, bool shortestPath);
 		Rect getSpriteInitializerValue(std::vector<int>& frames, SpriteComponent& sprite);
 		Rect getSpriteInitializerValue(std::vector<int>& frames, PointsComponent& points);
-		void applyParticleInitializers(size_t idx, ParticlesComponent& particles, InstancedMeshComponent& instmesh, SpriteComponent* sprite);
-		void applyParticleInitializers(size_t idx, ParticlesComponent& particles, PointsComponent& points);
+		void applyParticleInitializers(size_t idx, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points);
 
-		float getTimeFromParticleTime(float& time, float& fromTime, float& toTime);
-		float getFloatModifierValue(float& value, float& fromValue, float& toValue);
-		Vector3 getVector3ModifierValue(float& value, Vector3& fromValue, Vector3& toValue);
-		Quaternion getQuaternionModifierValue(float& value, Quaternion& fromValue, Quaternion& toValue, bool shortestPath);
 		Rect getSpriteModifierValue(float& value, std::vector<int>& frames, SpriteComponent& sprite);
 		Rect getSpriteModifierValue(float& value, std::vector<int>& frames, PointsComponent& points);
-		void applyParticleModifiers(size_t idx, ParticlesComponent& particles, InstancedMeshComponent& instmesh, SpriteComponent* sprite);
-		void applyParticleModifiers(size_t idx, ParticlesComponent& particles, PointsComponent& points);
+		void bakeParticleCurve(FunctionSubscribe<float(float)>& function, std::vector<float>& curve);
+		void bakeParticleCurves(ParticlesComponent& particles);
+		void applyParticleModifiers(size_t begin, size_t end, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points);
+		void integrateParticles(size_t begin, size_t end, ParticlesComponent& particles, float dt);
+
+		void resizeParticles(ParticlesComponent& particles, size_t size);
+		void moveParticle(ParticlesComponent& particles, size_t from, size_t to);
+		void emitParticles(double dt, ParticlesComponent& particles, SpriteComponent* sprite, PointsComponent* points);
+		void removeDeadParticles(ParticlesComponent& particles);
+		void processParticles(size_t count, const std::function<void(size_t begin, size_t end)>& func);
 
 		void particleActionStart(ParticlesComponent& particles, InstancedMeshComponent& instmesh, MeshComponent& mesh);
 		void particleActionStart(ParticlesComponent& particles, PointsComponent& points);
+		void particleActionStop(Entity target, ParticlesComponent& particles);
 		void particlesActionUpdate(double dt, Entity entity, Entity target, ActionComponent& action, ParticlesComponent& particles, InstancedMeshComponent& instmesh);
 		void particlesActionUpdate(double dt, Entity entity, Entity target, ActionComponent& action, ParticlesComponent& particles, PointsComponent& points);
 
 		//Keyframe
 		void keyframeUpdate(double dt, ActionComponent& action, KeyframeTracksComponent& keyframe);
-		void translateTracksUpdate(KeyframeTracksComponent& keyframe, TranslateTracksComponent& translatetracks, Transform& transform);
-		void scaleTracksUpdate(KeyframeTracksComponent& keyframe, ScaleTracksComponent& scaletracks, Transform& transform);
-		void rotateTracksUpdate(KeyframeTracksComponent& keyframe, RotateTracksComponent& rotatetracks, Transform& transform);
+		SkeletonBone* findPoseBone(Entity target, int poseBone);
+		void translateTracksUpdate(KeyframeTracksComponent& keyframe, TranslateTracksComponent& translatetracks, Vector3& position);
+		void scaleTracksUpdate(KeyframeTracksComponent& keyframe, ScaleTracksComponent& scaletracks, Vector3& scale);
+		void rotateTracksUpdate(KeyframeTracksComponent& keyframe, RotateTracksComponent& rotatetracks, Quaternion& rotation);
 		void morphTracksUpdate(KeyframeTracksComponent& keyframe, MorphTracksComponent& morpthtracks, MeshComponent& mesh);
 
 		void processRunningAction(double dt, Entity entity, ActionComponent& action);
@@ -21,6 +21,8 @@ AudioSystem::AudioSystem(Scene* scene): SubSystem(scene){
     signature.set(scene->getComponentId<AudioComponent>());
 
     cameraLastPosition = Vector3(0, 0, 0);
+
+    audiosView = scene->getView<AudioComponent>();
 }
 
 SoLoud::Soloud& AudioSystem::getSoloud(){
@@ -153,11 +155,11 @@ void AudioSystem::update(double dt){
     }
 
     auto audios = scene->getComponentArray<AudioComponent>();
-    for (int i = 0; i < audios->size(); i++){
-		AudioComponent& audio = audios->getComponentFromIndex(i);
+    for (size_t i = 0; i < audiosView->size(); i++){
+		AudioComponent& audio = audios->getComponentFromIndex(audiosView->getComponentIndex(i));
 
-        Entity entity = audios->getEntity(i);
-        Signature signature = scene->getSignature(entity);
+        Entity entity = audiosView->getEntity(i);
+        Signature signature = audiosView->getSignature(i);
 
         Vector3 worldPosition = Vector3(0, 0, 0);
         if (signature.test(scene->getComponentId<Transform>()) && audio.enable3D){
@@ -28,6 +28,8 @@ namespace doriax{
 
 		Vector3 cameraLastPosition;
 
+		std::shared_ptr<EntityView> audiosView;
+
 	public:
 		AudioSystem(Scene* scene);
 
@@ -7,8 +7,11 @@
 #include "Scene.h"
 #include "Engine.h"
 #include "buffer/InterleavedBuffer.h"
+#include "buffer/VertexWriter.h"
 #include "io/FileData.h"
 #include "io/Data.h"
+#include "io/File.h"
+#include "io/CookedModel.h"
 #include "thread/ResourceProgress.h"
 
 #include <filesystem>
@@ -59,8 +62,6 @@ bool MeshSystem::createSprite(SpriteComponent& sprite, MeshComponent& mesh, Came
 
     mesh.buffer.setUsage(BufferUsage::DYNAMIC);
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-
     if (texWidth == 0 || texHeight == 0){
         texWidth = sprite.width;
         texHeight = sprite.height;
@@ -99,12 +100,12 @@ bool MeshSystem::createSprite(SpriteComponent& sprite, MeshComponent& mesh, Came
         pivotPos.y = sprite.height - pivotPos.y;
     }
 
-    mesh.buffer.addVector3(attVertex, Vector3(-pivotPos.x, -pivotPos.y, 0));
-    mesh.buffer.addVector3(attVertex, Vector3(sprite.width-pivotPos.x, -pivotPos.y, 0));
-    mesh.buffer.addVector3(attVertex, Vector3(sprite.width-pivotPos.x,  sprite.height-pivotPos.y, 0));
-    mesh.buffer.addVector3(attVertex, Vector3(-pivotPos.x,  sprite.height-pivotPos.y, 0));
-
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
+    const Vector3 positions[4] = {
+        Vector3(-pivotPos.x, -pivotPos.y, 0),
+        Vector3(sprite.width-pivotPos.x, -pivotPos.y, 0),
+        Vector3(sprite.width-pivotPos.x,  sprite.height-pivotPos.y, 0),
+        Vector3(-pivotPos.x,  sprite.height-pivotPos.y, 0)
+    };
 
     float texCutRatioW = 0;
     float texCutRatioH = 0;
@@ -113,32 +114,25 @@ bool MeshSystem::createSprite(SpriteComponent& sprite, MeshComponent& mesh, Came
         texCutRatioH = 1.0 / texHeight * sprite.textureScaleFactor;
     }
 
+    Vector2 texcoords[4];
     if (!sprite.flipY){ 
-        mesh.buffer.addVector2(attTexcoord, Vector2(texCutRatioW, texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(1.0-texCutRatioW, texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(1.0-texCutRatioW, 1.0-texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(texCutRatioW, 1.0-texCutRatioH));
+        texcoords[0] = Vector2(texCutRatioW, texCutRatioH);
+        texcoords[1] = Vector2(1.0-texCutRatioW, texCutRatioH);
+        texcoords[2] = Vector2(1.0-texCutRatioW, 1.0-texCutRatioH);
+        texcoords[3] = Vector2(texCutRatioW, 1.0-texCutRatioH);
     }else{
-        mesh.buffer.addVector2(attTexcoord, Vector2(texCutRatioW, 1.0-texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(1.0-texCutRatioW, 1.0-texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(1.0-texCutRatioW, texCutRatioH));
-        mesh.buffer.addVector2(attTexcoord, Vector2(texCutRatioW, texCutRatioH));
+        texcoords[0] = Vector2(texCutRatioW, 1.0-texCutRatioH);
+        texcoords[1] = Vector2(1.0-texCutRatioW, 1.0-texCutRatioH);
+        texcoords[2] = Vector2(1.0-texCutRatioW, texCutRatioH);
+        texcoords[3] = Vector2(texCutRatioW, texCutRatioH);
     }
 
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
-
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
+    vertices.reserve(4);
+    for (int i = 0; i < 4; i++){
+        vertices.addVertex(positions[i], texcoords[i], Vector3(0.0f, 0.0f, 1.0f), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+    vertices.end();
 
     static const uint16_t indices_array[] = {
         0,  1,  2,
@@ -218,39 +212,183 @@ bool MeshSystem::createMeshPolygon(MeshPolygonComponent& polygon, MeshComponent&
     return true;
 }
 
-bool MeshSystem::createTilemap(TilemapComponent& tilemap, MeshComponent& mesh){
-    // Pre-check all tile textures BEFORE clearing the buffer to avoid leaving
-    // the mesh with an empty vertex buffer when textures are still loading.
-    unsigned int preReserveTiles = tilemap.reserveTiles;
-    for (int i = 0; i < (int)tilemap.numTiles; i++){
-        if (tilemap.tiles[i].width == 0 && tilemap.tiles[i].height == 0 && preReserveTiles == 0){
-            continue;
+bool MeshSystem::isTilemapTextureLoading(TilemapComponent& tilemap, MeshComponent& mesh, unsigned int index){
+    const TileData& tile = tilemap.tiles[index];
+
+    if (tile.rectId < 0 || (unsigned int)tile.rectId >= tilemap.numTilesRect){
+        return false;
+    }
+    TileRectData& rectData = tilemap.tilesRect[tile.rectId];
+    if (rectData.submeshId < 0 || (unsigned int)rectData.submeshId >= mesh.numSubmeshes){
+        return false;
+    }
+
+    Texture& texture = mesh.submeshes[rectData.submeshId].material.baseColorTexture;
+    Texture& mainTexture = mesh.submeshes[0].material.baseColorTexture;
+    if (!texture.empty()){
+        return texture.load().state == ResourceLoadState::Loading;
+    }else if (!mainTexture.empty()){
+        return mainTexture.load().state == ResourceLoadState::Loading;
+    }
+
+    return false;
+}
+
+int MeshSystem::getTilemapTileVertices(TilemapComponent& tilemap, MeshComponent& mesh, unsigned int index, Vector3* positions, Vector2* texcoords){
+    TileData& tile = tilemap.tiles[index];
+
+    if (tile.width == 0 && tile.height == 0){
+        return -1;
+    }
+
+    if (tile.rectId < 0 || (unsigned int)tile.rectId >= tilemap.numTilesRect){
+        return -1;
+    }
+
+    // Clamp tile position to non-negative — negative local coords are not supported
+    if (tile.position.x < 0) tile.position.x = 0;
+    if (tile.position.y < 0) tile.position.y = 0;
+
+    positions[0] = Vector3(tile.position.x, tile.position.y, 0);
+    positions[1] = Vector3(tile.position.x + tile.width, tile.position.y, 0);
+    positions[2] = Vector3(tile.position.x + tile.width, tile.position.y + tile.height, 0);
+    positions[3] = Vector3(tile.position.x, tile.position.y + tile.height, 0);
+
+    TileRectData& rectData = tilemap.tilesRect[tile.rectId];
+    int submeshId = (rectData.submeshId >= 0 && (unsigned int)rectData.submeshId < mesh.numSubmeshes) ? rectData.submeshId : 0;
+    Rect tileRect = rectData.rect;
+
+    Texture& texture = mesh.submeshes[submeshId].material.baseColorTexture;
+    Texture& mainTexture = mesh.submeshes[0].material.baseColorTexture;
+
+    unsigned int texWidth = 0;
+    unsigned int texHeight = 0;
+    if (!texture.empty()){
+        TextureLoadResult texResult = texture.load();
+        if (texResult.state == ResourceLoadState::Finished){
+            tileRect = normalizeTileRect(tileRect, texture.getWidth(), texture.getHeight());
+            texWidth = texture.getWidth();
+            texHeight = texture.getHeight();
         }
-        if (tilemap.tiles[i].rectId < 0 || (unsigned int)tilemap.tiles[i].rectId >= tilemap.numTilesRect){
-            continue;
+    }else if (!mainTexture.empty()){
+        TextureLoadResult texResult = mainTexture.load();
+        if (texResult.state == ResourceLoadState::Finished){
+            tileRect = normalizeTileRect(tileRect, mainTexture.getWidth(), mainTexture.getHeight());
+            texWidth = mainTexture.getWidth();
+            texHeight = mainTexture.getHeight();
         }
-        if (preReserveTiles > 0){
-            preReserveTiles--;
+    }
+
+    float texCutRatioW = 0;
+    float texCutRatioH = 0;
+    if (texWidth != 0 && texHeight != 0){
+        texCutRatioW = 1.0 / texWidth * tilemap.textureScaleFactor;
+        texCutRatioH = 1.0 / texHeight * tilemap.textureScaleFactor;
+    }
+
+    if (tilemap.flipY){
+        texcoords[0] = Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH);
+        texcoords[1] = Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH);
+        texcoords[2] = Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+texCutRatioH);
+        texcoords[3] = Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+texCutRatioH);
+    }else{
+        texcoords[0] = Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+texCutRatioH);
+        texcoords[1] = Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+texCutRatioH);
+        texcoords[2] = Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH);
+        texcoords[3] = Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH);
+    }
+
+    return submeshId;
+}
+
+void MeshSystem::setTilemapTileChunk(TilemapComponent& tilemap, unsigned int index){
+    int oldChunk = tilemap.tileChunks[index];
+    int newChunk = -1;
+
+    if (tilemap.tileSubmeshes[index] >= 0){
+        // cell of tile center, chunks are created when a tile first lands in its cell
+        const TileData& tile = tilemap.tiles[index];
+        int32_t cellX = (int32_t)std::floor((tile.position.x + tile.width / 2) / tilemap.chunkCellSize.x);
+        int32_t cellY = (int32_t)std::floor((tile.position.y + tile.height / 2) / tilemap.chunkCellSize.y);
+        uint64_t cell = ((uint64_t)(uint32_t)cellX << 32) | (uint32_t)cellY;
+
+        auto it = tilemap.chunkCells.find(cell);
+        if (it == tilemap.chunkCells.end()){
+            it = tilemap.chunkCells.emplace(cell, (unsigned int)tilemap.chunks.size()).first;
+            tilemap.chunks.emplace_back();
         }
-        TileRectData& rectData = tilemap.tilesRect[tilemap.tiles[i].rectId];
-        if (rectData.submeshId < 0 || (unsigned int)rectData.submeshId >= mesh.numSubmeshes){
-            continue;
+        newChunk = (int)it->second;
+    }
+
+    if (oldChunk == newChunk){
+        if (newChunk >= 0){
+            tilemap.chunks[newChunk].needUpdate = true;
         }
-        Texture& texture = mesh.submeshes[rectData.submeshId].material.baseColorTexture;
-        Texture& mainTexture = mesh.submeshes[0].material.baseColorTexture;
-        if (!texture.empty()){
-            TextureLoadResult texResult = texture.load();
-            if (texResult.state == ResourceLoadState::Loading){
-                return false;
-            }
-        }else if (!mainTexture.empty()){
-            TextureLoadResult texResult = mainTexture.load();
-            if (texResult.state == ResourceLoadState::Loading){
-                return false;
-            }
+        return;
+    }
+
+    if (oldChunk >= 0){
+        std::vector<unsigned int>& tiles = tilemap.chunks[oldChunk].tiles;
+        tiles.erase(std::find(tiles.begin(), tiles.end(), index));
+        tilemap.chunks[oldChunk].needUpdate = true;
+    }
+    if (newChunk >= 0){
+        tilemap.chunks[newChunk].tiles.push_back(index);
+        tilemap.chunks[newChunk].needUpdate = true;
+    }
+
+    tilemap.tileChunks[index] = newChunk;
+}
+
+void MeshSystem::updateTilemapChunkBounds(TilemapComponent& tilemap, TilemapChunk& chunk){
+    chunk.aabb = AABB();
+
+    for (unsigned int i : chunk.tiles){
+        const TileData& tile = tilemap.tiles[i];
+        chunk.aabb.merge(AABB(tile.position.x, tile.position.y, 0, tile.position.x + tile.width, tile.position.y + tile.height, 0));
+    }
+
+    chunk.needUpdate = false;
+}
+
+void MeshSystem::updateTilemapBounds(TilemapComponent& tilemap, MeshComponent& mesh){
+    AABB bounds;
+    for (const TilemapChunk& chunk : tilemap.chunks){
+        bounds.merge(chunk.aabb);
+    }
+    if (bounds.isNull()){
+        bounds = AABB::ZERO;
+    }
+
+    tilemap.width = static_cast<unsigned int>(bounds.getMaximum().x);
+    tilemap.height = static_cast<unsigned int>(bounds.getMaximum().y);
+
+    mesh.verticesAABB = bounds;
+    mesh.aabb = mesh.verticesAABB;
+
+    mesh.needUpdateAABB = true;
+}
+
+bool MeshSystem::createTilemap(TilemapComponent& tilemap, MeshComponent& mesh){
+    // Pre-check all tile textures BEFORE clearing the buffer to avoid leaving
+    // the mesh with an empty vertex buffer when textures are still loading.
+    for (unsigned int i = 0; i < tilemap.numTiles; i++){
+        if (isTilemapTextureLoading(tilemap, mesh, i)){
+            return false;
         }
     }
 
+    unsigned int slots = tilemap.renderedTiles;
+    if (tilemap.numTiles > slots || tilemap.numTiles + tilemap.reserveTiles < slots){
+        slots = tilemap.numTiles + tilemap.reserveTiles;
+    }
+    unsigned int numTiles = std::min(tilemap.numTiles, slots);
+
+    // each tile slot has 4 vertices, 32 bits indices only when 16 bits cannot address them
+    bool indices32 = (slots * 4 > 65536);
+    AttributeDataType indexType = indices32 ? AttributeDataType::UNSIGNED_INT : AttributeDataType::UNSIGNED_SHORT;
+    size_t indexSize = indices32 ? sizeof(uint32_t) : sizeof(uint16_t);
+
     mesh.submeshes[0].primitiveType = PrimitiveType::TRIANGLES;
     mesh.submeshes[0].hasTextureRect = true;
 
@@ -262,140 +400,170 @@ bool MeshSystem::createTilemap(TilemapComponent& tilemap, MeshComponent& mesh){
 
     mesh.buffer.setUsage(BufferUsage::DYNAMIC);
 
-    tilemap.width = 0;
-    tilemap.height = 0;
+    // every tile slot has its vertices, tile edits rewrite only its chunk
+    tilemap.tileSubmeshes.assign(slots, -1);
 
-    std::vector<std::vector<uint16_t>> indexMap;
-    indexMap.resize(mesh.numSubmeshes);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
+    vertices.reserve(slots * 4);
 
-    unsigned int numTiles = 0;
-    unsigned int reserveTiles = tilemap.reserveTiles;
+    for (unsigned int i = 0; i < slots; i++){
+        Vector3 positions[4];
+        Vector2 texcoords[4];
 
-    for (int i = 0; i < (int)tilemap.numTiles; i++){
+        if (i < numTiles){
+            tilemap.tileSubmeshes[i] = getTilemapTileVertices(tilemap, mesh, i, positions, texcoords);
+        }
 
-        if (tilemap.tiles[i].width == 0 && tilemap.tiles[i].height == 0 && reserveTiles == 0){
-            continue;
+        for (int v = 0; v < 4; v++){
+            vertices.addVertex(positions[v], texcoords[v], Vector3(0.0f, 0.0f, 1.0f), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
+    }
 
-        if (tilemap.tiles[i].rectId < 0 || (unsigned int)tilemap.tiles[i].rectId >= tilemap.numTilesRect){
-            continue;
+    vertices.end();
+
+    // tiles are bucketed by position, so chunks are spatial whatever order tiles were added
+    if (tilemap.chunkSize == 0){
+        tilemap.chunkSize = 1;
+    }
+    float maxTileWidth = 0;
+    float maxTileHeight = 0;
+    for (unsigned int i = 0; i < numTiles; i++){
+        if (tilemap.tileSubmeshes[i] >= 0){
+            maxTileWidth = std::max(maxTileWidth, tilemap.tiles[i].width);
+            maxTileHeight = std::max(maxTileHeight, tilemap.tiles[i].height);
         }
+    }
+    tilemap.chunkCellSize.x = (maxTileWidth > 0) ? maxTileWidth * tilemap.chunkSize : 1;
+    tilemap.chunkCellSize.y = (maxTileHeight > 0) ? maxTileHeight * tilemap.chunkSize : 1;
+
+    tilemap.chunks.clear();
+    tilemap.chunkCells.clear();
+    tilemap.tileChunks.assign(slots, -1);
+    for (unsigned int i = 0; i < numTiles; i++){
+        setTilemapTileChunk(tilemap, i);
+    }
+    for (TilemapChunk& chunk : tilemap.chunks){
+        updateTilemapChunkBounds(tilemap, chunk);
+    }
 
-        if (reserveTiles > 0){
-            reserveTiles--;
+    // each submesh has an index range with room for reserved tiles, visible chunks are packed by RenderSystem
+    std::vector<unsigned int> submeshTiles(mesh.numSubmeshes, 0);
+    for (unsigned int i = 0; i < slots; i++){
+        if (tilemap.tileSubmeshes[i] >= 0){
+            submeshTiles[tilemap.tileSubmeshes[i]]++;
         }
+    }
 
-        numTiles++;
+    bool layoutChanged = (tilemap.renderedTiles != slots);
 
-        // Clamp tile position to non-negative — negative local coords are not supported
-        if (tilemap.tiles[i].position.x < 0) tilemap.tiles[i].position.x = 0;
-        if (tilemap.tiles[i].position.y < 0) tilemap.tiles[i].position.y = 0;
+    size_t indexCount = 0;
+    for (int s = 0; s < mesh.numSubmeshes; s++){
+        size_t offset = indexCount * indexSize;
+        size_t count = std::min(submeshTiles[s] + tilemap.reserveTiles, slots) * 6;
 
-        Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-        mesh.buffer.addVector3(attVertex, Vector3(tilemap.tiles[i].position.x, tilemap.tiles[i].position.y, 0));
-        mesh.buffer.addVector3(attVertex, Vector3(tilemap.tiles[i].position.x + tilemap.tiles[i].width, tilemap.tiles[i].position.y, 0));
-        mesh.buffer.addVector3(attVertex, Vector3(tilemap.tiles[i].position.x + tilemap.tiles[i].width, tilemap.tiles[i].position.y + tilemap.tiles[i].height, 0));
-        mesh.buffer.addVector3(attVertex, Vector3(tilemap.tiles[i].position.x, tilemap.tiles[i].position.y + tilemap.tiles[i].height, 0));
+        auto it = mesh.submeshes[s].attributes.find(AttributeType::INDEX);
+        if (it == mesh.submeshes[s].attributes.end() || it->second.getCount() != count || it->second.getOffset() != offset || it->second.getDataType() != indexType){
+            layoutChanged = true;
+        }
 
-        if (tilemap.width < tilemap.tiles[i].position.x + tilemap.tiles[i].width)
-            tilemap.width = static_cast<unsigned int>(tilemap.tiles[i].position.x + tilemap.tiles[i].width);
-        if (tilemap.height < tilemap.tiles[i].position.y + tilemap.tiles[i].height)
-            tilemap.height = static_cast<unsigned int>(tilemap.tiles[i].position.y + tilemap.tiles[i].height);
+        addSubmeshAttribute(mesh.submeshes[s], "indices", AttributeType::INDEX, 1, indexType, count, offset, false);
 
-        TileRectData& rectData = tilemap.tilesRect[tilemap.tiles[i].rectId];
-        int submeshId = (rectData.submeshId >= 0 && (unsigned int)rectData.submeshId < mesh.numSubmeshes) ? rectData.submeshId : 0;
-        Rect tileRect = rectData.rect;
+        indexCount += count;
+    }
 
-        Texture& texture = mesh.submeshes[submeshId].material.baseColorTexture;
-        Texture& mainTexture = mesh.submeshes[0].material.baseColorTexture;
+    mesh.indices.clear();
+    mesh.indices.setUsage(BufferUsage::DYNAMIC);
+    mesh.indices.getAttribute(AttributeType::INDEX)->setDataType(indexType);
+    mesh.indices.setStride(indexSize);
+    if (indexCount > 0){
+        std::vector<char> indexData(indexCount * indexSize, 0);
+        mesh.indices.setValues(0, mesh.indices.getAttribute(AttributeType::INDEX), indexCount, &indexData.front(), indexSize);
+        mesh.indices.setRenderAttributes(false);
+    }
 
-        unsigned int texWidth = 0;
-        unsigned int texHeight = 0;
-        if (!texture.empty()){
-            TextureLoadResult texResult = texture.load();
-            if (texResult.state == ResourceLoadState::Finished){
-                tileRect = normalizeTileRect(tileRect, texture.getWidth(), texture.getHeight());
-                texWidth = texture.getWidth();
-                texHeight = texture.getHeight();
-            }
-        }else if (!mainTexture.empty()){
-            TextureLoadResult texResult = mainTexture.load();
-            if (texResult.state == ResourceLoadState::Finished){
-                tileRect = normalizeTileRect(tileRect, mainTexture.getWidth(), mainTexture.getHeight());
-                texWidth = mainTexture.getWidth();
-                texHeight = mainTexture.getHeight();
-            }
-        }
+    tilemap.changedTiles.clear();
+    tilemap.needUpdateIndices = true;
 
-        float texCutRatioW = 0;
-        float texCutRatioH = 0;
-        if (texWidth != 0 && texHeight != 0){
-            texCutRatioW = 1.0 / texWidth * tilemap.textureScaleFactor;
-            texCutRatioH = 1.0 / texHeight * tilemap.textureScaleFactor;
-        }
+    updateTilemapBounds(tilemap, mesh);
 
-        Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-        if (tilemap.flipY){
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+texCutRatioH));
+    if (mesh.loaded){
+        if (layoutChanged){
+            mesh.needReload = true;
         }else{
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+tileRect.getWidth()-texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH));
-            mesh.buffer.addVector2(attTexcoord, Vector2(tileRect.getX()+texCutRatioW, tileRect.getY()+tileRect.getHeight()-texCutRatioH));
+            mesh.needUpdateBuffer = true; // buffer is not immutable
         }
+    }
+    tilemap.renderedTiles = slots;
 
-        Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-        mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-        mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-        mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-        mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-
-        Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+    return true;
+}
 
-        indexMap[submeshId].push_back(0 + (i*4));
-        indexMap[submeshId].push_back(1 + (i*4));
-        indexMap[submeshId].push_back(2 + (i*4));
-        indexMap[submeshId].push_back(0 + (i*4));
-        indexMap[submeshId].push_back(2 + (i*4));
-        indexMap[submeshId].push_back(3 + (i*4));
+bool MeshSystem::updateTilemapChunks(TilemapComponent& tilemap, MeshComponent& mesh){
+    if (tilemap.tileChunks.size() != tilemap.renderedTiles || mesh.buffer.getCount() != tilemap.renderedTiles * 4 || tilemap.numTiles > tilemap.renderedTiles){
+        tilemap.needUpdateTilemap = true;
+        return false;
+    }
 
+    for (size_t index : tilemap.changedTiles){
+        if (index < tilemap.numTiles && isTilemapTextureLoading(tilemap, mesh, index)){
+            return false;
+        }
     }
 
-    mesh.indices.clear();
+    Attribute* positionAttr = mesh.buffer.getAttribute(AttributeType::POSITION);
+    Attribute* texcoordAttr = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
 
-    for (int i = 0; i < mesh.numSubmeshes; i++){
-        addSubmeshAttribute(mesh.submeshes[i], "indices", AttributeType::INDEX, 1, AttributeDataType::UNSIGNED_SHORT, indexMap[i].size(), mesh.indices.getCount() * sizeof(uint16_t), false);
+    for (size_t index : tilemap.changedTiles){
+        if (index >= tilemap.renderedTiles)
+            continue;
 
-        if (indexMap[i].size() > 0){
-            mesh.indices.setValues(mesh.indices.getCount(), mesh.indices.getAttribute(AttributeType::INDEX), indexMap[i].size(), (char*)&indexMap[i].front(), sizeof(uint16_t));
-            mesh.indices.setRenderAttributes(false);
+        unsigned int i = (unsigned int)index;
+        Vector3 positions[4];
+        Vector2 texcoords[4];
+
+        tilemap.tileSubmeshes[i] = -1;
+        if (i < tilemap.numTiles){
+            tilemap.tileSubmeshes[i] = getTilemapTileVertices(tilemap, mesh, i, positions, texcoords);
+        }
+
+        for (int v = 0; v < 4; v++){
+            mesh.buffer.setVector3((i * 4) + v, positionAttr, positions[v]);
+            mesh.buffer.setVector2((i * 4) + v, texcoordAttr, texcoords[v]);
         }
 
-        //TODO: necessary?
-        //if (indexMap[i].size() == 0) {
-        //     submesh not visible
-        //} else {
-        //     submesh visible
-        //}
+        // tile may have moved to another cell
+        setTilemapTileChunk(tilemap, i);
     }
+    tilemap.changedTiles.clear();
 
-    calculateMeshAABB(mesh);
+    for (TilemapChunk& chunk : tilemap.chunks){
+        if (chunk.needUpdate){
+            updateTilemapChunkBounds(tilemap, chunk);
+        }
+    }
 
-    if (mesh.loaded){
-        if (tilemap.renderedTiles != numTiles){
-            mesh.needReload = true;
-        }else{
-            mesh.needUpdateBuffer = true; // buffer is not immutable
+    // tiles moved to other submeshes must fit in index ranges
+    std::vector<unsigned int> submeshTiles(mesh.numSubmeshes, 0);
+    for (int submeshId : tilemap.tileSubmeshes){
+        if (submeshId >= 0){
+            submeshTiles[submeshId]++;
+        }
+    }
+    for (int s = 0; s < mesh.numSubmeshes; s++){
+        auto it = mesh.submeshes[s].attributes.find(AttributeType::INDEX);
+        if (it == mesh.submeshes[s].attributes.end() || (submeshTiles[s] * 6) > it->second.getCount()){
+            tilemap.needUpdateTilemap = true;
+            return false;
         }
     }
-    tilemap.renderedTiles = numTiles;
+
+    updateTilemapBounds(tilemap, mesh);
+
+    tilemap.needUpdateIndices = true;
+
+    if (mesh.loaded){
+        mesh.needUpdateBuffer = true; // buffer is not immutable
+    }
 
     return true;
 }
@@ -696,9 +864,40 @@ Matrix4 MeshSystem::getGLTFMeshGlobalMatrix(int nodeIndex, ModelComponent& model
     return matrix;
 }
 
-Entity MeshSystem::generateSketetalStructure(Entity entity, ModelComponent& model, int nodeIndex, int skinIndex){
-    tinygltf::Node node = model.gltfModel->nodes[nodeIndex];
-    tinygltf::Skin skin = model.gltfModel->skins[skinIndex];
+bool MeshSystem::getGLTFInverseBindMatrix(ModelComponent& model, int skinIndex, int jointIndex, Matrix4& matrix){
+    const tinygltf::Skin& skin = model.gltfModel->skins[skinIndex];
+
+    matrix = Matrix4();
+
+    // nodes between joints have no inverse bind matrix
+    if (skin.inverseBindMatrices < 0 || jointIndex < 0) {
+        return true;
+    }
+
+    const tinygltf::Accessor& accessor = model.gltfModel->accessors[skin.inverseBindMatrices];
+    const tinygltf::BufferView& bufferView = model.gltfModel->bufferViews[accessor.bufferView];
+
+    if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_MAT4) {
+        Log::error("Skeleton error: Unknown inverse bind matrix data type");
+
+        return false;
+    }
+
+    const float *matrices = (const float *) (&model.gltfModel->buffers[bufferView.buffer].data.at(0) +
+                                             bufferView.byteOffset + accessor.byteOffset +
+                                             (16 * sizeof(float) * jointIndex));
+
+    matrix = Matrix4(
+            matrices[0], matrices[4], matrices[8], matrices[12],
+            matrices[1], matrices[5], matrices[9], matrices[13],
+            matrices[2], matrices[6], matrices[10], matrices[14],
+            matrices[3], matrices[7], matrices[11], matrices[15]);
+
+    return true;
+}
+
+int MeshSystem::getGLTFJointIndex(ModelComponent& model, int nodeIndex, int skinIndex){
+    const tinygltf::Skin& skin = model.gltfModel->skins[skinIndex];
 
     int index = -1;
 
@@ -707,29 +906,62 @@ Entity MeshSystem::generateSketetalStructure(Entity entity, ModelComponent& mode
             index = j;
     }
 
-    Matrix4 offsetMatrix;
+    return index;
+}
 
-    if (skin.inverseBindMatrices >= 0) {
+int MeshSystem::getGLTFMeshNode(int meshIndex, ModelComponent& model, std::map<int, int>& nodesParent){
+    int meshNode = -1;
 
-        tinygltf::Accessor accessor = model.gltfModel->accessors[skin.inverseBindMatrices];
-        tinygltf::BufferView bufferView = model.gltfModel->bufferViews[accessor.bufferView];
+    for (size_t i = 0; i < model.gltfModel->nodes.size(); i++) {
+        nodesParent[i] = -1;
+    }
 
-        float *matrices = (float *) (&model.gltfModel->buffers[bufferView.buffer].data.at(0) +
-                                     bufferView.byteOffset + accessor.byteOffset +
-                                     (16 * sizeof(float) * index));
+    for (size_t i = 0; i < model.gltfModel->nodes.size(); i++) {
+        const tinygltf::Node& node = model.gltfModel->nodes[i];
 
-        if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_MAT4) {
-            Log::error("Skeleton error: Unknown inverse bind matrix data type");
+        if (node.mesh == meshIndex){
+            meshNode = i;
+        }
 
-            return NULL_ENTITY;
+        for (int c = 0; c < node.children.size(); c++){
+            nodesParent[node.children[c]] = i;
         }
+    }
+
+    return meshNode;
+}
+
+void MeshSystem::applyModelRootMatrix(Transform& transform, const Matrix4& matrix){
+    bool hasDefaultPosition = (transform.position == Vector3::ZERO);
+    bool hasDefaultRotation = (transform.rotation == Quaternion::IDENTITY);
+    bool hasDefaultScale = (transform.scale == Vector3::UNIT_SCALE);
+
+    Vector3 newPosition;
+    Vector3 newScale;
+    Quaternion newRotation;
+    matrix.decompose(newPosition, newScale, newRotation);
+
+    if (hasDefaultPosition) {
+        transform.position = newPosition;
+    }
+    if (hasDefaultRotation) {
+        transform.rotation = newRotation;
+    }
+    if (hasDefaultScale) {
+        transform.scale = newScale;
+    }
+    transform.needUpdate = true;
+}
+
+Entity MeshSystem::generateSketetalStructure(Entity entity, ModelComponent& model, int nodeIndex, int skinIndex){
+    tinygltf::Node node = model.gltfModel->nodes[nodeIndex];
 
-        offsetMatrix = Matrix4(
-                matrices[0], matrices[4], matrices[8], matrices[12],
-                matrices[1], matrices[5], matrices[9], matrices[13],
-                matrices[2], matrices[6], matrices[10], matrices[14],
-                matrices[3], matrices[7], matrices[11], matrices[15]);
+    int index = getGLTFJointIndex(model, nodeIndex, skinIndex);
+
+    Matrix4 offsetMatrix;
 
+    if (!getGLTFInverseBindMatrix(model, skinIndex, index, offsetMatrix)) {
+        return NULL_ENTITY;
     }
 
     Entity bone;
@@ -766,6 +998,39 @@ Entity MeshSystem::generateSketetalStructure(Entity entity, ModelComponent& mode
     return bone;
 }
 
+bool MeshSystem::generateSkeletonPose(ModelComponent& model, int nodeIndex, int skinIndex, int parent){
+    const tinygltf::Node& node = model.gltfModel->nodes[nodeIndex];
+
+    SkeletonBone bone;
+
+    bone.name = node.name;
+    bone.nodeId = nodeIndex;
+    bone.parent = parent;
+    bone.index = getGLTFJointIndex(model, nodeIndex, skinIndex);
+
+    if (!getGLTFInverseBindMatrix(model, skinIndex, bone.index, bone.offsetMatrix)) {
+        return false;
+    }
+
+    Matrix4 matrix = getGLTFNodeMatrix(nodeIndex, model);
+    matrix.decompose(bone.bindPosition, bone.bindScale, bone.bindRotation);
+
+    bone.position = bone.bindPosition;
+    bone.rotation = bone.bindRotation;
+    bone.scale = bone.bindScale;
+
+    int boneIndex = (int)model.pose.size();
+    model.pose.push_back(bone);
+
+    // depth first, so parents are always before children
+    for (size_t i = 0; i < node.children.size(); i++){
+        if (!generateSkeletonPose(model, node.children[i], skinIndex, boneIndex))
+            return false;
+    }
+
+    return true;
+}
+
 TextureFilter MeshSystem::convertFilter(int filter){
     if (filter==TINYGLTF_TEXTURE_FILTER_NEAREST){
         return TextureFilter::NEAREST;
@@ -856,24 +1121,25 @@ void MeshSystem::createPlaneNodeSubmesh(unsigned int submeshIndex, TerrainCompon
     float segment_width = (float)width / gridX;
     float segment_height = (float)height / gridY;
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-
     Attribute* attIndice = mesh.indices.getAttribute(AttributeType::INDEX);
 
     int bufferCount = mesh.buffer.getCount();
 
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::NORMAL});
+    vertices.reserve(gridX1 * gridY1);
+
     for (int iy = 0; iy < gridY1; iy++) {
         float y = iy * segment_height - height_half;
         for (int ix = 0; ix < gridX1; ix ++) {
 
             float x = ix * segment_width - width_half;
 
-            mesh.buffer.addVector3(attVertex, Vector3(x, 0, -y));
-            mesh.buffer.addVector3(attNormal, Vector3(0.0f, 1.0f, 0.0f));
+            vertices.addVertex(Vector3(x, 0, -y), Vector3(0.0f, 1.0f, 0.0f));
         }
     }
 
+    vertices.end();
+
     unsigned int bufferIndexCount = 0;
     unsigned int bufferIndexOffset = mesh.indices.getCount();
 
@@ -911,42 +1177,124 @@ size_t MeshSystem::getTerrainGridArraySize(int rootGridSize, int levels){
     return size;
 }
 
-float MeshSystem::getTerrainHeight(TerrainComponent& terrain, float x, float y){
+bool MeshSystem::buildTerrainHeightPyramid(TerrainComponent& terrain){
+    TerrainHeightPyramid& pyramid = terrain.heightPyramid;
 
-    if (x < 0 || y < 0 || x >= terrain.terrainSize || y >= terrain.terrainSize)
-        return 0;
+    if (!pyramid.levels.empty() && pyramid.id == terrain.heightMap.getId()){
+        return true;
+    }
 
-    TextureData& textureData = terrain.heightMap.getData();
+    pyramid = TerrainHeightPyramid();
 
-    int posX = floor(textureData.getWidth() * x / terrain.terrainSize);
-    int posY = floor(textureData.getHeight() * y / terrain.terrainSize);
+    if (terrain.heightMap.isFramebuffer() || terrain.heightMap.getWidth() == 0){
+        return false;
+    }
 
-    float val = terrain.maxHeight*(textureData.getColorComponent(posX,posY,0)/255.0f);
-    return val;
-}
+    TextureData& textureData = terrain.heightMap.getData();
+    const unsigned char* pixels = (const unsigned char*)textureData.getData();
+    if (!pixels){
+        return false;
+    }
+
+    int width = textureData.getWidth();
+    int height = textureData.getHeight();
+    int channels = textureData.getChannels();
+
+    TerrainHeightLevel base;
+    base.width = (width + TERRAIN_HEIGHT_BLOCK - 1) / TERRAIN_HEIGHT_BLOCK;
+    base.height = (height + TERRAIN_HEIGHT_BLOCK - 1) / TERRAIN_HEIGHT_BLOCK;
+    base.minValues.assign(base.width * base.height, 255);
+    base.maxValues.assign(base.width * base.height, 0);
+
+    for (int y = 0; y < height; y++){
+        const unsigned char* row = pixels + (size_t)y * width * channels;
+        uint8_t* minRow = &base.minValues[(y / TERRAIN_HEIGHT_BLOCK) * base.width];
+        uint8_t* maxRow = &base.maxValues[(y / TERRAIN_HEIGHT_BLOCK) * base.width];
+        for (int x = 0; x < width; x++){
+            uint8_t value = row[x * channels];
+            int bx = x / TERRAIN_HEIGHT_BLOCK;
+            minRow[bx] = std::min(minRow[bx], value);
+            maxRow[bx] = std::max(maxRow[bx], value);
+        }
+    }
 
-float MeshSystem::maxTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h) {
-    float maxVal = std::numeric_limits<float>::min();
-    for(float i = x; i < x+w; i++)
-        for(float j = z; j < z+h; j++){
-            float newVal = getTerrainHeight(terrain, i,j);
-            if(newVal > maxVal) {
-                maxVal = newVal;
+    pyramid.levels.push_back(std::move(base));
+
+    while (pyramid.levels.back().width > 1 || pyramid.levels.back().height > 1){
+        const TerrainHeightLevel& prev = pyramid.levels.back();
+
+        TerrainHeightLevel level;
+        level.width = (prev.width + 1) / 2;
+        level.height = (prev.height + 1) / 2;
+        level.minValues.resize(level.width * level.height);
+        level.maxValues.resize(level.width * level.height);
+
+        for (int y = 0; y < level.height; y++){
+            int y0 = y * 2;
+            int y1 = std::min(y0 + 1, prev.height - 1);
+            for (int x = 0; x < level.width; x++){
+                int x0 = x * 2;
+                int x1 = std::min(x0 + 1, prev.width - 1);
+
+                level.minValues[y * level.width + x] = std::min(
+                    std::min(prev.minValues[y0 * prev.width + x0], prev.minValues[y0 * prev.width + x1]),
+                    std::min(prev.minValues[y1 * prev.width + x0], prev.minValues[y1 * prev.width + x1]));
+                level.maxValues[y * level.width + x] = std::max(
+                    std::max(prev.maxValues[y0 * prev.width + x0], prev.maxValues[y0 * prev.width + x1]),
+                    std::max(prev.maxValues[y1 * prev.width + x0], prev.maxValues[y1 * prev.width + x1]));
             }
         }
-    return maxVal;
+
+        pyramid.levels.push_back(std::move(level));
+    }
+
+    pyramid.id = terrain.heightMap.getId();
+    pyramid.width = width;
+    pyramid.height = height;
+
+    return true;
 }
 
-float MeshSystem::minTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h) {
-    float minVal = std::numeric_limits<float>::max();
-    for(float i = x; i < x+w; i++)
-        for(float j = z; j < z+h; j++){
-            float newVal = getTerrainHeight(terrain, i,j);
-            if(newVal < minVal) {
-                minVal = newVal;
-            }
+void MeshSystem::getTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h, float& minHeight, float& maxHeight){
+    const TerrainHeightPyramid& pyramid = terrain.heightPyramid;
+
+    if (pyramid.levels.empty()){
+        minHeight = 0;
+        maxHeight = terrain.maxHeight;
+        return;
+    }
+
+    // area in base cells
+    int x0 = (int)floor(pyramid.width * x / terrain.terrainSize) / TERRAIN_HEIGHT_BLOCK;
+    int y0 = (int)floor(pyramid.height * z / terrain.terrainSize) / TERRAIN_HEIGHT_BLOCK;
+    int x1 = ((int)ceil(pyramid.width * (x + w) / terrain.terrainSize) - 1) / TERRAIN_HEIGHT_BLOCK;
+    int y1 = ((int)ceil(pyramid.height * (z + h) / terrain.terrainSize) - 1) / TERRAIN_HEIGHT_BLOCK;
+
+    const TerrainHeightLevel& base = pyramid.levels[0];
+    x0 = std::max(0, std::min(x0, base.width - 1));
+    y0 = std::max(0, std::min(y0, base.height - 1));
+    x1 = std::max(x0, std::min(x1, base.width - 1));
+    y1 = std::max(y0, std::min(y1, base.height - 1));
+
+    // first level where the area is inside 2x2 cells
+    size_t l = 0;
+    while (l + 1 < pyramid.levels.size() && ((x1 - x0) > 1 || (y1 - y0) > 1)){
+        x0 /= 2; y0 /= 2; x1 /= 2; y1 /= 2;
+        l++;
+    }
+
+    const TerrainHeightLevel& level = pyramid.levels[l];
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+    for (int j = y0; j <= y1; j++){
+        for (int i = x0; i <= x1; i++){
+            minValue = std::min(minValue, level.minValues[j * level.width + i]);
+            maxValue = std::max(maxValue, level.maxValues[j * level.width + i]);
         }
-    return minVal;
+    }
+
+    minHeight = terrain.maxHeight * (minValue / 255.0f);
+    maxHeight = terrain.maxHeight * (maxValue / 255.0f);
 }
 
 void MeshSystem::createTerrainNode(TerrainComponent& terrain, float x, float y, float size, int lodDepth){
@@ -967,8 +1315,7 @@ void MeshSystem::createTerrainNode(TerrainComponent& terrain, float x, float y,
 
         node.hasChilds = false;
 
-        node.maxHeight = maxTerrainHeightArea(terrain, relativeX, relativeY, size, size);
-        node.minHeight = minTerrainHeightArea(terrain, relativeX, relativeY, size, size);
+        getTerrainHeightArea(terrain, relativeX, relativeY, size, size, node.minHeight, node.maxHeight);
     }else{
         float quarterSize = halfSize/2;
 
@@ -998,6 +1345,7 @@ void MeshSystem::createTerrainNode(TerrainComponent& terrain, float x, float y,
 bool MeshSystem::createTerrain(TerrainComponent& terrain, MeshComponent& mesh){
     // Check heightmap loading state BEFORE clearing buffers to avoid leaving
     // the mesh with empty data when the heightmap is still loading.
+    // pixels are kept on CPU: node bounds and physics heightfields sample them
     terrain.heightMap.setReleaseDataAfterLoad(false);
 
     if (!terrain.heightMap.empty()){
@@ -1005,6 +1353,10 @@ bool MeshSystem::createTerrain(TerrainComponent& terrain, MeshComponent& mesh){
         if (texResult.state == ResourceLoadState::Loading){
             return false;
         }
+
+        if (!buildTerrainHeightPyramid(terrain)){
+            Log::warn("Terrain heightmap data is not available, using full height for node bounds");
+        }
     }
 
     for (int s = 0; s < 2; s++){
@@ -1146,122 +1498,87 @@ void MeshSystem::createBox(MeshComponent& mesh, float width, float height, float
     float halfHeight = height / 2.0;
     float halfDepth = depth / 2.0;
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
+    const Vector3 positions[24] = {
+        // Front face (Z+)
+        Vector3(-halfWidth, -halfHeight,  halfDepth),
+        Vector3(halfWidth, -halfHeight,  halfDepth),
+        Vector3(halfWidth,  halfHeight,  halfDepth),
+        Vector3(-halfWidth, halfHeight,  halfDepth),
+        // Back face (Z-)
+        Vector3(-halfWidth, -halfHeight, -halfDepth),
+        Vector3(halfWidth, -halfHeight, -halfDepth),
+        Vector3(halfWidth,  halfHeight, -halfDepth),
+        Vector3(-halfWidth,  halfHeight, -halfDepth),
+        // Left face (X-)
+        Vector3(-halfWidth, -halfHeight,  halfDepth),
+        Vector3(-halfWidth,  halfHeight,  halfDepth),
+        Vector3(-halfWidth,  halfHeight, -halfDepth),
+        Vector3(-halfWidth, -halfHeight, -halfDepth),
+        // Right face (X+)
+        Vector3(halfWidth, -halfHeight,  halfDepth),
+        Vector3(halfWidth,  halfHeight,  halfDepth),
+        Vector3(halfWidth,  halfHeight, -halfDepth),
+        Vector3(halfWidth, -halfHeight, -halfDepth),
+        // Top face (Y+)
+        Vector3(-halfWidth,  halfHeight,  halfDepth),
+        Vector3(halfWidth,  halfHeight,  halfDepth),
+        Vector3(halfWidth,  halfHeight, -halfDepth),
+        Vector3(-halfWidth,  halfHeight, -halfDepth),
+        // Bottom face (Y-)
+        Vector3(-halfWidth, -halfHeight,  halfDepth),
+        Vector3(halfWidth, -halfHeight,  halfDepth),
+        Vector3(halfWidth, -halfHeight, -halfDepth),
+        Vector3(-halfWidth, -halfHeight, -halfDepth)
+    };
 
-    // Front face (Z+)
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, halfHeight,  halfDepth));
-
-    // Back face (Z-)
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth,  halfHeight, -halfDepth));
-
-    // Left face (X-)
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth,  halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth,  halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight, -halfDepth));
-
-    // Right face (X+)
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight, -halfDepth));
-
-    // Top face (Y+)
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth,  halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth,  halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth,  halfHeight, -halfDepth));
-
-    // Bottom face (Y-)
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight,  halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(halfWidth, -halfHeight, -halfDepth));
-    mesh.buffer.addVector3(attVertex, Vector3(-halfWidth, -halfHeight, -halfDepth));
+    const Vector2 texcoords[24] = {
+        // Front face (Z+)
+        Vector2(0.0f, 1.0f * tiles),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(0.0f, 0.0f),
+        // Back face (Z-)
+        Vector2(0.0f, 1.0f * tiles),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(0.0f, 0.0f),
+        // Left face (X-)
+        Vector2(0.0f, 1.0f * tiles),
+        Vector2(0.0f, 0.0f),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        // Right face (X+)
+        Vector2(0.0f, 1.0f * tiles),
+        Vector2(0.0f, 0.0f),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        // Top face (Y+)
+        Vector2(0.0f, 1.0f * tiles),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(0.0f, 0.0f),
+        // Bottom face (Y-)
+        Vector2(0.0f, 0.0f),
+        Vector2(1.0f * tiles, 0.0f),
+        Vector2(1.0f * tiles, 1.0f * tiles),
+        Vector2(0.0f, 1.0f * tiles)
+    };
 
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
+    const Vector3 normals[6] = {
+        Vector3(0.0f, 0.0f, 1.0f),
+        Vector3(0.0f, 0.0f, -1.0f),
+        Vector3(-1.0f, 0.0f, 0.0f),
+        Vector3(1.0f, 0.0f, 0.0f),
+        Vector3(0.0f, 1.0f, 0.0f),
+        Vector3(0.0f, -1.0f, 0.0f)
+    };
 
-    // Front face (Z+)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-
-    // Back face (Z-)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-
-    // Left face (X-)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-
-    // Right face (X+)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-
-    // Top face (Y+)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-
-    // Bottom face (Y-)
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 0.0f));
-    mesh.buffer.addVector2(attTexcoord, Vector2(1.0f * tiles, 1.0f * tiles));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.0f, 1.0f * tiles));
-
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, 1.0f));
-    
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, -1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, -1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, -1.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 0.0f, -1.0f));
-    
-    mesh.buffer.addVector3(attNormal, Vector3(-1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(-1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(-1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(-1.0f, 0.0f, 0.0f));
-    
-    mesh.buffer.addVector3(attNormal, Vector3(1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(1.0f, 0.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(1.0f, 0.0f, 0.0f));
-    
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, 1.0f, 0.0f));
-    
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, -1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, -1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, -1.0f, 0.0f));
-    mesh.buffer.addVector3(attNormal, Vector3(0.0f, -1.0f, 0.0f));
-
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
-
-    for (int i = 0; i < 6; i++){
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
-    }
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
+    vertices.reserve(24);
+    for (int i = 0; i < 24; i++){
+        vertices.addVertex(positions[i], texcoords[i], normals[i / 4], Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+    vertices.end();
 
     static const uint16_t indices_array[] = {
             // front
@@ -1306,10 +1623,8 @@ void MeshSystem::createSphere(MeshComponent& mesh, float radius, unsigned int sl
     mesh.buffer.addAttribute(AttributeType::NORMAL, 3);
     mesh.buffer.addAttribute(AttributeType::COLOR, 4);
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
+    vertices.reserve((stacks + 1) * (slices + 1));
 
     float x, y, z, xz;                              // vertex position
     float nx, ny, nz, lengthInv = 1.0f / radius;    // vertex normal
@@ -1332,13 +1647,11 @@ void MeshSystem::createSphere(MeshComponent& mesh, float radius, unsigned int sl
             // vertex position (x, y, z)
             x = xz * sinf(sectorAngle);             // r * cos(u) * sin(v)
             z = -xz * cosf(sectorAngle);            // -r * cos(u) * cos(v)
-            mesh.buffer.addVector3(attVertex, Vector3(x, y, z));
 
             // normalized vertex normal (nx, ny, nz)
             nx = x * lengthInv;
             ny = y * lengthInv;
             nz = z * lengthInv;
-            mesh.buffer.addVector3(attNormal, Vector3(nx, ny, nz));
 
             // Z+ orientation means the texture faces the positive Z direction
             s = 0.5f + atan2f(x, z) / (2.0f * M_PI);
@@ -1346,13 +1659,13 @@ void MeshSystem::createSphere(MeshComponent& mesh, float radius, unsigned int sl
             // Remove Y flip since circle now starts at Z-
             t = (float)i / stacks;
 
-            mesh.buffer.addVector2(attTexcoord, Vector2(s, t));
-
             // vertex color (white)
-            mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+            vertices.addVertex(Vector3(x, y, z), Vector2(s, t), Vector3(nx, ny, nz), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
     }
 
+    vertices.end();
+
     // generate CCW index list of sphere triangles
     std::vector<uint16_t> indices;
     int k1, k2;
@@ -1400,10 +1713,7 @@ void MeshSystem::createCylinder(MeshComponent& mesh, float baseRadius, float top
     mesh.buffer.addAttribute(AttributeType::NORMAL, 3);
     mesh.buffer.addAttribute(AttributeType::COLOR, 4);
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
 
     float x, y, z;                                  // vertex position
     float radius;                                   // radius for each stack
@@ -1420,49 +1730,36 @@ void MeshSystem::createCylinder(MeshComponent& mesh, float baseRadius, float top
         for(int j = 0, k = 0; j <= slices; ++j, k += 3){
             x = unitCircleVertices[k];
             z = unitCircleVertices[k+2];
-            mesh.buffer.addVector3(attVertex, Vector3(x * radius, y, z * radius));
-            mesh.buffer.addVector3(attNormal, Vector3(sideNormals[k], sideNormals[k+1], sideNormals[k+2]));
-            mesh.buffer.addVector2(attTexcoord, Vector2(1.0f - (float)j / slices, t));
-            mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+            vertices.addVertex(Vector3(x * radius, y, z * radius), Vector2(1.0f - (float)j / slices, t), Vector3(sideNormals[k], sideNormals[k+1], sideNormals[k+2]), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
     }
 
     // remember where the base.top vertices start
-    unsigned int baseVertexIndex = mesh.buffer.getCount();
+    unsigned int baseVertexIndex = vertices.getCount();
 
     // put vertices of base of cylinder
     y = -height * 0.5f;
-    mesh.buffer.addVector3(attVertex, Vector3(0, y, 0));
-    mesh.buffer.addVector3(attNormal, Vector3(0, -1, 0));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.5f, 0.5f));
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+    vertices.addVertex(Vector3(0, y, 0), Vector2(0.5f, 0.5f), Vector3(0, -1, 0), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
     for(int i = 0, j = 0; i < slices; ++i, j += 3){
         x = unitCircleVertices[j];
         z = unitCircleVertices[j+2];
-        mesh.buffer.addVector3(attVertex, Vector3(x * baseRadius, y, z * baseRadius));
-        mesh.buffer.addVector3(attNormal, Vector3(0, -1, 0));
-        mesh.buffer.addVector2(attTexcoord, Vector2(x * 0.5f + 0.5f, -z * 0.5f + 0.5f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+        vertices.addVertex(Vector3(x * baseRadius, y, z * baseRadius), Vector2(x * 0.5f + 0.5f, -z * 0.5f + 0.5f), Vector3(0, -1, 0), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
     }
 
     // remember where the base vertices start
-    unsigned int topVertexIndex = mesh.buffer.getCount();
+    unsigned int topVertexIndex = vertices.getCount();
 
     // put vertices of top of cylinder
     y = height * 0.5f;
-    mesh.buffer.addVector3(attVertex, Vector3(0, y, 0));
-    mesh.buffer.addVector3(attNormal, Vector3(0, 1, 0));
-    mesh.buffer.addVector2(attTexcoord, Vector2(0.5f, 0.5f));
-    mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+    vertices.addVertex(Vector3(0, y, 0), Vector2(0.5f, 0.5f), Vector3(0, 1, 0), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
     for(int i = 0, j = 0; i < slices; ++i, j += 3){
         x = unitCircleVertices[j];
         z = unitCircleVertices[j+2];
-        mesh.buffer.addVector3(attVertex, Vector3(x * topRadius, y, z * topRadius));
-        mesh.buffer.addVector3(attNormal, Vector3(0, 1, 0));
-        mesh.buffer.addVector2(attTexcoord, Vector2(-x * 0.5f + 0.5f, -z * 0.5f + 0.5f));
-        mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+        vertices.addVertex(Vector3(x * topRadius, y, z * topRadius), Vector2(-x * 0.5f + 0.5f, -z * 0.5f + 0.5f), Vector3(0, 1, 0), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
     }
 
+    vertices.end();
+
     std::vector<uint16_t> indices;
 
     // put indices for sides
@@ -1531,10 +1828,7 @@ void MeshSystem::createCapsule(MeshComponent& mesh, float baseRadius, float topR
     mesh.buffer.addAttribute(AttributeType::NORMAL, 3);
     mesh.buffer.addAttribute(AttributeType::COLOR, 4);
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
 
     float stackHeight = height / stacks;
     float stackAngle = 2 * M_PI / slices;
@@ -1551,10 +1845,7 @@ void MeshSystem::createCapsule(MeshComponent& mesh, float baseRadius, float topR
             float s = (float)j / slices;
             float t = (float)(stacks / 2 - i) / (stacks / 2);
 
-            mesh.buffer.addVector3(attVertex, Vector3(x, y + height / 2, z));
-            mesh.buffer.addVector3(attNormal, Vector3(x / topRadius, y / topRadius, z / topRadius));
-            mesh.buffer.addVector2(attTexcoord, Vector2(s, t));
-            mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+            vertices.addVertex(Vector3(x, y + height / 2, z), Vector2(s, t), Vector3(x / topRadius, y / topRadius, z / topRadius), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
     }
 
@@ -1570,13 +1861,12 @@ void MeshSystem::createCapsule(MeshComponent& mesh, float baseRadius, float topR
             float s = (float)j / slices;
             float t = (float)(stacks - i) / (stacks / 2);
 
-            mesh.buffer.addVector3(attVertex, Vector3(x, y - height / 2, z));
-            mesh.buffer.addVector3(attNormal, Vector3(x / baseRadius, y / baseRadius, z / baseRadius));
-            mesh.buffer.addVector2(attTexcoord, Vector2(s, t));
-            mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+            vertices.addVertex(Vector3(x, y - height / 2, z), Vector2(s, t), Vector3(x / baseRadius, y / baseRadius, z / baseRadius), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
     }
 
+    vertices.end();
+
     std::vector<uint16_t> indices;
 
     for (int i = 0; i < (stacks + 1); ++i) {
@@ -1616,10 +1906,8 @@ void MeshSystem::createTorus(MeshComponent& mesh, float radius, float ringRadius
     mesh.buffer.addAttribute(AttributeType::NORMAL, 3);
     mesh.buffer.addAttribute(AttributeType::COLOR, 4);
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
+    vertices.reserve((sides + 1) * (rings + 1));
 
     const float two_pi = 2.0f * M_PI;
     const float dv = 1.0f / sides;
@@ -1645,13 +1933,12 @@ void MeshSystem::createTorus(MeshComponent& mesh, float radius, float ringRadius
             const float ipy = 0.0f;
             const float ipz = -cos_theta * radius;
 
-            mesh.buffer.addVector3(attVertex, Vector3(spx, spy, spz));
-            mesh.buffer.addVector3(attNormal, Vector3(spx - ipx, spy - ipy, spz - ipz));
-            mesh.buffer.addVector2(attTexcoord, Vector2(ring * du, side * dv));
-            mesh.buffer.addVector4(attColor, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+            vertices.addVertex(Vector3(spx, spy, spz), Vector2(ring * du, side * dv), Vector3(spx - ipx, spy - ipy, spz - ipz), Vector4(1.0f, 1.0f, 1.0f, 1.0f));
         }
     }
 
+    vertices.end();
+
     // generate indices
     std::vector<uint16_t> indices;
     for (uint16_t side = 0; side < sides; side++) {
@@ -1753,47 +2040,13 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
         ResourceProgress::updateProgress(buildId, 0.3f); // File loaded, starting processing
     }
 
-    int meshNode = -1;
     std::map<int, int> nodesParent;
-
-    for (size_t i = 0; i < model.gltfModel->nodes.size(); i++) {
-        nodesParent[i] = -1;
-    }
-
-    for (size_t i = 0; i < model.gltfModel->nodes.size(); i++) {
-        tinygltf::Node node = model.gltfModel->nodes[i];
-
-        if (node.mesh == meshIndex){
-            meshNode = i;
-        }
-
-        for (int c = 0; c < node.children.size(); c++){
-            nodesParent[node.children[c]] = i;
-        }
-    }
+    int meshNode = getGLTFMeshNode(meshIndex, model, nodesParent);
 
     Matrix4 matrix = getGLTFMeshGlobalMatrix(meshNode, model, nodesParent);
 
     if (changeRootTransform) {
-        bool hasDefaultPosition = (transform.position == Vector3::ZERO);
-        bool hasDefaultRotation = (transform.rotation == Quaternion::IDENTITY);
-        bool hasDefaultScale = (transform.scale == Vector3::UNIT_SCALE);
-
-        Vector3 newPosition;
-        Vector3 newScale;
-        Quaternion newRotation;
-        matrix.decompose(newPosition, newScale, newRotation);
-
-        if (hasDefaultPosition) {
-            transform.position = newPosition;
-        }
-        if (hasDefaultRotation) {
-            transform.rotation = newRotation;
-        }
-        if (hasDefaultScale) {
-            transform.scale = newScale;
-        }
-        transform.needUpdate = true;
+        applyModelRootMatrix(transform, matrix);
     }
 
     mesh.cullingMode = CullingMode::BACK;
@@ -2001,7 +2254,7 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
 
                 // Sokol always normalize unsigned short
                 if (dataType == AttributeDataType::UNSIGNED_SHORT){
-                    mesh.normAdjustJoint = 65535.0;
+                    mesh.skinning->normAdjustJoint = 65535.0;
                 }
             }
             if (attrib.first.compare("WEIGHTS_0") == 0){
@@ -2010,16 +2263,16 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
 
                 if (accessor.normalized){
                     if (dataType == AttributeDataType::BYTE){
-                        mesh.normAdjustWeight = 127.0;
+                        mesh.skinning->normAdjustWeight = 127.0;
                     }else if (dataType == AttributeDataType::UNSIGNED_BYTE){
-                        mesh.normAdjustWeight = 255.0;
+                        mesh.skinning->normAdjustWeight = 255.0;
                     }else if (dataType == AttributeDataType::SHORT){
-                        mesh.normAdjustWeight = 32767.0;
+                        mesh.skinning->normAdjustWeight = 32767.0;
                     }
                 }
                 // Sokol always normalize unsigned short
                 if (dataType == AttributeDataType::UNSIGNED_SHORT){
-                    mesh.normAdjustWeight = 65535.0;
+                    mesh.skinning->normAdjustWeight = 65535.0;
                 }
             }
 
@@ -2196,7 +2449,33 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
             }
         }
 
-        if (!skipEntities) {
+        if (model.compactSkeleton) {
+            if (skin.joints.size() > MAX_BONES){
+                Log::error("Cannot create skinning bigger than %i", MAX_BONES);
+                if (asyncLoad) {
+                    ResourceProgress::failBuild(buildId);
+                }
+                return false;
+            }
+
+            // pose is not serialized, it is always rebuilt from file
+            model.pose.clear();
+            model.skeleton = NULL_ENTITY;
+
+            if (!generateSkeletonPose(model, skeletonRoot, skinIndex, -1)) {
+                model.pose.clear();
+            }
+
+            // bones materialized before reload keep following the pose
+            for (SkeletonBone& bone : model.pose){
+                auto it = model.bonesIdMapping.find(bone.nodeId);
+                if (it != model.bonesIdMapping.end()){
+                    bone.entity = it->second;
+                }
+            }
+
+            model.needUpdatePose = true;
+        }else if (!skipEntities) {
             model.bonesNameMapping.clear();
             model.bonesIdMapping.clear();
 
@@ -2218,6 +2497,11 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
     if (!skipEntities) {
         model.animations.clear();
 
+        std::map<int, int> poseBones;
+        for (int b = 0; b < (int)model.pose.size(); b++){
+            poseBones[model.pose[b].nodeId] = b;
+        }
+
         for (size_t i = 0; i < model.gltfModel->animations.size(); i++) {
             const tinygltf::Animation &animation = model.gltfModel->animations[i];
 
@@ -2230,6 +2514,7 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
             AnimationComponent& animcomp = scene->getComponent<AnimationComponent>(anim);
 
             animcomp.name = animation.name;
+            animcomp.compactClip = true;
 
             std::string animName = animation.name.empty() ? "Animation " + std::to_string(i) : animation.name;
             scene->setEntityName(anim, animName);
@@ -2332,7 +2617,10 @@ bool MeshSystem::loadGLTF(Entity entity, const std::string filename, bool asyncL
                     }
 
                     if (foundTrack) {
-                        if (model.bonesIdMapping.count(channel.target_node)) {
+                        if (poseBones.count(channel.target_node)) {
+                            actiontrack.target = entity;
+                            keyframe.poseBone = poseBones[channel.target_node];
+                        } else if (model.bonesIdMapping.count(channel.target_node)) {
                             actiontrack.target = model.bonesIdMapping[channel.target_node];
                         } else {
                             actiontrack.target = entity;
@@ -2543,10 +2831,7 @@ bool MeshSystem::loadOBJ(Entity entity, const std::string filename, bool asyncLo
         ResourceProgress::updateProgress(buildId, 0.6f); // Materials processed, starting geometry
     }
 
-    Attribute* attVertex = mesh.buffer.getAttribute(AttributeType::POSITION);
-    Attribute* attTexcoord = mesh.buffer.getAttribute(AttributeType::TEXCOORD1);
-    Attribute* attNormal = mesh.buffer.getAttribute(AttributeType::NORMAL);
-    Attribute* attColor = mesh.buffer.getAttribute(AttributeType::COLOR);
+    VertexWriter vertices(mesh.buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1, AttributeType::NORMAL, AttributeType::COLOR});
 
     std::vector<std::vector<uint16_t>> indexMap;
     if (materials.size() > 0) {
@@ -2574,41 +2859,42 @@ bool MeshSystem::loadOBJ(Entity entity, const std::string filename, bool asyncLo
             for (size_t v = 0; v < fnum; v++) {
                 tinyobj::index_t idx = shapes[i].mesh.indices[index_offset + v];
 
-                indexMap[material_id].push_back(mesh.buffer.getCount());
+                indexMap[material_id].push_back(vertices.getCount());
 
-                    mesh.buffer.addVector3(attVertex,
-                                        Vector3(attrib.vertices[3*idx.vertex_index+0],
-                                                attrib.vertices[3*idx.vertex_index+1],
-                                                attrib.vertices[3*idx.vertex_index+2]));
+                Vector3 position(attrib.vertices[3*idx.vertex_index+0],
+                                 attrib.vertices[3*idx.vertex_index+1],
+                                 attrib.vertices[3*idx.vertex_index+2]);
 
+                Vector2 texcoord;
                 if (attrib.texcoords.size() > 0) {
-                        mesh.buffer.addVector2(attTexcoord,
-                                            Vector2(attrib.texcoords[2 * idx.texcoord_index + 0],
-                                                    1.0f - attrib.texcoords[2 * idx.texcoord_index + 1]));
+                    texcoord = Vector2(attrib.texcoords[2 * idx.texcoord_index + 0],
+                                       1.0f - attrib.texcoords[2 * idx.texcoord_index + 1]);
                 }
+
+                Vector3 normal;
                 if (attrib.normals.size() > 0) {
-                        mesh.buffer.addVector3(attNormal,
-                                            Vector3(attrib.normals[3 * idx.normal_index + 0],
-                                                    attrib.normals[3 * idx.normal_index + 1],
-                                                    attrib.normals[3 * idx.normal_index + 2]));
+                    normal = Vector3(attrib.normals[3 * idx.normal_index + 0],
+                                     attrib.normals[3 * idx.normal_index + 1],
+                                     attrib.normals[3 * idx.normal_index + 2]);
                 }
 
+                Vector4 color(1.0, 1.0, 1.0, 1.0);
                 if (attrib.colors.size() > 0){
-                        mesh.buffer.addVector4(attColor,
-                                            Vector4(attrib.colors[3 * idx.vertex_index + 0],
-                                                    attrib.colors[3 * idx.vertex_index + 1],
-                                                    attrib.colors[3 * idx.vertex_index + 2],
-                                                    1.0));
-                }else{
-                        mesh.buffer.addVector4(attColor, Vector4(1.0, 1.0, 1.0, 1.0));
+                    color = Vector4(attrib.colors[3 * idx.vertex_index + 0],
+                                    attrib.colors[3 * idx.vertex_index + 1],
+                                    attrib.colors[3 * idx.vertex_index + 2],
+                                    1.0);
                 }
 
+                vertices.addVertex(position, texcoord, normal, color);
             }
 
             index_offset += fnum;
         }
     }
 
+    vertices.end();
+
     if (asyncLoad) {
         ResourceProgress::updateProgress(buildId, 0.9f); // Geometry processed
     }
@@ -2639,6 +2925,864 @@ bool MeshSystem::loadOBJ(Entity entity, const std::string filename, bool asyncLo
     return true;
 }
 
+static void writeCookedVector3(CookedModelWriter& writer, const Vector3& value){
+    writer.write(value.x);
+    writer.write(value.y);
+    writer.write(value.z);
+}
+
+static Vector3 readCookedVector3(CookedModelReader& reader){
+    float x = reader.read<float>();
+    float y = reader.read<float>();
+    float z = reader.read<float>();
+    return Vector3(x, y, z);
+}
+
+static void writeCookedMatrix(CookedModelWriter& writer, const Matrix4& value){
+    for (int c = 0; c < 4; c++){
+        for (int r = 0; r < 4; r++){
+            writer.write(value[c][r]);
+        }
+    }
+}
+
+static Matrix4 readCookedMatrix(CookedModelReader& reader){
+    Matrix4 value;
+    for (int c = 0; c < 4; c++){
+        for (int r = 0; r < 4; r++){
+            value[c][r] = reader.read<float>();
+        }
+    }
+    return value;
+}
+
+static void writeCookedAttribute(CookedModelWriter& writer, AttributeType type, const Attribute& attribute){
+    writer.write<uint32_t>((uint32_t)type);
+    writer.write<uint32_t>((uint32_t)attribute.getDataType());
+    writer.writeString(attribute.getBufferName());
+    writer.write<uint32_t>(attribute.getElements());
+    writer.write<uint64_t>(attribute.getOffset());
+    writer.write<uint32_t>(attribute.getCount());
+    writer.write<uint8_t>(attribute.getNormalized());
+    writer.write<uint8_t>(attribute.getPerInstance());
+}
+
+static AttributeType readCookedAttribute(CookedModelReader& reader, Attribute& attribute){
+    AttributeType type = (AttributeType)reader.read<uint32_t>();
+    attribute.setDataType((AttributeDataType)reader.read<uint32_t>());
+    attribute.setBufferName(reader.readString());
+    attribute.setElements(reader.read<uint32_t>());
+    attribute.setOffset((size_t)reader.read<uint64_t>());
+    attribute.setCount(reader.read<uint32_t>());
+    attribute.setNormalized(reader.read<uint8_t>() != 0);
+    attribute.setPerInstance(reader.read<uint8_t>() != 0);
+    return type;
+}
+
+static void writeCookedTexture(CookedModelWriter& writer, const Texture& texture){
+    CookedTextureSource source = CookedTextureSource::NONE;
+    if (!texture.getPath().empty()){
+        source = CookedTextureSource::PATH;
+    }else if (texture.hasData()){
+        source = CookedTextureSource::DATA;
+    }
+
+    writer.write(source);
+    writer.write<uint8_t>((uint8_t)texture.getMinFilter());
+    writer.write<uint8_t>((uint8_t)texture.getMagFilter());
+    writer.write<uint8_t>((uint8_t)texture.getWrapU());
+    writer.write<uint8_t>((uint8_t)texture.getWrapV());
+
+    if (source == CookedTextureSource::PATH){
+        writer.writeString(texture.getPath());
+    }else if (source == CookedTextureSource::DATA){
+        TextureData& data = texture.getData();
+        writer.writeString(texture.getId());
+        writer.write<int32_t>(data.getWidth());
+        writer.write<int32_t>(data.getHeight());
+        writer.write<uint8_t>((uint8_t)data.getColorFormat());
+        writer.write<uint8_t>((uint8_t)data.getChannels());
+        writer.writeBlock(data.getData(), data.getSize());
+    }
+}
+
+static size_t getCookedDataTypeSize(AttributeDataType dataType){
+    switch (dataType){
+        case AttributeDataType::BYTE:
+        case AttributeDataType::UNSIGNED_BYTE:
+            return 1;
+        case AttributeDataType::SHORT:
+        case AttributeDataType::UNSIGNED_SHORT:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+// cooked blocks are used in place, so every attribute must fit in its buffer before setData
+static bool isCookedAttributeValid(AttributeType type, const Attribute& attribute, unsigned int stride, unsigned int count, size_t size, bool interleaved){
+    if ((uint32_t)type > (uint32_t)AttributeType::TERRAINNODERESOLUTION ||
+        (uint32_t)attribute.getDataType() > (uint32_t)AttributeDataType::FLOAT ||
+        attribute.getElements() == 0 || attribute.getElements() > 4){
+        return false;
+    }
+
+    uint64_t elementSize = (uint64_t)attribute.getElements() * getCookedDataTypeSize(attribute.getDataType());
+    if (interleaved && stride > 0){
+        return (uint64_t)attribute.getOffset() + elementSize <= stride;
+    }
+
+    uint64_t step = (stride > 0) ? stride : elementSize;
+    return count == 0 || (uint64_t)attribute.getOffset() + ((uint64_t)(count - 1) * step) + elementSize <= size;
+}
+
+static uint32_t getCookedIndex(const unsigned char* data, AttributeDataType dataType){
+    if (dataType == AttributeDataType::UNSIGNED_BYTE){
+        return *data;
+    }else if (dataType == AttributeDataType::UNSIGNED_SHORT){
+        uint16_t index;
+        memcpy(&index, data, sizeof(uint16_t));
+        return index;
+    }
+    uint32_t index;
+    memcpy(&index, data, sizeof(uint32_t));
+    return index;
+}
+
+static bool readCookedTexture(CookedModelReader& reader, Texture& texture){
+    CookedTextureSource source = reader.read<CookedTextureSource>();
+    TextureFilter minFilter = (TextureFilter)reader.read<uint8_t>();
+    TextureFilter magFilter = (TextureFilter)reader.read<uint8_t>();
+    TextureWrap wrapU = (TextureWrap)reader.read<uint8_t>();
+    TextureWrap wrapV = (TextureWrap)reader.read<uint8_t>();
+
+    if ((uint8_t)source > (uint8_t)CookedTextureSource::DATA ||
+        (uint32_t)minFilter > (uint32_t)TextureFilter::LINEAR_MIPMAP_LINEAR || (uint32_t)magFilter > (uint32_t)TextureFilter::LINEAR_MIPMAP_LINEAR ||
+        (uint32_t)wrapU > (uint32_t)TextureWrap::CLAMP_TO_BORDER || (uint32_t)wrapV > (uint32_t)TextureWrap::CLAMP_TO_BORDER){
+        return false;
+    }
+
+    if (source == CookedTextureSource::PATH){
+        texture.setPath(reader.readString());
+    }else if (source == CookedTextureSource::DATA){
+        std::string id = reader.readString();
+        int width = reader.read<int32_t>();
+        int height = reader.read<int32_t>();
+        ColorFormat colorFormat = (ColorFormat)reader.read<uint8_t>();
+        int channels = reader.read<uint8_t>();
+        size_t size;
+        const unsigned char* pixels = reader.readBlock(size);
+        if (reader.isFailed()){
+            return false;
+        }
+
+        if (width <= 0 || height <= 0 || channels < 1 || channels > 4 || (uint32_t)colorFormat > (uint32_t)ColorFormat::RGBA ||
+            (uint64_t)size != (uint64_t)width * (uint64_t)height * (uint64_t)channels){
+            return false;
+        }
+
+        // pixels stay in cooked data, like glTF images stay in tinygltf::Model
+        texture.setData(id, TextureData(width, height, (unsigned int)size, colorFormat, channels, (void*)pixels));
+        texture.setReleaseDataAfterLoad(false);
+    }else{
+        return true;
+    }
+
+    texture.setMinFilter(minFilter);
+    texture.setMagFilter(magFilter);
+    texture.setWrapU(wrapU);
+    texture.setWrapV(wrapV);
+
+    return true;
+}
+
+bool MeshSystem::cookModel(Entity entity, const std::string& filename){
+    MeshComponent& mesh = scene->getComponent<MeshComponent>(entity);
+    ModelComponent& model = scene->getComponent<ModelComponent>(entity);
+
+    if (model.pose.empty() && !model.bonesIdMapping.empty()){
+        Log::error("Cannot cook model %s: skeleton must be loaded as compact skeleton", model.filename.c_str());
+        return false;
+    }
+
+    CookedModelWriter writer;
+
+    writer.write(COOKEDMODEL_MAGIC, 4);
+    writer.write<uint32_t>(COOKEDMODEL_VERSION);
+
+    // mesh
+    Matrix4 rootMatrix;
+    if (model.gltfModel){
+        std::map<int, int> nodesParent;
+        int meshNode = getGLTFMeshNode(0, model, nodesParent);
+        if (meshNode >= 0){
+            rootMatrix = getGLTFMeshGlobalMatrix(meshNode, model, nodesParent);
+        }
+    }
+    writeCookedMatrix(writer, rootMatrix);
+
+    writer.write<uint32_t>(std::max(mesh.vertexCount, mesh.buffer.getCount()));
+    writer.write<uint8_t>((uint8_t)mesh.cullingMode);
+    writer.write<uint8_t>((uint8_t)mesh.windingOrder);
+    writer.write<uint8_t>(mesh.transparent);
+    // not allocated skinning has default values, skip it to not acquire from pool
+    const PooledObject<MeshSkinning>& skinning = mesh.skinning;
+    writer.write<uint8_t>(skinning.isAllocated());
+    if (skinning.isAllocated()){
+        writer.write(skinning->normAdjustJoint);
+        writer.write(skinning->normAdjustWeight);
+    }
+    for (int i = 0; i < MAX_MORPHTARGETS; i++){
+        writer.write(mesh.morphWeights[i]);
+    }
+
+    bool hasAABB = mesh.verticesAABB.isFinite() && mesh.verticesAABB != AABB::ZERO;
+    writer.write<uint8_t>(hasAABB);
+    writeCookedVector3(writer, mesh.verticesAABB.getMinimum());
+    writeCookedVector3(writer, mesh.verticesAABB.getMaximum());
+
+    // buffers, vertices and indices become external buffers when loaded
+    std::vector<std::pair<std::string, Buffer*>> buffers;
+    if (mesh.buffer.getSize() > 0){
+        buffers.push_back({"vertices", &mesh.buffer});
+    }
+    if (mesh.indices.getSize() > 0){
+        buffers.push_back({"indices", &mesh.indices});
+    }
+    for (int i = 0; i < mesh.numExternalBuffers; i++){
+        buffers.push_back({mesh.eBuffers[i].getName(), &mesh.eBuffers[i]});
+    }
+
+    writer.write<uint32_t>((uint32_t)buffers.size());
+    for (auto const& buf : buffers){
+        writer.writeString(buf.first);
+        writer.write<uint8_t>((uint8_t)buf.second->getType());
+        writer.write<uint8_t>((uint8_t)buf.second->getUsage());
+        writer.write<uint8_t>(buf.second->isRenderAttributes());
+        writer.write<uint32_t>(buf.second->getStride());
+        writer.write<uint32_t>(buf.second->getCount());
+
+        writer.write<uint32_t>((uint32_t)buf.second->getAttributes().size());
+        for (auto const& attr : buf.second->getAttributes()){
+            writeCookedAttribute(writer, attr.first, attr.second);
+        }
+
+        writer.writeBlock(buf.second->getData(), buf.second->getSize());
+    }
+
+    // submeshes
+    writer.write<uint32_t>(mesh.numSubmeshes);
+    for (unsigned int i = 0; i < mesh.numSubmeshes; i++){
+        const Submesh& submesh = mesh.submeshes[i];
+
+        writer.write<uint8_t>((uint8_t)submesh.primitiveType);
+        writer.write<uint8_t>(submesh.faceCulling);
+        writer.write<uint8_t>(submesh.textureShadow);
+        writer.write<uint8_t>(submesh.hasTextureRect);
+        writer.write(submesh.textureRect.getX());
+        writer.write(submesh.textureRect.getY());
+        writer.write(submesh.textureRect.getWidth());
+        writer.write(submesh.textureRect.getHeight());
+        writer.write<uint32_t>(submesh.vertexCount);
+
+        const Material& material = submesh.material;
+        writer.writeString(material.name);
+        writer.write(material.baseColorFactor.x);
+        writer.write(material.baseColorFactor.y);
+        writer.write(material.baseColorFactor.z);
+        writer.write(material.baseColorFactor.w);
+        writer.write(material.metallicFactor);
+        writer.write(material.roughnessFactor);
+        writeCookedVector3(writer, material.emissiveFactor);
+
+        writeCookedTexture(writer, material.baseColorTexture);
+        writeCookedTexture(writer, material.emissiveTexture);
+        writeCookedTexture(writer, material.metallicRoughnessTexture);
+        writeCookedTexture(writer, material.occlusionTexture);
+        writeCookedTexture(writer, material.normalTexture);
+
+        writer.write<uint32_t>((uint32_t)submesh.attributes.size());
+        for (auto const& attr : submesh.attributes){
+            writeCookedAttribute(writer, attr.first, attr.second);
+        }
+    }
+
+    // morph names and skeleton
+    writer.write<uint32_t>((uint32_t)model.morphNameMapping.size());
+    for (auto const& morph : model.morphNameMapping){
+        writer.writeString(morph.first);
+        writer.write<int32_t>(morph.second);
+    }
+
+    writer.write<uint32_t>((uint32_t)model.pose.size());
+    for (const SkeletonBone& bone : model.pose){
+        writer.writeString(bone.name);
+        writer.write<int32_t>(bone.nodeId);
+        writer.write<int32_t>(bone.parent);
+        writer.write<int32_t>(bone.index);
+        writeCookedVector3(writer, bone.bindPosition);
+        writer.write(bone.bindRotation.w);
+        writer.write(bone.bindRotation.x);
+        writer.write(bone.bindRotation.y);
+        writer.write(bone.bindRotation.z);
+        writeCookedVector3(writer, bone.bindScale);
+        writeCookedMatrix(writer, bone.offsetMatrix);
+    }
+
+    // animations, only tracks of model itself or its pose
+    std::vector<Entity> animations;
+    for (Entity anim : model.animations){
+        if (scene->findComponent<AnimationComponent>(anim)){
+            animations.push_back(anim);
+        }
+    }
+
+    std::vector<float> values;
+
+    writer.write<uint32_t>((uint32_t)animations.size());
+    for (Entity anim : animations){
+        AnimationComponent& animcomp = scene->getComponent<AnimationComponent>(anim);
+
+        writer.writeString(animcomp.name);
+        writer.writeString(scene->getEntityName(anim));
+        writer.write<uint8_t>(animcomp.loop);
+        writer.write<uint8_t>(animcomp.compactClip);
+        writer.write<uint8_t>(animcomp.quantizedClip);
+        writer.write(animcomp.duration);
+
+        std::vector<const ActionFrame*> frames;
+        for (const ActionFrame& frame : animcomp.actions){
+            ActionComponent* trackaction = scene->findComponent<ActionComponent>(frame.action);
+            if (!trackaction || !scene->findComponent<KeyframeTracksComponent>(frame.action)){
+                continue;
+            }
+            if (trackaction->target != entity){
+                Log::warn("Cooking model %s: skipping track '%s' that does not target model", model.filename.c_str(), scene->getEntityName(frame.action).c_str());
+                continue;
+            }
+            frames.push_back(&frame);
+        }
+
+        writer.write<uint32_t>((uint32_t)frames.size());
+        for (const ActionFrame* frame : frames){
+            Entity track = frame->action;
+            Signature signature = scene->getSignature(track);
+            ActionComponent& trackaction = scene->getComponent<ActionComponent>(track);
+            KeyframeTracksComponent& keyframe = scene->getComponent<KeyframeTracksComponent>(track);
+
+            AnimationClipTrackType type = AnimationClipTrackType::Translate;
+            uint32_t components = 0;
+            values.clear();
+
+            if (signature.test(scene->getComponentId<TranslateTracksComponent>())){
+                type = AnimationClipTrackType::Translate;
+                components = 3;
+                for (const Vector3& value : scene->getComponent<TranslateTracksComponent>(track).values){
+                    values.insert(values.end(), {value.x, value.y, value.z});
+                }
+            }else if (signature.test(scene->getComponentId<RotateTracksComponent>())){
+                type = AnimationClipTrackType::Rotate;
+                components = 4;
+                for (const Quaternion& value : scene->getComponent<RotateTracksComponent>(track).values){
+                    values.insert(values.end(), {value.w, value.x, value.y, value.z});
+                }
+            }else if (signature.test(scene->getComponentId<ScaleTracksComponent>())){
+                type = AnimationClipTrackType::Scale;
+                components = 3;
+                for (const Vector3& value : scene->getComponent<ScaleTracksComponent>(track).values){
+                    values.insert(values.end(), {value.x, value.y, value.z});
+                }
+            }else if (signature.test(scene->getComponentId<MorphTracksComponent>())){
+                type = AnimationClipTrackType::Morph;
+                MorphTracksComponent& morphtracks = scene->getComponent<MorphTracksComponent>(track);
+                components = morphtracks.values.empty() ? 0 : (uint32_t)morphtracks.values[0].size();
+                for (const std::vector<float>& value : morphtracks.values){
+                    values.insert(values.end(), value.begin(), value.end());
+                    values.resize(values.size() - value.size() + components, 0);
+                }
+            }
+
+            writer.writeString(scene->getEntityName(track));
+            writer.write(type);
+            writer.write<int32_t>(keyframe.poseBone);
+            writer.write(frame->startTime);
+            writer.write(frame->duration);
+            writer.write(trackaction.speed);
+            writer.write<uint32_t>(components);
+            writer.writeBlock(keyframe.times.data(), keyframe.times.size() * sizeof(float));
+            writer.writeBlock(values.data(), values.size() * sizeof(float));
+        }
+    }
+
+    File file;
+    if (file.open(filename.c_str(), true) != FileErrors::FILEDATA_OK){
+        Log::error("Cannot write cooked model: %s", filename.c_str());
+        return false;
+    }
+
+    const std::vector<unsigned char>& data = writer.getData();
+    unsigned int written = file.write((unsigned char*)data.data(), (unsigned int)data.size());
+    file.close();
+
+    if (written != data.size()){
+        Log::error("Cannot write cooked model: %s", filename.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// attributes must reference a cooked buffer and draw only vertices and indices inside it
+static bool isCookedSubmeshValid(const MeshComponent& mesh, const Submesh& submesh){
+    unsigned int vertices = 0;
+    bool hasVertices = false;
+    const Attribute* indexAttribute = nullptr;
+    const ExternalBuffer* indexBuffer = nullptr;
+
+    for (auto const& attr : submesh.attributes){
+        const ExternalBuffer* buffer = nullptr;
+        for (unsigned int b = 0; b < mesh.numExternalBuffers; b++){
+            if (mesh.eBuffers[b].getName() == attr.second.getBufferName()){
+                buffer = &mesh.eBuffers[b];
+                break;
+            }
+        }
+        if (!buffer || !isCookedAttributeValid(attr.first, attr.second, buffer->getStride(), attr.second.getCount(), buffer->getSize(), false)){
+            return false;
+        }
+
+        if (attr.first == AttributeType::INDEX){
+            indexAttribute = &attr.second;
+            indexBuffer = buffer;
+        }else if (attr.first == AttributeType::POSITION){
+            vertices = attr.second.getCount();
+            hasVertices = true;
+        }
+    }
+
+    // vertices of mesh level buffers (vertices and indices of a custom mesh)
+    unsigned int indices = 0;
+    bool hasIndices = false;
+    for (unsigned int b = 0; b < mesh.numExternalBuffers; b++){
+        const ExternalBuffer& buffer = mesh.eBuffers[b];
+        if (!buffer.isRenderAttributes()){
+            continue;
+        }
+        if (buffer.getType() == BufferType::INDEX_BUFFER){
+            indices = buffer.getCount();
+            hasIndices = true;
+        }else if (buffer.getType() == BufferType::VERTEX_BUFFER && !hasVertices){
+            vertices = buffer.getCount();
+            hasVertices = true;
+        }
+    }
+
+    if (indexAttribute){
+        AttributeDataType dataType = indexAttribute->getDataType();
+        if ((dataType != AttributeDataType::UNSIGNED_BYTE && dataType != AttributeDataType::UNSIGNED_SHORT && dataType != AttributeDataType::UNSIGNED_INT) ||
+            submesh.vertexCount > indexAttribute->getCount()){
+            return false;
+        }
+        if (hasVertices){
+            size_t typeSize = getCookedDataTypeSize(dataType);
+            size_t step = (indexBuffer->getStride() > 0) ? indexBuffer->getStride() : typeSize;
+            const unsigned char* data = indexBuffer->getData() + indexAttribute->getOffset();
+            for (unsigned int i = 0; i < submesh.vertexCount; i++){
+                if (getCookedIndex(data + (i * step), dataType) >= vertices){
+                    return false;
+                }
+            }
+        }
+    }else if (hasIndices){
+        if (submesh.vertexCount > indices){
+            return false;
+        }
+    }else if (hasVertices){
+        if (submesh.vertexCount > vertices){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MeshSystem::loadCookedModel(Entity entity, const std::string filename, bool asyncLoad, bool skipEntities, bool changeRootTransform){
+    MeshComponent& mesh = scene->getComponent<MeshComponent>(entity);
+    ModelComponent& model = scene->getComponent<ModelComponent>(entity);
+    Transform& transform = scene->getComponent<Transform>(entity);
+
+    destroyModel(model);
+
+    model.filename = filename;
+
+    std::string modelName;
+    uint64_t buildId = 0;
+    if (asyncLoad) {
+        std::filesystem::path filePath(filename);
+        modelName = filePath.filename().string();
+        buildId = std::hash<std::string>{}(filename);
+        ResourceProgress::startBuild(buildId, ResourceType::Model, modelName);
+    }
+
+    // read in one shot, buffers and textures use this data in place
+    model.cookedData = new Data();
+    if (model.cookedData->open(filename.c_str()) != FileErrors::FILEDATA_OK){
+        Log::error("Model file not found: %s", filename.c_str());
+        if (asyncLoad) {
+            ResourceProgress::failBuild(buildId);
+        }
+        return false;
+    }
+
+    CookedModelReader reader(model.cookedData->getMemPtr(), model.cookedData->length());
+
+    char magic[4];
+    reader.read(magic, 4);
+    uint32_t version = reader.read<uint32_t>();
+    if (reader.isFailed() || memcmp(magic, COOKEDMODEL_MAGIC, 4) != 0 || version != COOKEDMODEL_VERSION){
+        Log::error("Model %s is not a cooked model of version %i", filename.c_str(), COOKEDMODEL_VERSION);
+        if (asyncLoad) {
+            ResourceProgress::failBuild(buildId);
+        }
+        return false;
+    }
+
+    // mesh
+    Matrix4 rootMatrix = readCookedMatrix(reader);
+    if (changeRootTransform) {
+        applyModelRootMatrix(transform, rootMatrix);
+    }
+
+    mesh.vertexCount = reader.read<uint32_t>();
+    mesh.cullingMode = (CullingMode)reader.read<uint8_t>();
+    mesh.windingOrder = (WindingOrder)reader.read<uint8_t>();
+    mesh.transparent = reader.read<uint8_t>() != 0;
+    bool hasSkinning = reader.read<uint8_t>() != 0;
+    if (hasSkinning){
+        mesh.skinning->normAdjustJoint = reader.read<float>();
+        mesh.skinning->normAdjustWeight = reader.read<float>();
+    }
+    for (int i = 0; i < MAX_MORPHTARGETS; i++){
+        mesh.morphWeights[i] = reader.read<float>();
+    }
+
+    bool hasAABB = reader.read<uint8_t>() != 0;
+    Vector3 aabbMinimum = readCookedVector3(reader);
+    Vector3 aabbMaximum = readCookedVector3(reader);
+
+    // buffers
+    mesh.buffer.clear();
+    mesh.indices.clear();
+    mesh.numExternalBuffers = 0;
+
+    uint32_t numBuffers = reader.read<uint32_t>();
+    if (numBuffers > mesh.eBuffers.size()){
+        Log::error("External buffer limit reached for cooked model %s", filename.c_str());
+        if (asyncLoad) {
+            ResourceProgress::failBuild(buildId);
+        }
+        return false;
+    }
+
+    std::vector<std::pair<AttributeType, Attribute>> bufferAttributes;
+    for (uint32_t b = 0; b < numBuffers && !reader.isFailed(); b++){
+        ExternalBuffer& buffer = mesh.eBuffers[b];
+        buffer.clearAll();
+
+        std::string name = reader.readString();
+        BufferType type = (BufferType)reader.read<uint8_t>();
+        BufferUsage usage = (BufferUsage)reader.read<uint8_t>();
+        bool renderAttributes = reader.read<uint8_t>() != 0;
+        unsigned int stride = reader.read<uint32_t>();
+        unsigned int count = reader.read<uint32_t>();
+
+        bufferAttributes.clear();
+        uint32_t numAttributes = reader.read<uint32_t>();
+        for (uint32_t a = 0; a < numAttributes && !reader.isFailed(); a++){
+            Attribute attribute;
+            AttributeType attributeType = readCookedAttribute(reader, attribute);
+            bufferAttributes.push_back({attributeType, attribute});
+        }
+
+        size_t size;
+        const unsigned char* data = reader.readBlock(size);
+        if (reader.isFailed()){
+            break;
+        }
+
+        bool valid = (uint32_t)type <= (uint32_t)BufferType::STORAGE_BUFFER && (uint32_t)usage <= (uint32_t)BufferUsage::STREAM &&
+                     (uint64_t)count * stride <= size;
+        for (size_t a = 0; a < bufferAttributes.size() && valid; a++){
+            const Attribute& attribute = bufferAttributes[a].second;
+            valid = isCookedAttributeValid(bufferAttributes[a].first, attribute, stride, (attribute.getCount() > 0) ? attribute.getCount() : count, size, true);
+        }
+        if (!valid){
+            Log::error("Cooked model %s has invalid buffer '%s'", filename.c_str(), name.c_str());
+            mesh.numExternalBuffers = 0;
+            if (asyncLoad) {
+                ResourceProgress::failBuild(buildId);
+            }
+            return false;
+        }
+
+        buffer.setName(name);
+        buffer.setType(type);
+        buffer.setUsage(usage);
+        buffer.setRenderAttributes(renderAttributes);
+        buffer.setStride(stride);
+        for (auto& attr : bufferAttributes){
+            buffer.addAttribute(attr.first, attr.second);
+        }
+        buffer.setData((unsigned char*)data, size);
+        buffer.setCount(count);
+
+        mesh.numExternalBuffers++;
+    }
+
+    if (asyncLoad) {
+        ResourceProgress::updateProgress(buildId, 0.4f); // Buffers mapped
+    }
+
+    // submeshes
+    mesh.numSubmeshes = reader.read<uint32_t>();
+    if (mesh.numSubmeshes > mesh.submeshes.size()){
+        Log::error("Model %s has more submeshes than the maximum allowed (%i)", filename.c_str(), mesh.submeshes.size());
+        mesh.numSubmeshes = 0;
+        if (asyncLoad) {
+            ResourceProgress::failBuild(buildId);
+        }
+        return false;
+    }
+
+    for (unsigned int i = 0; i < mesh.numSubmeshes && !reader.isFailed(); i++){
+        Submesh& submesh = mesh.submeshes[i];
+
+        submesh.primitiveType = (PrimitiveType)reader.read<uint8_t>();
+        submesh.faceCulling = reader.read<uint8_t>() != 0;
+        submesh.textureShadow = reader.read<uint8_t>() != 0;
+        submesh.hasTextureRect = reader.read<uint8_t>() != 0;
+        float rectX = reader.read<float>();
+        float rectY = reader.read<float>();
+        float rectWidth = reader.read<float>();
+        float rectHeight = reader.read<float>();
+        submesh.textureRect = Rect(rectX, rectY, rectWidth, rectHeight);
+        submesh.vertexCount = reader.read<uint32_t>();
+
+        Material& material = submesh.material;
+        material.name = reader.readString();
+        float r = reader.read<float>();
+        float g = reader.read<float>();
+        float bl = reader.read<float>();
+        float a = reader.read<float>();
+        material.baseColorFactor = Vector4(r, g, bl, a);
+        material.metallicFactor = reader.read<float>();
+        material.roughnessFactor = reader.read<float>();
+        material.emissiveFactor = readCookedVector3(reader);
+
+        bool valid = readCookedTexture(reader, material.baseColorTexture);
+        valid = readCookedTexture(reader, material.emissiveTexture) && valid;
+        valid = readCookedTexture(reader, material.metallicRoughnessTexture) && valid;
+        valid = readCookedTexture(reader, material.occlusionTexture) && valid;
+        valid = readCookedTexture(reader, material.normalTexture) && valid;
+
+        submesh.attributes.clear();
+        uint32_t numAttributes = reader.read<uint32_t>();
+        for (uint32_t at = 0; at < numAttributes && !reader.isFailed(); at++){
+            Attribute attribute;
+            AttributeType type = readCookedAttribute(reader, attribute);
+            submesh.attributes[type] = attribute;
+        }
+
+        if (reader.isFailed()){
+            break;
+        }
+
+        valid = valid && (uint32_t)submesh.primitiveType <= (uint32_t)PrimitiveType::LINES && isCookedSubmeshValid(mesh, submesh);
+        if (!valid){
+            Log::error("Cooked model %s has invalid submesh %u", filename.c_str(), i);
+            mesh.numSubmeshes = 0;
+            if (asyncLoad) {
+                ResourceProgress::failBuild(buildId);
+            }
+            return false;
+        }
+    }
+
+    if (asyncLoad) {
+        ResourceProgress::updateProgress(buildId, 0.7f); // Submeshes processed
+    }
+
+    // morph names and skeleton
+    model.morphNameMapping.clear();
+    uint32_t numMorphs = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < numMorphs && !reader.isFailed(); i++){
+        std::string name = reader.readString();
+        model.morphNameMapping[name] = reader.read<int32_t>();
+    }
+
+    model.pose.clear();
+    uint32_t numBones = reader.read<uint32_t>();
+    for (uint32_t i = 0; i < numBones && !reader.isFailed(); i++){
+        SkeletonBone bone;
+        bone.name = reader.readString();
+        bone.nodeId = reader.read<int32_t>();
+        bone.parent = reader.read<int32_t>();
+        bone.index = reader.read<int32_t>();
+        bone.bindPosition = readCookedVector3(reader);
+        float w = reader.read<float>();
+        float x = reader.read<float>();
+        float y = reader.read<float>();
+        float z = reader.read<float>();
+        bone.bindRotation = Quaternion(w, x, y, z);
+        bone.bindScale = readCookedVector3(reader);
+        bone.offsetMatrix = readCookedMatrix(reader);
+
+        if (bone.parent >= (int)i){
+            Log::error("Cooked model %s has bone '%s' before its parent", filename.c_str(), bone.name.c_str());
+            model.pose.clear();
+            if (asyncLoad) {
+                ResourceProgress::failBuild(buildId);
+            }
+            return false;
+        }
+
+        bone.position = bone.bindPosition;
+        bone.rotation = bone.bindRotation;
+        bone.scale = bone.bindScale;
+
+        auto it = model.bonesIdMapping.find(bone.nodeId);
+        if (it != model.bonesIdMapping.end()){
+            bone.entity = it->second;
+        }
+
+        model.pose.push_back(bone);
+    }
+
+    if (!model.pose.empty()){
+        model.compactSkeleton = true;
+        model.skeleton = NULL_ENTITY;
+        model.needUpdatePose = true;
+    }
+
+    // animations
+    uint32_t numAnimations = reader.read<uint32_t>();
+
+    if (!skipEntities && !reader.isFailed()) {
+        model.animations.clear();
+
+        for (uint32_t i = 0; i < numAnimations && !reader.isFailed(); i++){
+            Entity anim = scene->createEntity();
+            scene->addComponent<ActionComponent>(anim);
+            scene->addComponent<AnimationComponent>(anim);
+
+            AnimationComponent& animcomp = scene->getComponent<AnimationComponent>(anim);
+
+            animcomp.name = reader.readString();
+            scene->setEntityName(anim, reader.readString());
+            animcomp.loop = reader.read<uint8_t>() != 0;
+            animcomp.compactClip = reader.read<uint8_t>() != 0;
+            animcomp.quantizedClip = reader.read<uint8_t>() != 0;
+            animcomp.duration = reader.read<float>();
+
+            model.animations.push_back(anim);
+
+            uint32_t numTracks = reader.read<uint32_t>();
+            for (uint32_t t = 0; t < numTracks && !reader.isFailed(); t++){
+                std::string trackName = reader.readString();
+                AnimationClipTrackType type = reader.read<AnimationClipTrackType>();
+                int poseBone = reader.read<int32_t>();
+                float startTime = reader.read<float>();
+                float duration = reader.read<float>();
+                float speed = reader.read<float>();
+                uint32_t components = reader.read<uint32_t>();
+
+                size_t timesSize;
+                size_t valuesSize;
+                const float* times = (const float*)reader.readBlock(timesSize);
+                const float* values = (const float*)reader.readBlock(valuesSize);
+                size_t keys = timesSize / sizeof(float);
+
+                if (reader.isFailed() || (valuesSize / sizeof(float)) != keys * components){
+                    Log::error("Cannot load animation track '%s' of cooked model %s", trackName.c_str(), filename.c_str());
+                    continue;
+                }
+
+                Entity track = scene->createEntity();
+                scene->setEntityName(track, trackName);
+
+                scene->addComponent<ActionComponent>(track);
+                scene->addComponent<KeyframeTracksComponent>(track);
+
+                KeyframeTracksComponent& keyframe = scene->getComponent<KeyframeTracksComponent>(track);
+                keyframe.times.assign(times, times + keys);
+                keyframe.poseBone = poseBone;
+
+                if (type == AnimationClipTrackType::Translate){
+                    scene->addComponent<TranslateTracksComponent>(track);
+                    TranslateTracksComponent& translatetracks = scene->getComponent<TranslateTracksComponent>(track);
+                    for (size_t c = 0; c < keys; c++){
+                        translatetracks.values.push_back(Vector3(values[3 * c], values[(3 * c) + 1], values[(3 * c) + 2]));
+                    }
+                }else if (type == AnimationClipTrackType::Rotate){
+                    scene->addComponent<RotateTracksComponent>(track);
+                    RotateTracksComponent& rotatetracks = scene->getComponent<RotateTracksComponent>(track);
+                    for (size_t c = 0; c < keys; c++){
+                        rotatetracks.values.push_back(Quaternion(values[4 * c], values[(4 * c) + 1], values[(4 * c) + 2], values[(4 * c) + 3]));
+                    }
+                }else if (type == AnimationClipTrackType::Scale){
+                    scene->addComponent<ScaleTracksComponent>(track);
+                    ScaleTracksComponent& scaletracks = scene->getComponent<ScaleTracksComponent>(track);
+                    for (size_t c = 0; c < keys; c++){
+                        scaletracks.values.push_back(Vector3(values[3 * c], values[(3 * c) + 1], values[(3 * c) + 2]));
+                    }
+                }else{
+                    scene->addComponent<MorphTracksComponent>(track);
+                    MorphTracksComponent& morphtracks = scene->getComponent<MorphTracksComponent>(track);
+                    for (size_t c = 0; c < keys; c++){
+                        morphtracks.values.push_back(std::vector<float>(values + (components * c), values + (components * (c + 1))));
+                    }
+                }
+
+                ActionComponent& actiontrack = scene->getComponent<ActionComponent>(track);
+                actiontrack.target = entity;
+                actiontrack.speed = speed;
+
+                // need to get here because other components were created
+                scene->getComponent<AnimationComponent>(anim).actions.push_back({startTime, duration, track});
+            }
+
+            ActionComponent& anim_actioncomp = scene->getComponent<ActionComponent>(anim);
+            anim_actioncomp.target = entity;
+        }
+    }
+
+    if (reader.isFailed()){
+        Log::error("Cooked model %s is corrupted", filename.c_str());
+        if (asyncLoad) {
+            ResourceProgress::failBuild(buildId);
+        }
+        return false;
+    }
+
+    if (hasAABB){
+        mesh.verticesAABB = AABB(aabbMinimum, aabbMaximum);
+        mesh.aabb = mesh.verticesAABB;
+        mesh.needUpdateAABB = true;
+    }else{
+        calculateMeshAABB(mesh);
+    }
+
+    if (mesh.loaded)
+        mesh.needReload = true;
+
+    if (asyncLoad) {
+        ResourceProgress::updateProgress(buildId, 1.0f); // Complete
+        ResourceProgress::completeBuild(buildId);
+    }
+
+    return true;
+}
+
 void MeshSystem::createInstancedMesh(Entity entity){
     Signature signature = scene->getSignature(entity);
 
@@ -2696,6 +3840,7 @@ void MeshSystem::clearBoneMapping(ModelComponent& model){
     model.bonesIdMapping.clear();
     model.bonesNameMapping.clear();
 
+    model.pose.clear();
     model.skeleton = NULL_ENTITY;
 }
 
@@ -2711,6 +3856,10 @@ void MeshSystem::destroyModel(ModelComponent& model){
         delete model.gltfModel;
         model.gltfModel = NULL;
     }
+    if (model.cookedData){
+        delete model.cookedData;
+        model.cookedData = NULL;
+    }
 
     model.morphNameMapping.clear();
 
@@ -2731,6 +3880,68 @@ void MeshSystem::resetModelToBindPose(ModelComponent& model){
         transform->scale = boneComp->bindScale;
         transform->needUpdate = true;
     }
+
+    for (SkeletonBone& bone : model.pose){
+        bone.position = bone.bindPosition;
+        bone.rotation = bone.bindRotation;
+        bone.scale = bone.bindScale;
+    }
+    if (!model.pose.empty()){
+        model.needUpdatePose = true;
+    }
+}
+
+Entity MeshSystem::createSkeletonBoneEntity(Entity entity, ModelComponent& model, int bone){
+    if (bone < 0 || bone >= (int)model.pose.size()){
+        Log::error("Cannot create entity of non-existent skeleton bone: %i", bone);
+        return NULL_ENTITY;
+    }
+
+    SkeletonBone& skeletonBone = model.pose[bone];
+
+    if (skeletonBone.entity == NULL_ENTITY){
+        Entity boneEntity = scene->createEntity();
+        scene->addComponent<Transform>(boneEntity);
+        scene->setEntityName(boneEntity, skeletonBone.name);
+
+        // flat child of model, transform is copied from pose
+        scene->addEntityChild(entity, boneEntity, false);
+
+        skeletonBone.entity = boneEntity;
+
+        model.bonesNameMapping[skeletonBone.name] = boneEntity;
+        model.bonesIdMapping[skeletonBone.nodeId] = boneEntity;
+
+        model.needUpdatePose = true;
+    }
+
+    return skeletonBone.entity;
+}
+
+void MeshSystem::updateSkeletonPose(ModelComponent& model, MeshComponent& mesh){
+    for (size_t i = 0; i < model.pose.size(); i++){
+        SkeletonBone& bone = model.pose[i];
+
+        Matrix4 localMatrix = Matrix4::composeMatrix(bone.position, bone.rotation, bone.scale);
+        if (bone.parent >= 0){
+            bone.modelMatrix = model.pose[bone.parent].modelMatrix * localMatrix;
+        }else{
+            bone.modelMatrix = localMatrix;
+        }
+
+        if (bone.index >= 0 && bone.index < MAX_BONES)
+            mesh.skinning->bonesMatrix[bone.index] = bone.modelMatrix * bone.offsetMatrix;
+
+        if (bone.entity != NULL_ENTITY){
+            Transform* transform = scene->findComponent<Transform>(bone.entity);
+            if (transform){
+                bone.modelMatrix.decompose(transform->position, transform->scale, transform->rotation);
+                transform->needUpdate = true;
+            }
+        }
+    }
+
+    model.needUpdatePose = false;
 }
 
 bool MeshSystem::createOrUpdateSprite(SpriteComponent& sprite, MeshComponent& mesh){
@@ -2799,6 +4010,9 @@ bool MeshSystem::createOrUpdateMeshPolygon(MeshPolygonComponent& polygon, MeshCo
 }
 
 bool MeshSystem::createOrUpdateTilemap(TilemapComponent& tilemap, MeshComponent& mesh){
+    if (!tilemap.needUpdateTilemap && !tilemap.changedTiles.empty()){
+        updateTilemapChunks(tilemap, mesh);
+    }
     if (tilemap.needUpdateTilemap){
         if (tilemap.automaticFlipY){
             CameraComponent& camera =  scene->getComponent<CameraComponent>(scene->getCamera());
@@ -2818,11 +4032,19 @@ bool MeshSystem::createOrUpdateTilemap(TilemapComponent& tilemap, MeshComponent&
 bool MeshSystem::createOrUpdateModel(Entity entity, ModelComponent& model, MeshComponent& mesh){
     if (model.needUpdateModel){
         if (!model.filename.empty()){
+            // skeleton mode changed: bones and tracks of the other mode are rebuilt from file
+            if ((model.compactSkeleton && model.skeleton != NULL_ENTITY) || (!model.compactSkeleton && !model.pose.empty())){
+                clearBoneMapping(model);
+                clearAnimationMapping(model);
+            }
+
             std::string ext = FileData::getFilePathExtension(model.filename);
-            bool skipEntities = !model.filename.empty() && (!model.bonesIdMapping.empty() || !model.animations.empty());
+            bool skipEntities = !model.filename.empty() && ((!model.compactSkeleton && !model.bonesIdMapping.empty()) || !model.animations.empty());
             bool ret = false;
             if (ext == "obj"){
                 ret = loadOBJ(entity, model.filename, false);
+            }else if (ext == "dmodel"){
+                ret = loadCookedModel(entity, model.filename, false, skipEntities, false);
             }else{
                 ret = loadGLTF(entity, model.filename, false, skipEntities, false);
             }
@@ -2920,6 +4142,10 @@ void MeshSystem::update(double dt){
             MeshComponent& mesh = scene->getComponent<MeshComponent>(entity);
 
             createOrUpdateModel(entity, model, mesh);
+
+            if (model.needUpdatePose){
+                updateSkeletonPose(model, mesh);
+            }
         }
     }
 
@@ -15,6 +15,7 @@
 #include "component/CameraComponent.h"
 #include "component/TerrainComponent.h"
 #include "component/TilemapComponent.h"
+#include "component/Transform.h"
 
 namespace doriax{
 
@@ -24,9 +25,15 @@ namespace doriax{
         bool createSprite(SpriteComponent& sprite, MeshComponent& mesh, CameraComponent& camera);
         bool createMeshPolygon(MeshPolygonComponent& polygon, MeshComponent& mesh);
         bool createTilemap(TilemapComponent& tilemap, MeshComponent& mesh);
+        bool updateTilemapChunks(TilemapComponent& tilemap, MeshComponent& mesh);
 
         void changeFlipY(bool& flipY, CameraComponent& camera, MeshComponent& mesh);
         Rect normalizeTileRect(Rect tileRect, unsigned int texWidth, unsigned int texHeight);
+        bool isTilemapTextureLoading(TilemapComponent& tilemap, MeshComponent& mesh, unsigned int index);
+        int getTilemapTileVertices(TilemapComponent& tilemap, MeshComponent& mesh, unsigned int index, Vector3* positions, Vector2* texcoords);
+        void setTilemapTileChunk(TilemapComponent& tilemap, unsigned int index);
+        void updateTilemapChunkBounds(TilemapComponent& tilemap, TilemapChunk& chunk);
+        void updateTilemapBounds(TilemapComponent& tilemap, MeshComponent& mesh);
 
         // Mesh aux
         std::vector<float> getCylinderSideNormals(float baseRadius, float topRadius, float height, float slices);
@@ -43,15 +50,19 @@ namespace doriax{
         std::string getBufferName(int bufferViewIndex, ModelComponent& model);
         Matrix4 getGLTFNodeMatrix(int nodeIndex, ModelComponent& model);
         Matrix4 getGLTFMeshGlobalMatrix(int nodeIndex, ModelComponent& model, std::map<int, int>& nodesParent);
+        int getGLTFMeshNode(int meshIndex, ModelComponent& model, std::map<int, int>& nodesParent);
+        void applyModelRootMatrix(Transform& transform, const Matrix4& matrix);
+        bool getGLTFInverseBindMatrix(ModelComponent& model, int skinIndex, int jointIndex, Matrix4& matrix);
+        int getGLTFJointIndex(ModelComponent& model, int nodeIndex, int skinIndex);
         Entity generateSketetalStructure(Entity entity, ModelComponent& model, int nodeIndex, int skinIndex);
+        bool generateSkeletonPose(ModelComponent& model, int nodeIndex, int skinIndex, int parent);
         TextureFilter convertFilter(int filter);
         TextureWrap convertWrap(int wrap);
 
         // Terrain
         size_t getTerrainGridArraySize(int rootGridSize, int levels);
-        float getTerrainHeight(TerrainComponent& terrain, float x, float y);
-        float maxTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h);
-        float minTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h);
+        bool buildTerrainHeightPyramid(TerrainComponent& terrain);
+        void getTerrainHeightArea(TerrainComponent& terrain, float x, float z, float w, float h, float& minHeight, float& maxHeight);
         void createPlaneNodeSubmesh(unsigned int submeshIndex, TerrainComponent& terrain, MeshComponent& mesh, int width, int height, int widthSegments, int heightSegments);
         bool createTerrain(TerrainComponent& terrain, MeshComponent& mesh);
         void createTerrainNode(TerrainComponent& terrain, float x, float y, float size, int lodDepth);
@@ -68,6 +79,8 @@ namespace doriax{
         void createTorus(MeshComponent& mesh, float radius=1, float ringRadius=0.5, unsigned int sides=36, unsigned int rings=16);
         bool loadGLTF(Entity entity, const std::string filename, bool asyncLoad=false, bool skipEntities=false, bool changeRootTransform=true);
         bool loadOBJ(Entity entity, const std::string filename, bool asyncLoad=false);
+        bool loadCookedModel(Entity entity, const std::string filename, bool asyncLoad=false, bool skipEntities=false, bool changeRootTransform=true);
+        bool cookModel(Entity entity, const std::string& filename);
 
         void createInstancedMesh(Entity entity);
         void removeInstancedMesh(Entity entity);
@@ -79,6 +92,9 @@ namespace doriax{
 
         void resetModelToBindPose(ModelComponent& model);
 
+        Entity createSkeletonBoneEntity(Entity entity, ModelComponent& model, int bone);
+        void updateSkeletonPose(ModelComponent& model, MeshComponent& mesh);
+
         bool createOrUpdateSprite(SpriteComponent& sprite, MeshComponent& mesh);
         bool createOrUpdateTerrain(TerrainComponent& terrain, MeshComponent& mesh);
         bool createOrUpdateMeshPolygon(MeshPolygonComponent& polygon, MeshComponent& mesh);
@@ -4,12 +4,14 @@
 
 #include "PhysicsSystem.h"
 #include "Scene.h"
+#include "subsystem/RenderSystem.h"
 #include "util/Angle.h"
 
 #include "util/Box2DAux.h"
 #include "util/JoltPhysicsAux.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <map>
 
@@ -22,16 +24,16 @@ PhysicsSystem::PhysicsSystem(Scene* scene): SubSystem(scene){
 
 	this->scene = scene;
 
+    this->bodies2DView = scene->getView<Body2DComponent>();
+    this->bodies3DView = scene->getView<Body3DComponent>();
+
     this->gravity = Vector3(0, -9.81f, 0);
     this->pointsToMeterScale2D = 64.0;
 
-    b2WorldDef worldDef = b2DefaultWorldDef();
-    worldDef.gravity = {this->gravity.x, this->gravity.y};
-    world2D = b2CreateWorld(&worldDef);
-
-    b2World_SetPreSolveCallback(world2D, Box2DAux::PreSolve, scene);
-    // TODO: could there be a performance issue by checking this often?
-    b2World_SetCustomFilterCallback(world2D, Box2DAux::CollisionFilter, scene);
+    workerCount2D = 0;
+    taskScheduler2D = nullptr;
+    world2D = b2_nullWorldId;
+    createWorld2D();
 
     // https://github.com/jrouwe/JoltPhysics/issues/244
     JPH::RegisterDefaultAllocator();
@@ -46,39 +48,44 @@ PhysicsSystem::PhysicsSystem(Scene* scene): SubSystem(scene){
     // Register all Jolt physics types
     JPH::RegisterTypes();
 
-    const unsigned int cMaxBodies = 1024;
-    const unsigned int cNumBodyMutexes = 0;
-    const unsigned int cMaxBodyPairs = 1024;
-    const unsigned int cMaxContactConstraints = 1024;
+    maxBodies3D = 1024;
+    maxBodyPairs3D = 1024;
+    maxContactConstraints3D = 1024;
+    reportedStepErrors = 0;
+    lastStepTime3D = 0;
+    peakStepTime3D = 0;
 
     broad_phase_layer_interface = new JPH::BroadPhaseLayerInterfaceMask(MAX_BROADPHASELAYER_3D);
     object_vs_broadphase_layer_filter = new JPH::ObjectVsBroadPhaseLayerFilterMask(*broad_phase_layer_interface);
     object_vs_object_layer_filter = new JPH::ObjectLayerPairFilterMask();
 
-    // Now we can create the actual physics system.
-    world3D.Init(cMaxBodies, cNumBodyMutexes, cMaxBodyPairs, cMaxContactConstraints, *broad_phase_layer_interface, *object_vs_broadphase_layer_filter, *object_vs_object_layer_filter);
-    world3D.SetGravity(JPH::Vec3(this->gravity.x, this->gravity.y, this->gravity.z));
-
-    temp_allocator = new JPH::TempAllocatorImpl(10 * 1024 * 1024);
-    job_system = new JPH::JobSystemThreadPool (JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, JPH::thread::hardware_concurrency() - 1);
+    temp_allocator = new JoltTempAllocator(10 * 1024 * 1024);
+    job_system = new JoltJobSystem(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 
     activationListener3D = new JoltActivationListener(scene, this);
-    world3D.SetBodyActivationListener(activationListener3D);
-
     contactListener3D = new JoltContactListener(scene, this);
-    world3D.SetContactListener(contactListener3D);
+
+    world3D = nullptr;
+    createWorld3D();
 
     lock3DBodies = true;
+
+    fixedTimeStep = 0;
+    stepAccumulator = 0;
+    stepCount = 0;
+    interpolation = PhysicsInterpolation::INTERPOLATE;
 }
 
 PhysicsSystem::~PhysicsSystem(){
     b2DestroyWorld(world2D);
     world2D = b2_nullWorldId;
+    delete taskScheduler2D;
+
+    delete world3D;
 
     delete activationListener3D;
     delete contactListener3D;
 
-    //delete world3D;
     delete temp_allocator;
     delete job_system;
     delete broad_phase_layer_interface;
@@ -97,7 +104,7 @@ void PhysicsSystem::setGravity(Vector3 gravity){
     if (this->gravity != gravity){
         this->gravity = gravity;
         b2World_SetGravity(world2D, {gravity.x, gravity.y});
-        world3D.SetGravity(JPH::Vec3(gravity.x, gravity.y, gravity.z));
+        world3D->SetGravity(JPH::Vec3(gravity.x, gravity.y, gravity.z));
     }
 }
 
@@ -126,11 +133,362 @@ bool PhysicsSystem::isLock3DBodies() const{
     return this->lock3DBodies;
 }
 
+void PhysicsSystem::setFixedTimeStep(float fixedTimeStep){
+    if (fixedTimeStep < 0){
+        fixedTimeStep = 0;
+    }
+    if (this->fixedTimeStep != fixedTimeStep){
+        this->fixedTimeStep = fixedTimeStep;
+        this->stepAccumulator = 0;
+    }
+}
+
+float PhysicsSystem::getFixedTimeStep() const{
+    return this->fixedTimeStep;
+}
+
+void PhysicsSystem::setInterpolation(PhysicsInterpolation interpolation){
+    this->interpolation = interpolation;
+}
+
+PhysicsInterpolation PhysicsSystem::getInterpolation() const{
+    return this->interpolation;
+}
+
+float PhysicsSystem::getInterpolationAlpha() const{
+    if (fixedTimeStep <= 0){
+        return 0;
+    }
+    return stepAccumulator / fixedTimeStep;
+}
+
+void PhysicsSystem::setContactFilter3D(ContactFilter3D contactFilter3D){
+    this->contactFilter3D = contactFilter3D;
+}
+
+const ContactFilter3D& PhysicsSystem::getContactFilter3D() const{
+    return contactFilter3D;
+}
+
+void PhysicsSystem::createWorld2D(){
+    if (b2World_IsValid(world2D)){
+        b2DestroyWorld(world2D);
+    }
+    delete taskScheduler2D;
+
+    int workers = workerCount2D;
+    #ifndef NO_THREAD_SUPPORT
+    if (workers <= 0){
+        workers = (int)ThreadPoolManager::getInstance().getNumThreads() + 1;
+    }
+    #else
+    workers = 1;
+    #endif
+    taskScheduler2D = new Box2DTaskScheduler(workers);
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = {gravity.x, gravity.y};
+    if (taskScheduler2D->getWorkerCount() > 1){
+        worldDef.workerCount = taskScheduler2D->getWorkerCount();
+        worldDef.enqueueTask = Box2DTaskScheduler::enqueueTask;
+        worldDef.finishTask = Box2DTaskScheduler::finishTask;
+        worldDef.userTaskContext = taskScheduler2D;
+    }
+    world2D = b2CreateWorld(&worldDef);
+
+    customFilter2D = false;
+    preSolveCallback2D = false;
+}
+
+// category and mask bits are checked by Box2D itself, scripted callbacks are only installed when used
+void PhysicsSystem::updateCallbacks2D(){
+    bool customFilter = shouldCollide2D.size() > 0;
+    if (customFilter != customFilter2D){
+        b2World_SetCustomFilterCallback(world2D, customFilter ? Box2DAux::CollisionFilter : nullptr, scene);
+        customFilter2D = customFilter;
+    }
+
+    bool preSolveCallback = preSolve2D.size() > 0;
+    if (preSolveCallback != preSolveCallback2D){
+        b2World_SetPreSolveCallback(world2D, preSolveCallback ? Box2DAux::PreSolve : nullptr, scene);
+        preSolveCallback2D = preSolveCallback;
+    }
+
+    // scripted callbacks are not thread safe, they run inside the step
+    taskScheduler2D->setMainThreadOnly(customFilter || preSolveCallback);
+}
+
+void PhysicsSystem::setWorkerCount2D(int workerCount2D){
+    if (this->workerCount2D == workerCount2D){
+        return;
+    }
+    if (b2World_GetCounters(world2D).bodyCount > 0){
+        Log::error("2D physics worker count can only be changed before creating 2D bodies");
+        return;
+    }
+    this->workerCount2D = workerCount2D;
+    createWorld2D();
+}
+
+int PhysicsSystem::getWorkerCount2D() const{
+    return workerCount2D;
+}
+
+void PhysicsSystem::createWorld3D(){
+    delete world3D;
+
+    world3D = new JPH::PhysicsSystem();
+    world3D->Init(maxBodies3D, 0, maxBodyPairs3D, maxContactConstraints3D, *broad_phase_layer_interface, *object_vs_broadphase_layer_filter, *object_vs_object_layer_filter);
+    world3D->SetGravity(JPH::Vec3(gravity.x, gravity.y, gravity.z));
+    world3D->SetBodyActivationListener(activationListener3D);
+    world3D->SetContactListener(contactListener3D);
+
+    reportedStepErrors = 0;
+}
+
+bool PhysicsSystem::canResizeWorld3D() const{
+    if (world3D->GetNumBodies() > 0){
+        Log::error("3D physics capacities can only be changed before creating 3D bodies");
+        return false;
+    }
+    return true;
+}
+
+void PhysicsSystem::setMaxBodies3D(uint32_t maxBodies3D){
+    if (this->maxBodies3D != maxBodies3D && canResizeWorld3D()){
+        this->maxBodies3D = maxBodies3D;
+        createWorld3D();
+    }
+}
+
+uint32_t PhysicsSystem::getMaxBodies3D() const{
+    return maxBodies3D;
+}
+
+void PhysicsSystem::setMaxBodyPairs3D(uint32_t maxBodyPairs3D){
+    if (this->maxBodyPairs3D != maxBodyPairs3D && canResizeWorld3D()){
+        this->maxBodyPairs3D = maxBodyPairs3D;
+        createWorld3D();
+    }
+}
+
+uint32_t PhysicsSystem::getMaxBodyPairs3D() const{
+    return maxBodyPairs3D;
+}
+
+void PhysicsSystem::setMaxContactConstraints3D(uint32_t maxContactConstraints3D){
+    if (this->maxContactConstraints3D != maxContactConstraints3D && canResizeWorld3D()){
+        this->maxContactConstraints3D = maxContactConstraints3D;
+        createWorld3D();
+    }
+}
+
+uint32_t PhysicsSystem::getMaxContactConstraints3D() const{
+    return maxContactConstraints3D;
+}
+
+void PhysicsSystem::setTempAllocatorSize3D(size_t size){
+    temp_allocator->resize(size);
+}
+
+size_t PhysicsSystem::getTempAllocatorSize3D() const{
+    return temp_allocator->getSize();
+}
+
+PhysicsStats3D PhysicsSystem::getStats3D() const{
+    PhysicsStats3D stats;
+
+    stats.numBodies = world3D->GetNumBodies();
+    stats.numActiveBodies = world3D->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    stats.maxBodies = world3D->GetMaxBodies();
+    stats.maxBodyPairs = maxBodyPairs3D;
+    stats.maxContactConstraints = maxContactConstraints3D;
+    stats.lastStepTime = lastStepTime3D;
+    stats.peakStepTime = peakStepTime3D;
+    stats.tempAllocatorSize = temp_allocator->getSize();
+    stats.tempAllocatorPeak = temp_allocator->getPeakUsage();
+    stats.tempFallbackAllocations = temp_allocator->getFallbackAllocations();
+    stats.stepErrors = reportedStepErrors;
+
+    return stats;
+}
+
+void PhysicsSystem::resetStats3D(){
+    peakStepTime3D = 0;
+    temp_allocator->resetPeak();
+}
+
+void PhysicsSystem::update3DWorld(float stepTime){
+    const int cCollisionSteps = 1;
+
+    // scripted filters are not thread safe, they run inside the step
+    job_system->setMainThreadOnly(shouldCollide3D.size() > 0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    JPH::EPhysicsUpdateError errors = world3D->Update(stepTime, cCollisionSteps, temp_allocator, job_system);
+
+    lastStepTime3D = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    peakStepTime3D = std::max(peakStepTime3D, lastStepTime3D);
+
+    // warns once for each kind of overflow
+    uint32_t newErrors = (uint32_t)errors & ~reportedStepErrors;
+    if (newErrors & (uint32_t)JPH::EPhysicsUpdateError::ManifoldCacheFull){
+        Log::warn("3D physics manifold cache is full (%u), increase maxContactConstraints3D", maxContactConstraints3D);
+    }
+    if (newErrors & (uint32_t)JPH::EPhysicsUpdateError::BodyPairCacheFull){
+        Log::warn("3D physics body pair cache is full (%u), increase maxBodyPairs3D", maxBodyPairs3D);
+    }
+    if (newErrors & (uint32_t)JPH::EPhysicsUpdateError::ContactConstraintsFull){
+        Log::warn("3D physics contact constraints are full (%u), increase maxContactConstraints3D", maxContactConstraints3D);
+    }
+    reportedStepErrors |= (uint32_t)errors;
+
+    temp_allocator->fitToPeak();
+
+    contactListener3D->dispatchEvents();
+    activationListener3D->dispatchEvents(deactivatedBodies3D);
+}
+
+bool PhysicsSystem::isInterpolating() const{
+    return fixedTimeStep > 0 && interpolation != PhysicsInterpolation::NONE;
+}
+
+bool PhysicsSystem::isTransformFromPose(Entity entity, const Transform& transform){
+    if (!isInterpolating()){
+        return false;
+    }
+
+    BodyPose* pose = bodyPoses.findComponent(entity);
+
+    return pose && pose->written && transform.position == pose->writtenPosition && transform.rotation == pose->writtenRotation;
+}
+
+void PhysicsSystem::resetBodyPose(Entity entity, const Vector3& position, const Quaternion& rotation){
+    BodyPose* pose = bodyPoses.findComponent(entity);
+    if (!pose){
+        bodyPoses.insert(entity, BodyPose());
+        pose = bodyPoses.findComponent(entity);
+    }
+
+    pose->previousPosition = position;
+    pose->previousRotation = rotation;
+    pose->currentPosition = position;
+    pose->currentRotation = rotation;
+    pose->step = stepCount;
+    pose->written = false;
+}
+
+void PhysicsSystem::recordBodyPose(Entity entity, const Vector3& position, const Quaternion& rotation){
+    BodyPose* pose = bodyPoses.findComponent(entity);
+    if (!pose){
+        resetBodyPose(entity, position, rotation);
+        return;
+    }
+
+    // body did not move since its last recorded step, so current is also the pose of the step before this one
+    pose->previousPosition = pose->currentPosition;
+    pose->previousRotation = pose->currentRotation;
+    pose->currentPosition = position;
+    pose->currentRotation = rotation;
+    pose->step = stepCount;
+}
+
+void PhysicsSystem::collectMoved3DBodies(){
+    movedBodies3D.clear();
+
+    uint32_t numActive = world3D->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    const JPH::BodyID* activeBodies = world3D->GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+    movedBodies3D.insert(movedBodies3D.end(), activeBodies, activeBodies + numActive);
+
+    // fell asleep during the step, last pose is not in active list
+    JPH::BodyInterface &body_interface = world3D->GetBodyInterfaceNoLock();
+    for (const JPH::BodyID& bodyID : deactivatedBodies3D){
+        if (body_interface.IsAdded(bodyID)){
+            movedBodies3D.push_back(bodyID);
+        }
+    }
+    deactivatedBodies3D.clear();
+}
+
+void PhysicsSystem::read3DBodyPoses(){
+    JPH::BodyInterface &body_interface = world3D->GetBodyInterfaceNoLock();
+
+    for (const JPH::BodyID& bodyID : movedBodies3D){
+        JPH::RVec3 position;
+        JPH::Quat rotation;
+        body_interface.GetPositionAndRotation(bodyID, position, rotation);
+
+        if (!std::isnan(position.GetX()) && !std::isnan(position.GetY()) && !std::isnan(position.GetZ())){
+            recordBodyPose((Entity)body_interface.GetUserData(bodyID),
+                Vector3(position.GetX(), position.GetY(), position.GetZ()),
+                Quaternion(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ()));
+        }
+    }
+}
+
+void PhysicsSystem::applyBodyPoses(){
+    float alpha = getInterpolationAlpha();
+
+    for (size_t i = 0; i < bodyPoses.size(); i++){
+        BodyPose& pose = bodyPoses.getComponentFromIndex(i);
+        Transform* transform = scene->findComponent<Transform>(bodyPoses.getEntity(i));
+
+        if (!transform){
+            continue;
+        }
+
+        Vector3 position = pose.currentPosition;
+        Quaternion rotation = pose.currentRotation;
+
+        // bodies that did not move in last step stay at current pose
+        if (pose.step == stepCount){
+            if (interpolation == PhysicsInterpolation::INTERPOLATE){
+                position = pose.previousPosition + (pose.currentPosition - pose.previousPosition) * alpha;
+                rotation = Quaternion::nlerp(alpha, pose.previousRotation, pose.currentRotation, true);
+            }else if (interpolation == PhysicsInterpolation::EXTRAPOLATE){
+                position = pose.currentPosition + (pose.currentPosition - pose.previousPosition) * alpha;
+                rotation = Quaternion::nlerp(1.0f + alpha, pose.previousRotation, pose.currentRotation, true);
+            }
+        }
+
+        applyBodyTransform(*transform, position, rotation);
+
+        pose.writtenPosition = transform->position;
+        pose.writtenRotation = transform->rotation;
+        pose.written = true;
+    }
+}
+
+void PhysicsSystem::applyBodyTransform(Transform& transform, Vector3 position, Quaternion rotation){
+    if (transform.parent != NULL_ENTITY){
+        Transform& transformParent = scene->getComponent<Transform>(transform.parent);
+
+        position = transformParent.modelMatrix.inverse() * position;
+        rotation = transformParent.worldRotation.inverse() * rotation;
+    }
+
+    if (transform.position != position){
+        transform.position = position;
+        transform.needUpdate = true;
+    }
+
+    if (transform.rotation != rotation){
+        transform.rotation = rotation;
+        transform.needUpdate = true;
+    }
+}
+
 void PhysicsSystem::updateBody2DPosition(Signature signature, Entity entity, Body2DComponent& body){
     if (signature.test(scene->getComponentId<Transform>())){
         Transform& transform = scene->getComponent<Transform>(entity);
         if (b2Body_IsValid(body.body)){
 
+            // transform only follows the body
+            if (isTransformFromPose(entity, transform)){
+                return;
+            }
+
             b2Vec2 bNewPosition = {transform.worldPosition.x / pointsToMeterScale2D, transform.worldPosition.y / pointsToMeterScale2D};
             float bNewAngle = Angle::defaultToRad(transform.worldRotation.getRoll());
 
@@ -147,6 +505,12 @@ void PhysicsSystem::updateBody2DPosition(Signature signature, Entity entity, Bod
             if (bTransform.p != bNewPosition || b2Rot_GetAngle(bTransform.q) != bNewAngle){
                 b2Body_SetTransform(body.body, bNewPosition, b2MakeRot(bNewAngle));
                 b2Body_SetAwake(body.body, true);
+
+                if (isInterpolating()){
+                    resetBodyPose(entity,
+                        Vector3(bNewPosition.x * pointsToMeterScale2D, bNewPosition.y * pointsToMeterScale2D, transform.worldPosition.z),
+                        Quaternion(Angle::radToDefault(bNewAngle), Vector3(0, 0, 1)));
+                }
             }
         }
     }
@@ -156,6 +520,11 @@ void PhysicsSystem::updateBody3DPosition(Signature signature, Entity entity, Bod
     if (signature.test(scene->getComponentId<Transform>())){
         Transform& transform = scene->getComponent<Transform>(entity);
         if (!body.body.IsInvalid()){
+            // transform only follows the body
+            if (isTransformFromPose(entity, transform)){
+                return;
+            }
+
             JPH::Vec3 jNewPosition(transform.worldPosition.x, transform.worldPosition.y, transform.worldPosition.z);
             JPH::Quat jNewQuat(transform.worldRotation.x, transform.worldRotation.y, transform.worldRotation.z, transform.worldRotation.w);
 
@@ -167,13 +536,19 @@ void PhysicsSystem::updateBody3DPosition(Signature signature, Entity entity, Bod
                 }
             }
 
-            JPH::BodyInterface &body_interface = world3D.GetBodyInterfaceNoLock();
+            JPH::BodyInterface &body_interface = world3D->GetBodyInterfaceNoLock();
             JPH::Vec3 jPosition;
             JPH::Quat jQuat;
             body_interface.GetPositionAndRotation(body.body, jPosition, jQuat);
 
             if (jPosition != jNewPosition || jQuat != jNewQuat){
                 body_interface.SetPositionAndRotation(body.body, jNewPosition, jNewQuat, JPH::EActivation::Activate);
+
+                if (isInterpolating()){
+                    resetBodyPose(entity,
+                        Vector3(jNewPosition.GetX(), jNewPosition.GetY(), jNewPosition.GetZ()),
+                        Quaternion(jNewQuat.GetW(), jNewQuat.GetX(), jNewQuat.GetY(), jNewQuat.GetZ()));
+                }
             }
         }
     }
@@ -802,7 +1177,7 @@ void PhysicsSystem::createGenericJoltBody(Entity entity, Body3DComponent& body,
 
     JPH::BodyCreationSettings settings(shape, JPH::Vec3(0.0, 0.0, 0.0), JPH::Quat::sIdentity(), joltType, layer);
 
-    JPH::BodyInterface &body_interface = world3D.GetBodyInterface();
+    JPH::BodyInterface &body_interface = world3D->GetBodyInterface();
 
     if(body.overrideMassProperties){
         settings.mOverrideMassProperties = JPH::EOverrideMassProperties::MassAndInertiaProvided;
@@ -810,6 +1185,10 @@ void PhysicsSystem::createGenericJoltBody(Entity entity, Body3DComponent& body,
     }
 
     JPH::Body* jbody = body_interface.CreateBody(settings);
+    if (!jbody){
+        Log::error("Cannot create Body3D for entity %u, maximum of %u 3D bodies reached (see setMaxBodies3D)", entity, maxBodies3D);
+        return;
+    }
     jbody->SetUserData(entity);
     //if (type != BodyType::STATIC){
     //    jbody->SetAllowSleeping(false);
@@ -862,7 +1241,7 @@ b2WorldId PhysicsSystem::getWorld2D() const{
 }
 
 JPH::PhysicsSystem* PhysicsSystem::getWorld3D(){
-    return &world3D;
+    return world3D;
 }
 
 b2BodyId PhysicsSystem::getBody(Entity entity){
@@ -937,7 +1316,7 @@ bool PhysicsSystem::loadBody3D(Entity entity){
 
 void PhysicsSystem::destroyBody3D(Body3DComponent& body){
     if (!body.body.IsInvalid()){
-        JPH::BodyInterface &body_interface = world3D.GetBodyInterface();
+        JPH::BodyInterface &body_interface = world3D->GetBodyInterface();
         body_interface.RemoveBody(body.body);
         body_interface.DestroyBody(body.body);
 
@@ -1319,7 +1698,7 @@ bool PhysicsSystem::loadFixedJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
         JPH::FixedConstraintSettings settings;
         settings.mAutoDetectPoint = true;
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1332,7 +1711,7 @@ bool PhysicsSystem::loadFixedJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::FIXED;
 
     }else{
@@ -1355,7 +1734,7 @@ bool PhysicsSystem::loadDistanceJoint3D(Joint3DComponent& joint, Entity bodyA, E
         updateBody3DPosition(signatureA, bodyA, myBodyA);
         updateBody3DPosition(signatureB, bodyB, myBodyB);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1384,7 +1763,7 @@ bool PhysicsSystem::loadDistanceJoint3D(Joint3DComponent& joint, Entity bodyA, E
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::DISTANCE;
 
     }else{
@@ -1410,7 +1789,7 @@ bool PhysicsSystem::loadPointJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
         JPH::PointConstraintSettings settings;
         settings.mPoint1 = settings.mPoint2 = JPH::Vec3(anchor.x, anchor.y, anchor.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1423,7 +1802,7 @@ bool PhysicsSystem::loadPointJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::POINT;
 
     }else{
@@ -1482,7 +1861,7 @@ bool PhysicsSystem::loadHingeJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
         settings.mHingeAxis1 = settings.mHingeAxis2 = JPH::Vec3(axis.x, axis.y, axis.z);
         settings.mNormalAxis1 = settings.mNormalAxis2 = JPH::Vec3(normal.x, normal.y, normal.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1495,7 +1874,7 @@ bool PhysicsSystem::loadHingeJoint3D(Joint3DComponent& joint, Entity bodyA, Enti
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::HINGE;
 
     }else{
@@ -1531,7 +1910,7 @@ bool PhysicsSystem::loadConeJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
         settings.mPoint1 = settings.mPoint2 = JPH::Vec3(anchor.x, anchor.y, anchor.z);
         settings.mTwistAxis1 = settings.mTwistAxis2 = JPH::Vec3(twistAxis.x, twistAxis.y, twistAxis.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1544,7 +1923,7 @@ bool PhysicsSystem::loadConeJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::CONE;
 
     }else{
@@ -1606,7 +1985,7 @@ bool PhysicsSystem::loadPrismaticJoint3D(Joint3DComponent& joint, Entity bodyA,
 		settings.mLimitsMin = limitsMin;
 		settings.mLimitsMax = limitsMax;
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1619,7 +1998,7 @@ bool PhysicsSystem::loadPrismaticJoint3D(Joint3DComponent& joint, Entity bodyA,
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::PRISMATIC;
 
     }else{
@@ -1695,7 +2074,7 @@ bool PhysicsSystem::loadSwingTwistJoint3D(Joint3DComponent& joint, Entity bodyA,
         settings.mTwistMinAngle = Angle::defaultToRad(twistMinAngle);
         settings.mTwistMaxAngle = Angle::defaultToRad(twistMaxAngle);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1708,7 +2087,7 @@ bool PhysicsSystem::loadSwingTwistJoint3D(Joint3DComponent& joint, Entity bodyA,
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::SWINGTWIST;
 
     }else{
@@ -1772,7 +2151,7 @@ bool PhysicsSystem::loadSixDOFJoint3D(Joint3DComponent& joint, Entity bodyA, Ent
         settings.mAxisX1 = settings.mAxisX2 = JPH::Vec3(axisX.x, axisX.y, axisX.z);
         settings.mAxisY1 = settings.mAxisY2 = JPH::Vec3(axisY.x, axisY.y, axisY.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1785,7 +2164,7 @@ bool PhysicsSystem::loadSixDOFJoint3D(Joint3DComponent& joint, Entity bodyA, Ent
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::SIXDOF;
 
     }else{
@@ -1824,7 +2203,7 @@ bool PhysicsSystem::loadPathJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
         settings.mPath = path;
         settings.mPathPosition = JPH::Vec3(pathPosition.x, pathPosition.y, pathPosition.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1837,7 +2216,7 @@ bool PhysicsSystem::loadPathJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::PATH;
 
     }else{
@@ -1872,7 +2251,7 @@ bool PhysicsSystem::loadGearJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
                 return false;
             }
 
-            const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+            const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
             JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
             JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1906,7 +2285,7 @@ bool PhysicsSystem::loadGearJoint3D(Joint3DComponent& joint, Entity bodyA, Entit
             joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
             ((JPH::GearConstraint *)joint.joint)->SetConstraints(myHingeA.joint, myHingeB.joint);
-            world3D.AddConstraint(joint.joint);
+            world3D->AddConstraint(joint.joint);
             joint.type = Joint3DType::GEAR;
         }else{
             Log::error("Cannot create joint, error in hingeA or hingeB");
@@ -1945,7 +2324,7 @@ bool PhysicsSystem::loadRackAndPinionJoint3D(Joint3DComponent& joint, Entity bod
                 return false;
             }
 
-            const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+            const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
             JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
             JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -1980,7 +2359,7 @@ bool PhysicsSystem::loadRackAndPinionJoint3D(Joint3DComponent& joint, Entity bod
             joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
             ((JPH::GearConstraint *)joint.joint)->SetConstraints(myHinge.joint, mySlider.joint);
-            world3D.AddConstraint(joint.joint);
+            world3D->AddConstraint(joint.joint);
             joint.type = Joint3DType::RACKANDPINON;
         }else{
             Log::error("Cannot create joint, error in hinge or slider");
@@ -2013,7 +2392,7 @@ bool PhysicsSystem::loadPulleyJoint3D(Joint3DComponent& joint, Entity bodyA, Ent
         settings.mFixedPoint1 = JPH::Vec3(fixedPointA.x, fixedPointA.y, fixedPointA.z);
         settings.mFixedPoint2 = JPH::Vec3(fixedPointB.x, fixedPointB.y, fixedPointB.z);
 
-        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D.GetBodyLockInterfaceNoLock());
+        const JPH::BodyLockInterface& bodyLockInterface = lock3DBodies? static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterface()) : static_cast<const JPH::BodyLockInterface &>(world3D->GetBodyLockInterfaceNoLock());
         JPH::BodyID bodies[2] = {myBodyA.body, myBodyB.body};
         JPH::BodyLockMultiWrite lock(bodyLockInterface, bodies, 2);
 
@@ -2026,7 +2405,7 @@ bool PhysicsSystem::loadPulleyJoint3D(Joint3DComponent& joint, Entity bodyA, Ent
 
         joint.joint = settings.Create(*lockBodyA, *lockBodyB);
 
-        world3D.AddConstraint(joint.joint);
+        world3D->AddConstraint(joint.joint);
         joint.type = Joint3DType::PULLEY;
 
     }else{
@@ -2039,7 +2418,7 @@ bool PhysicsSystem::loadPulleyJoint3D(Joint3DComponent& joint, Entity bodyA, Ent
 
 void PhysicsSystem::destroyJoint3D(Joint3DComponent& joint){
     if (joint.joint){
-        world3D.RemoveConstraint(joint.joint);
+        world3D->RemoveConstraint(joint.joint);
 
         joint.joint = NULL;
     }
@@ -2076,10 +2455,10 @@ void PhysicsSystem::update(double dt){
 
 	auto bodies2d = scene->getComponentArray<Body2DComponent>();
 
-	for (int i = 0; i < bodies2d->size(); i++){
-		Body2DComponent& body = bodies2d->getComponentFromIndex(i);
-		Entity entity = bodies2d->getEntity(i);
-		Signature signature = scene->getSignature(entity);
+	for (size_t i = 0; i < bodies2DView->size(); i++){
+		Body2DComponent& body = bodies2d->getComponentFromIndex(bodies2DView->getComponentIndex(i));
+		Entity entity = bodies2DView->getEntity(i);
+		Signature signature = bodies2DView->getSignature(i);
 
         if (!b2Body_IsValid(body.body) || body.needReloadBody || body.needUpdateShapes){
             loadBody2D(entity);
@@ -2103,63 +2482,31 @@ void PhysicsSystem::update(double dt){
         }
     }
 
-    if (bodies2d->size() > 0){
-        int32_t subSteps = 4;
-        b2World_Step(world2D, dt, subSteps);
-    }
-
-    b2BodyEvents events = b2World_GetBodyEvents(world2D);
-    for (int i = 0; i < events.moveCount; ++i){
-        const b2BodyMoveEvent* event = events.moveEvents + i;
-
-        Entity entity = reinterpret_cast<uintptr_t>(event->userData);
-        Signature signature = scene->getSignature(entity);
-
-        b2Transform bTransform = event->transform;
-        if (signature.test(scene->getComponentId<Transform>())){
-            Transform& transform = scene->getComponent<Transform>(entity);
-
-            Vector3 nPosition = Vector3(bTransform.p.x * pointsToMeterScale2D, bTransform.p.y * pointsToMeterScale2D, transform.worldPosition.z);
-            Quaternion nRotation = Quaternion(Angle::radToDefault(b2Rot_GetAngle(bTransform.q)), Vector3(0, 0, 1));
-
-            if (transform.parent != NULL_ENTITY){
-                Transform& transformParent = scene->getComponent<Transform>(transform.parent);
-
-                nPosition = transformParent.modelMatrix.inverse() * nPosition;
-                nRotation = transformParent.worldRotation.inverse() * nRotation;
-            }
-
-            if (transform.position != nPosition){
-                transform.position = nPosition;
-                transform.needUpdate = true;
-            }
-
-            if (transform.rotation != nRotation){
-                transform.rotation = nRotation;
-                transform.needUpdate = true;
-            }
-        }
-    }
-
-    Box2DAux::manageEvents(scene, world2D);
-
     auto bodies3d = scene->getComponentArray<Body3DComponent>();
 
-	for (int i = 0; i < bodies3d->size(); i++){
-		Body3DComponent& body = bodies3d->getComponentFromIndex(i);
-		Entity entity = bodies3d->getEntity(i);
-		Signature signature = scene->getSignature(entity);
+	for (size_t i = 0; i < bodies3DView->size(); i++){
+		Body3DComponent& body = bodies3d->getComponentFromIndex(bodies3DView->getComponentIndex(i));
+		Entity entity = bodies3DView->getEntity(i);
+		Signature signature = bodies3DView->getSignature(i);
 
         if (body.body.IsInvalid() || body.needReloadBody || body.needUpdateShapes){
             loadBody3D(entity);
         }
 
-        if (!body.body.IsInvalid()){
+        if (!body.body.IsInvalid() && body.newBody){
             updateBody3DPosition(signature, entity, body);
 
             body.newBody = false;
         }
     }
+    // other bodies only follow transforms changed since last update
+    for (Entity entity : scene->getSystem<RenderSystem>()->getUpdatedTransforms()){
+        Body3DComponent* body = scene->findComponent<Body3DComponent>(entity);
+
+        if (body && !body->body.IsInvalid()){
+            updateBody3DPosition(scene->getSignature(entity), entity, *body);
+        }
+    }
     auto joints3d = scene->getComponentArray<Joint3DComponent>();
     for (int i = 0; i < joints3d->size(); i++){
         Joint3DComponent& joint = joints3d->getComponentFromIndex(i);
@@ -2172,50 +2519,98 @@ void PhysicsSystem::update(double dt){
         }
     }
 
-    if (bodies3d->size() > 0){
-		const int cCollisionSteps = 1;
+    int steps = 1;
+    float stepTime = dt;
+    if (fixedTimeStep > 0){
+        const int MAX_STEPS_PER_UPDATE = 8;
 
-		world3D.Update(dt, cCollisionSteps, temp_allocator, job_system);
-	}
+        stepTime = fixedTimeStep;
+        stepAccumulator += dt;
+
+        steps = 0;
+        while (stepAccumulator >= fixedTimeStep && steps < MAX_STEPS_PER_UPDATE){
+            stepAccumulator -= fixedTimeStep;
+            steps++;
+        }
+        if (stepAccumulator >= fixedTimeStep){
+            // cannot catch up, drop remaining time
+            stepAccumulator = std::fmod(stepAccumulator, fixedTimeStep);
+        }
+    }
 
-	for (int i = 0; i < bodies3d->size(); i++){
-		Body3DComponent& body = bodies3d->getComponentFromIndex(i);
-		Entity entity = bodies3d->getEntity(i);
-		Signature signature = scene->getSignature(entity);
+    bool interpolating = isInterpolating();
 
-        if (!body.body.IsInvalid()){
-            JPH::BodyInterface &body_interface = world3D.GetBodyInterfaceNoLock();
-            JPH::RVec3 position = body_interface.GetPosition(body.body);
-            JPH::Quat rotation = body_interface.GetRotation(body.body);
+    for (int s = 0; s < steps; s++){
+        stepCount++;
+
+        if (bodies2d->size() > 0){
+            updateCallbacks2D();
+
+            int32_t subSteps = 4;
+            b2World_Step(world2D, stepTime, subSteps);
+        }
+
+        // move events are only valid until next step
+        b2BodyEvents events = b2World_GetBodyEvents(world2D);
+        for (int i = 0; i < events.moveCount; ++i){
+            const b2BodyMoveEvent* event = events.moveEvents + i;
+
+            Entity entity = reinterpret_cast<uintptr_t>(event->userData);
+            Signature signature = scene->getSignature(entity);
+
+            b2Transform bTransform = event->transform;
             if (signature.test(scene->getComponentId<Transform>())){
                 Transform& transform = scene->getComponent<Transform>(entity);
 
-                if (!std::isnan(position.GetX()) && !std::isnan(position.GetY()) && !std::isnan(position.GetZ())){
-                    Vector3 nPosition = Vector3(position.GetX(), position.GetY(), position.GetZ());
-                    Quaternion nRotation = Quaternion(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ());
+                Vector3 nPosition = Vector3(bTransform.p.x * pointsToMeterScale2D, bTransform.p.y * pointsToMeterScale2D, transform.worldPosition.z);
+                Quaternion nRotation = Quaternion(Angle::radToDefault(b2Rot_GetAngle(bTransform.q)), Vector3(0, 0, 1));
 
-                    if (transform.parent != NULL_ENTITY){
-                        Transform& transformParent = scene->getComponent<Transform>(transform.parent);
+                if (interpolating){
+                    recordBodyPose(entity, nPosition, nRotation);
+                }else{
+                    applyBodyTransform(transform, nPosition, nRotation);
+                }
+            }
+        }
 
-                        nPosition = transformParent.modelMatrix.inverse() * nPosition;
-                        nRotation = transformParent.worldRotation.inverse() * nRotation;
-                    }
+        Box2DAux::manageEvents(scene, world2D);
 
-                    if (transform.position != nPosition){
-                        transform.position = nPosition;
-                        transform.needUpdate = true;
-                    }
+        if (bodies3d->size() > 0){
+            update3DWorld(stepTime);
+        }
 
-                    if (transform.rotation != nRotation){
-                        transform.rotation = nRotation;
-                        transform.needUpdate = true;
-                    }
-                }
+        // only the two last poses are needed
+        if (interpolating && s >= steps - 2){
+            collectMoved3DBodies();
+            read3DBodyPoses();
+        }
+    }
+
+    if (interpolating){
+        applyBodyPoses();
+        return;
+    }
+
+    collectMoved3DBodies();
+
+    JPH::BodyInterface &body_interface = world3D->GetBodyInterfaceNoLock();
+    for (const JPH::BodyID& bodyID : movedBodies3D){
+        Entity entity = (Entity)body_interface.GetUserData(bodyID);
+        Transform* transform = scene->findComponent<Transform>(entity);
+
+        if (transform){
+            JPH::RVec3 position;
+            JPH::Quat rotation;
+            body_interface.GetPositionAndRotation(bodyID, position, rotation);
+
+            if (!std::isnan(position.GetX()) && !std::isnan(position.GetY()) && !std::isnan(position.GetZ())){
+                Vector3 nPosition = Vector3(position.GetX(), position.GetY(), position.GetZ());
+                Quaternion nRotation = Quaternion(rotation.GetW(), rotation.GetX(), rotation.GetY(), rotation.GetZ());
 
+                applyBodyTransform(*transform, nPosition, nRotation);
             }
         }
     }
-    
 }
 
 void PhysicsSystem::draw(){
@@ -2230,9 +2625,11 @@ void PhysicsSystem::onComponentRemoved(Entity entity, ComponentId componentId) {
 	if (componentId == scene->getComponentId<Body2DComponent>()) {
 		Body2DComponent& body2d = scene->getComponent<Body2DComponent>(entity);
 		destroyBody2D(body2d);
+		bodyPoses.entityDestroyed(entity);
 	} else if (componentId == scene->getComponentId<Body3DComponent>()) {
 		Body3DComponent& body3d = scene->getComponent<Body3DComponent>(entity);
 		destroyBody3D(body3d);
+		bodyPoses.entityDestroyed(entity);
 	} else if (componentId == scene->getComponentId<Joint2DComponent>()) {
 		Joint2DComponent& joint2d = scene->getComponent<Joint2DComponent>(entity);
 		destroyJoint2D(joint2d);
@@ -5,7 +5,11 @@
 #ifndef PHYSICSSYSTEM_H
 #define PHYSICSSYSTEM_H
 
+#include <functional>
+
 #include "SubSystem.h"
+#include "ecs/ComponentArray.h"
+#include "component/Transform.h"
 #include "component/Body2DComponent.h"
 #include "component/Joint2DComponent.h"
 #include "object/physics/Contact2D.h"
@@ -17,7 +21,7 @@
 #include "box2d/box2d.h"
 
 #include "Jolt/Jolt.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
+#include "Jolt/Core/JobSystem.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 #include "Jolt/Physics/Collision/BroadPhase/BroadPhaseLayerInterfaceMask.h"
 #include "Jolt/Physics/Collision/BroadPhase/ObjectVsBroadPhaseLayerFilterMask.h"
@@ -27,8 +31,43 @@ namespace doriax{
 
 	class JoltActivationListener;
 	class JoltContactListener;
+	class JoltJobSystem;
+	class Box2DTaskScheduler;
+	class JoltTempAllocator;
+
+	// C++ only contact validation (entity1, shapeIndex1, entity2, shapeIndex2), called from solver threads
+	using ContactFilter3D = std::function<bool(Entity, size_t, Entity, size_t)>;
+
+	// World space poses of a body after the last two simulation steps
+	struct BodyPose{
+		Vector3 previousPosition;
+		Quaternion previousRotation;
+		Vector3 currentPosition;
+		Quaternion currentRotation;
+		uint64_t step = 0; // step of current pose
+
+		// local transform written last time, to tell it from user changes
+		Vector3 writtenPosition;
+		Quaternion writtenRotation;
+		bool written = false;
+	};
 	
 
+	// 3D world counters, peak values are kept until resetStats3D
+	struct PhysicsStats3D{
+		uint32_t numBodies = 0;
+		uint32_t numActiveBodies = 0;
+		uint32_t maxBodies = 0;
+		uint32_t maxBodyPairs = 0;
+		uint32_t maxContactConstraints = 0;
+		float lastStepTime = 0; // milliseconds
+		float peakStepTime = 0;
+		size_t tempAllocatorSize = 0;
+		size_t tempAllocatorPeak = 0;
+		uint32_t tempFallbackAllocations = 0; // allocations that did not fit the block
+		uint32_t stepErrors = 0; // JPH::EPhysicsUpdateError flags seen since world creation
+	};
+
 	class DORIAX_API PhysicsSystem : public SubSystem {
 
 	private:
@@ -36,20 +75,66 @@ namespace doriax{
 
 		b2WorldId world2D;
 		float pointsToMeterScale2D;
+		// 0 uses all engine pool threads
+		int workerCount2D;
+		Box2DTaskScheduler* taskScheduler2D;
+		bool customFilter2D;
+		bool preSolveCallback2D;
 		bool lock3DBodies;
 
 		JoltActivationListener* activationListener3D;
 		JoltContactListener* contactListener3D;
 
-        JPH::TempAllocatorImpl* temp_allocator;
-        JPH::JobSystemThreadPool* job_system;
+        JoltTempAllocator* temp_allocator;
+        JoltJobSystem* job_system;
+
+		JPH::PhysicsSystem* world3D;
 
-		JPH::PhysicsSystem world3D;
+		uint32_t maxBodies3D;
+		uint32_t maxBodyPairs3D;
+		uint32_t maxContactConstraints3D;
+		uint32_t reportedStepErrors;
+		float lastStepTime3D;
+		float peakStepTime3D;
 
 		JPH::BroadPhaseLayerInterfaceMask* broad_phase_layer_interface;
 		JPH::ObjectVsBroadPhaseLayerFilterMask* object_vs_broadphase_layer_filter;
 		JPH::ObjectLayerPairFilterMask* object_vs_object_layer_filter;
 
+		std::shared_ptr<EntityView> bodies2DView;
+		std::shared_ptr<EntityView> bodies3DView;
+
+		// 0 steps once per update with scene delta time
+		float fixedTimeStep;
+		float stepAccumulator;
+		uint64_t stepCount;
+		PhysicsInterpolation interpolation;
+
+		ContactFilter3D contactFilter3D;
+
+		// bodies that can have moved in last steps: active ones and the ones that fell asleep
+		std::vector<JPH::BodyID> movedBodies3D;
+		std::vector<JPH::BodyID> deactivatedBodies3D;
+
+		// side buffer by body entity, only used with fixed time step
+		ComponentArray<BodyPose> bodyPoses;
+
+		void createWorld2D();
+		void updateCallbacks2D();
+
+		void createWorld3D();
+		bool canResizeWorld3D() const;
+		void update3DWorld(float stepTime);
+
+		bool isInterpolating() const;
+		bool isTransformFromPose(Entity entity, const Transform& transform);
+		void resetBodyPose(Entity entity, const Vector3& position, const Quaternion& rotation);
+		void recordBodyPose(Entity entity, const Vector3& position, const Quaternion& rotation);
+		void collectMoved3DBodies();
+		void read3DBodyPoses();
+		void applyBodyPoses();
+		void applyBodyTransform(Transform& transform, Vector3 position, Quaternion rotation);
+
 		void updateBody2DPosition(Signature signature, Entity entity, Body2DComponent& body);
 		void updateBody3DPosition(Signature signature, Entity entity, Body3DComponent& body);
 		bool loadJoint2D(Entity entity, Joint2DComponent& joint);
@@ -76,21 +161,59 @@ namespace doriax{
         void setLock3DBodies(bool lock3DBodies);
         bool isLock3DBodies() const;
 
+		// seconds per simulation step, 0 to step with frame time (default)
+		void setFixedTimeStep(float fixedTimeStep);
+		float getFixedTimeStep() const;
+
+		void setInterpolation(PhysicsInterpolation interpolation);
+		PhysicsInterpolation getInterpolation() const;
+
+		// fraction of a fixed step not yet simulated
+		float getInterpolationAlpha() const;
+
+		// threads stepping the 2D world, 0 to use engine pool size, can only change while there are no 2D bodies
+		void setWorkerCount2D(int workerCount2D);
+		int getWorkerCount2D() const;
+
+		// 3D world capacities, can only change while there are no 3D bodies
+		void setMaxBodies3D(uint32_t maxBodies3D);
+		uint32_t getMaxBodies3D() const;
+
+		void setMaxBodyPairs3D(uint32_t maxBodyPairs3D);
+		uint32_t getMaxBodyPairs3D() const;
+
+		void setMaxContactConstraints3D(uint32_t maxContactConstraints3D);
+		uint32_t getMaxContactConstraints3D() const;
+
+		// initial size in bytes, grows to observed peak use
+		void setTempAllocatorSize3D(size_t size);
+		size_t getTempAllocatorSize3D() const;
+
+		PhysicsStats3D getStats3D() const;
+		void resetStats3D();
+
+		// checked before shouldCollide3D, must be thread safe
+		void setContactFilter3D(ContactFilter3D contactFilter3D);
+		const ContactFilter3D& getContactFilter3D() const;
+
 		FunctionSubscribe<void(Body2D, unsigned long, Body2D, unsigned long)> beginContact2D;
 		FunctionSubscribe<void(Body2D, unsigned long, Body2D, unsigned long)> endContact2D;
 		FunctionSubscribe<void(Body2D, unsigned long, Body2D, unsigned long)> beginSensorContact2D;
 		FunctionSubscribe<void(Body2D, unsigned long, Body2D, unsigned long)> endSensorContact2D;
 		FunctionSubscribe<void(Body2D, unsigned long, Body2D, unsigned long, Vector2, Vector2, float)> hitContact2D;
+		// preSolve2D and shouldCollide2D are called during the step, while subscribed the 2D step runs single threaded on main thread
 		FunctionSubscribe<bool(Body2D, unsigned long, Body2D, unsigned long, Manifold2D)> preSolve2D;
 
 		FunctionSubscribe<bool(Body2D, unsigned long, Body2D, unsigned long)> shouldCollide2D;
 
 		FunctionSubscribe<void(Body3D)> onBodyActivated3D;
 		FunctionSubscribe<void(Body3D)> onBodyDeactivated3D;
+		// dispatched on main thread after the step, contact settings changed here apply from next step
 		FunctionSubscribe<void(Body3D, Body3D, Contact3D)> onContactAdded3D;
 		FunctionSubscribe<void(Body3D, Body3D, Contact3D)> onContactPersisted3D;
 		FunctionSubscribe<void(Body3D, Body3D, unsigned long, unsigned long)> onContactRemoved3D;
 
+		// called during the step, while subscribed the 3D step runs single threaded on main thread
 		FunctionSubscribe<bool(Body3D, Body3D, Vector3, CollideShapeResult3D)> shouldCollide3D;
 
 		void createBody2D(Entity entity);
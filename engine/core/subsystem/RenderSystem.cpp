@@ -15,11 +15,16 @@
 #include "pool/TexturePool.h"
 #include "math/Vector3.h"
 #include "util/Angle.h"
+#include "util/RadixSort.h"
 #include "buffer/ExternalBuffer.h"
 #include "math/AABB.h"
 #include <memory>
 #include <cmath>
 
+#ifndef NO_THREAD_SUPPORT
+#include "thread/ThreadPoolManager.h"
+#endif
+
 using namespace doriax;
 
 uint32_t RenderSystem::pixelsWhite[64];
@@ -37,6 +42,14 @@ RenderSystem::RenderSystem(Scene* scene): SubSystem(scene){
     signature.set(scene->getComponentId<Transform>());
 
     this->scene = scene;
+
+    this->meshesView = scene->getView<MeshComponent, Transform>();
+
+    this->transformLinksVersion = 0;
+    this->transformFrame = 0;
+    this->needUpdateTransformLinks = true;
+    this->transformsUpdated = 0;
+    this->drawRun = 0;
 }
 
 RenderSystem::~RenderSystem(){
@@ -811,6 +824,7 @@ bool RenderSystem::loadMesh(Entity entity, MeshComponent& mesh, uint8_t pipeline
 
         mesh.submeshes[i].needUpdateTexture = false;
         mesh.submeshes[i].needUpdateDepthTexture = false;
+        mesh.submeshes[i].materialKey = getMaterialSortKey(mesh.submeshes[i], mesh);
 
         if (mesh.autoTransparency && !mesh.transparent){
             if (mesh.submeshes[i].material.baseColorTexture.isTransparent() || mesh.submeshes[i].material.baseColorFactor.w != 1.0){
@@ -824,7 +838,7 @@ bool RenderSystem::loadMesh(Entity entity, MeshComponent& mesh, uint8_t pipeline
             if (buf.second->isRenderAttributes()) {
                 if (buf.second->getType() == BufferType::INDEX_BUFFER){
                     indexCount = buf.second->getCount();
-                    Attribute indexattr = buf.second->getAttributes()[AttributeType::INDEX];
+                    const Attribute& indexattr = buf.second->getAttributes().at(AttributeType::INDEX);
                     render.setIndex(buf.second->getRender(), indexattr.getDataType(), indexattr.getOffset());
                 }else{
                     for (auto const &attr : buf.second->getAttributes()) {
@@ -900,7 +914,7 @@ bool RenderSystem::loadMesh(Entity entity, MeshComponent& mesh, uint8_t pipeline
 
                     if (buf.second->getType() == BufferType::INDEX_BUFFER){
                         indexCount = buf.second->getCount();
-                        Attribute indexattr = buf.second->getAttributes()[AttributeType::INDEX];
+                        const Attribute& indexattr = buf.second->getAttributes().at(AttributeType::INDEX);
                         depthRender.setIndex(buf.second->getRender(), indexattr.getDataType(), indexattr.getOffset());
                     }else{
                         for (auto const &attr : buf.second->getAttributes()){
@@ -980,123 +994,140 @@ bool RenderSystem::loadMesh(Entity entity, MeshComponent& mesh, uint8_t pipeline
     return true;
 }
 
-bool RenderSystem::drawMesh(MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform, bool renderToTexture, InstancedMeshComponent* instmesh, TerrainComponent* terrain){
-    if (mesh.loaded){
+bool RenderSystem::prepareMeshDraw(MeshComponent& mesh, CameraComponent& camera, InstancedMeshComponent* instmesh, TerrainComponent* terrain){
+    if (!mesh.loaded){
+        return false;
+    }
 
-        if (mesh.worldAABB != AABB::ZERO && !isInsideCamera(camera, mesh.worldAABB)) {
-            return false;
+    if (mesh.needUpdateBuffer){
+        if (mesh.buffer.getUsage() != BufferUsage::IMMUTABLE)
+            mesh.buffer.getRender()->updateBuffer(mesh.buffer.getSize(), mesh.buffer.getData());
+        if (mesh.indices.getUsage() != BufferUsage::IMMUTABLE)
+            mesh.indices.getRender()->updateBuffer(mesh.indices.getSize(), mesh.indices.getData());
+        for (int i = 0; i < mesh.numExternalBuffers; i++){
+            if (mesh.eBuffers[i].getUsage() != BufferUsage::IMMUTABLE)
+                mesh.eBuffers[i].getRender()->updateBuffer(mesh.eBuffers[i].getSize(), mesh.eBuffers[i].getData());
         }
 
-        if (mesh.needUpdateBuffer){
-            if (mesh.buffer.getUsage() != BufferUsage::IMMUTABLE)
-                mesh.buffer.getRender()->updateBuffer(mesh.buffer.getSize(), mesh.buffer.getData());
-            if (mesh.indices.getUsage() != BufferUsage::IMMUTABLE)
-                mesh.indices.getRender()->updateBuffer(mesh.indices.getSize(), mesh.indices.getData());
-            for (int i = 0; i < mesh.numExternalBuffers; i++){
-                if (mesh.eBuffers[i].getUsage() != BufferUsage::IMMUTABLE)
-                    mesh.eBuffers[i].getRender()->updateBuffer(mesh.eBuffers[i].getSize(), mesh.eBuffers[i].getData());
-            }
+        mesh.needUpdateBuffer = false;
+    }
 
-            mesh.needUpdateBuffer = false;
-        }
-        unsigned int instanceCount = 1;
-        if (instmesh){
-            instanceCount = instmesh->numVisible;
+    if (instmesh){
+        if (instmesh->needUpdateBuffer){
+            // setData here because component can change order and lose reference
+            instmesh->buffer.setData((unsigned char*)instmesh->renderInstances.data(), sizeof(InstanceRenderData)*instmesh->numVisible);
+            instmesh->buffer.getRender()->updateBuffer(instmesh->buffer.getSize(), instmesh->buffer.getData());
 
-            if (instmesh->needUpdateBuffer){
-                // setData here because component can change order and lose reference
-                instmesh->buffer.setData((unsigned char*)(&instmesh->renderInstances[0]), sizeof(InstanceRenderData)*instmesh->numVisible);
-                instmesh->buffer.getRender()->updateBuffer(instmesh->buffer.getSize(), instmesh->buffer.getData());
+            instmesh->needUpdateBuffer = false;
+        }
+    }
 
-                instmesh->needUpdateBuffer = false;
-            }
+    if (terrain && terrain->needUpdateNodesBuffer){
+        for (int s = 0; s < 2; s++){
+            terrain->nodesbuffer[s].getRender()->updateBuffer(terrain->nodesbuffer[s].getSize(), terrain->nodesbuffer[s].getData());
         }
 
-        if (terrain && terrain->needUpdateNodesBuffer){
-            for (int s = 0; s < 2; s++){
-                terrain->nodesbuffer[s].getRender()->updateBuffer(terrain->nodesbuffer[s].getSize(), terrain->nodesbuffer[s].getData());
+        terrain->needUpdateNodesBuffer = false;
+    }
+
+    if (terrain && terrain->needUpdateTexture){
+        bool texLoaded = true;
+        for (int s = 0; s < 2; s++){
+            ShaderData& shaderData = mesh.submeshes[s].shader.get()->shaderData;
+            if (!loadTerrainTextures(*terrain, mesh.submeshes[s].render, shaderData)){
+                texLoaded = false;
             }
+        }
 
-            terrain->needUpdateNodesBuffer = false;
+        if (texLoaded){
+            terrain->needUpdateTexture = false;
         }
+    }
 
-        if (terrain && terrain->needUpdateTexture){
-            bool texLoaded = true;
-            for (int s = 0; s < 2; s++){
-                ShaderData& shaderData = mesh.submeshes[s].shader.get()->shaderData;
-                if (!loadTerrainTextures(*terrain, mesh.submeshes[s].render, shaderData)){
-                    texLoaded = false;
-                }
-            }
+    return true;
+}
 
-            if (texLoaded){
-                terrain->needUpdateTexture = false;
-            }
-        }
+bool RenderSystem::drawSubmesh(MeshComponent& mesh, unsigned int index, Transform& transform, bool renderToTexture, InstancedMeshComponent* instmesh, TerrainComponent* terrain){
+    Submesh& submesh = mesh.submeshes[index];
+    ObjectRender& render = submesh.render;
 
-        for (int i = 0; i < mesh.numSubmeshes; i++){
-            ObjectRender& render = mesh.submeshes[i].render;
+    unsigned int instanceCount = 1;
+    if (instmesh){
+        instanceCount = instmesh->numVisible;
+    }
+    if (terrain){
+        instanceCount = terrain->nodesbuffer[index].getCount();
+    }
 
-            if (terrain){
-                instanceCount = terrain->nodesbuffer[i].getCount();
-            }
+    bool needUpdateFramebuffer = checkPBRFrabebufferUpdate(submesh.material);
 
-            bool needUpdateFramebuffer = checkPBRFrabebufferUpdate(mesh.submeshes[i].material);
+    if (submesh.needUpdateTexture || needUpdateFramebuffer){
+        ShaderData& shaderData = submesh.shader.get()->shaderData;
+        if (loadPBRTextures(submesh.material, shaderData, submesh.render, mesh.receiveLights)){
+            submesh.needUpdateTexture = false;
+            submesh.materialKey = getMaterialSortKey(submesh, mesh);
+        }
+    }
 
-            if (mesh.submeshes[i].needUpdateTexture || needUpdateFramebuffer){
-                ShaderData& shaderData = mesh.submeshes[i].shader.get()->shaderData;
-                if (loadPBRTextures(mesh.submeshes[i].material, shaderData, mesh.submeshes[i].render, mesh.receiveLights)){
-                    mesh.submeshes[i].needUpdateTexture = false;
-                }
-            }
+    if (!render.beginDraw((renderToTexture)?PIP_RTT:PIP_DEFAULT)){
+        mesh.needReload = true;
+        return false;
+    }
 
-            if (!render.beginDraw((renderToTexture)?PIP_RTT:PIP_DEFAULT)){
-                mesh.needReload = true;
-                return false;
-            }
+    if (hasFog){
+        render.applyUniformBlock(submesh.slotFSFog, sizeof(float) * 8, &fs_fog);
+    }
 
-            if (hasFog){
-                render.applyUniformBlock(mesh.submeshes[i].slotFSFog, sizeof(float) * 8, &fs_fog);
-            }
+    if (hasLights && mesh.receiveLights){
+        render.applyUniformBlock(submesh.slotFSLighting, sizeof(float) * (16 * MAX_LIGHTS + 12), &fs_lighting);
+        if (hasShadows && mesh.receiveShadows){
+            render.applyUniformBlock(submesh.slotVSShadows, sizeof(float) * (20 * MAX_SHADOWSMAP), &vs_shadows);
+            render.applyUniformBlock(submesh.slotFSShadows, sizeof(float) * (4 * (MAX_SHADOWSMAP + MAX_SHADOWSCUBEMAP)), &fs_shadows);
+        }
+    }
 
-            if (hasLights && mesh.receiveLights){
-                render.applyUniformBlock(mesh.submeshes[i].slotFSLighting, sizeof(float) * (16 * MAX_LIGHTS + 12), &fs_lighting);
-                if (hasShadows && mesh.receiveShadows){
-                    render.applyUniformBlock(mesh.submeshes[i].slotVSShadows, sizeof(float) * (20 * MAX_SHADOWSMAP), &vs_shadows);
-                    render.applyUniformBlock(mesh.submeshes[i].slotFSShadows, sizeof(float) * (4 * (MAX_SHADOWSMAP + MAX_SHADOWSCUBEMAP)), &fs_shadows);
-                }
-            }
+    if (submesh.hasTextureRect){
+        render.applyUniformBlock(submesh.slotVSSprite, sizeof(float) * 4, &submesh.textureRect);
+    }
 
-            if (mesh.submeshes[i].hasTextureRect){
-                render.applyUniformBlock(mesh.submeshes[i].slotVSSprite, sizeof(float) * 4, &mesh.submeshes[i].textureRect);
-            }
+    if (submesh.hasSkinning){
+        render.applyUniformBlock(submesh.slotVSSkinning, sizeof(float) * 16 * MAX_BONES + (sizeof(float) * 4), &mesh.skinning.get());
+    }
 
-            if (mesh.submeshes[i].hasSkinning){
-                render.applyUniformBlock(mesh.submeshes[i].slotVSSkinning, sizeof(float) * 16 * MAX_BONES + (sizeof(float) * 4), &mesh.bonesMatrix);
-            }
+    if (submesh.hasMorphTarget){
+        if (!submesh.hasMorphNormal && !submesh.hasMorphTangent){
+            render.applyUniformBlock(submesh.slotVSMorphTarget, sizeof(float) * MAX_MORPHTARGETS, &mesh.morphWeights);
+        }else{
+            render.applyUniformBlock(submesh.slotVSMorphTarget, sizeof(float) * MAX_MORPHTARGETS / 2, &mesh.morphWeights);
+        }
+    }
 
-            if (mesh.submeshes[i].hasMorphTarget){
-                if (!mesh.submeshes[i].hasMorphNormal && !mesh.submeshes[i].hasMorphTangent){
-                    render.applyUniformBlock(mesh.submeshes[i].slotVSMorphTarget, sizeof(float) * MAX_MORPHTARGETS, &mesh.morphWeights);
-                }else{
-                    render.applyUniformBlock(mesh.submeshes[i].slotVSMorphTarget, sizeof(float) * MAX_MORPHTARGETS / 2, &mesh.morphWeights);
-                }
-            }
+    if (hasLights && mesh.receiveLights){
+        render.applyUniformBlock(submesh.slotFSParams, sizeof(float) * 12, &submesh.material);
+    }else{
+        render.applyUniformBlock(submesh.slotFSParams, sizeof(float) * 4, &submesh.material);
+    }
 
-            if (hasLights && mesh.receiveLights){
-                render.applyUniformBlock(mesh.submeshes[i].slotFSParams, sizeof(float) * 12, &mesh.submeshes[i].material);
-            }else{
-                render.applyUniformBlock(mesh.submeshes[i].slotFSParams, sizeof(float) * 4, &mesh.submeshes[i].material);
-            }
+    if (terrain){
+        render.applyUniformBlock(submesh.slotVSTerrain, sizeof(float) * 8, &(terrain->eyePos));
+    }
 
-            if (terrain){
-                render.applyUniformBlock(mesh.submeshes[i].slotVSTerrain, sizeof(float) * 8, &(terrain->eyePos));
-            }
+    //model, normal and mvp matrix
+    render.applyUniformBlock(submesh.slotVSParams, sizeof(float) * 48, &transform.modelMatrix);
+
+    render.draw(submesh.vertexCount, instanceCount);
+
+    return true;
+}
 
-            //model, normal and mvp matrix
-            render.applyUniformBlock(mesh.submeshes[i].slotVSParams, sizeof(float) * 48, &transform.modelMatrix);
+bool RenderSystem::drawMesh(MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform, bool renderToTexture, InstancedMeshComponent* instmesh, TerrainComponent* terrain){
+    if (!prepareMeshDraw(mesh, camera, instmesh, terrain)){
+        return false;
+    }
 
-            render.draw(mesh.submeshes[i].vertexCount, instanceCount);
+    for (int i = 0; i < mesh.numSubmeshes; i++){
+        if (!drawSubmesh(mesh, i, transform, renderToTexture, instmesh, terrain)){
+            return false;
         }
     }
 
@@ -1134,7 +1165,7 @@ bool RenderSystem::drawMeshDepth(MeshComponent& mesh, const float cameraFar, con
             depthRender.applyUniformBlock(mesh.submeshes[i].slotVSDepthParams, sizeof(float) * 32, &vsDepthParams);
 
             if (mesh.submeshes[i].hasSkinning){
-                depthRender.applyUniformBlock(mesh.submeshes[i].slotVSDepthSkinning, sizeof(float) * 16 * MAX_BONES + (sizeof(float) * 4), &mesh.bonesMatrix);
+                depthRender.applyUniformBlock(mesh.submeshes[i].slotVSDepthSkinning, sizeof(float) * 16 * MAX_BONES + (sizeof(float) * 4), &mesh.skinning.get());
             }
             if (mesh.submeshes[i].hasMorphTarget){
                 if (!mesh.submeshes[i].hasMorphNormal && !mesh.submeshes[i].hasMorphTangent){
@@ -1310,7 +1341,7 @@ bool RenderSystem::loadUI(Entity entity, UIComponent& ui, uint8_t pipelines, boo
     if (ui.indices.getCount() > 0){
         ui.indices.getRender()->createBuffer(bufferSize, ui.indices.getData(), ui.indices.getType(), ui.indices.getUsage());
         ui.vertexCount = ui.indices.getCount();
-        Attribute indexattr = ui.indices.getAttributes()[AttributeType::INDEX];
+        const Attribute& indexattr = ui.indices.getAttributes().at(AttributeType::INDEX);
         render.setIndex(ui.indices.getRender(), indexattr.getDataType(), indexattr.getOffset());
         if (ui.indices.getUsage() != BufferUsage::IMMUTABLE){
             ui.needUpdateBuffer = true;
@@ -1902,14 +1933,19 @@ Rect RenderSystem::getScissorRect(UILayoutComponent& layout, ImageComponent& img
 }
 
 void RenderSystem::updateTransform(Transform& transform){
-    Matrix4 translateMatrix = Matrix4::translateMatrix(transform.position);
-    Matrix4 rotationMatrix = transform.rotation.getRotationMatrix();
-    Matrix4 scaleMatrix = Matrix4::scaleMatrix(transform.scale);
+    const Transform* transformParent = NULL;
+    if (transform.parent != NULL_ENTITY){
+        transformParent = &scene->getComponent<Transform>(transform.parent);
+    }
 
-    transform.localMatrix = translateMatrix * rotationMatrix * scaleMatrix;
+    updateTransform(transform, transformParent);
+}
 
-    if (transform.parent != NULL_ENTITY){
-        Transform& transformParent = scene->getComponent<Transform>(transform.parent);
+void RenderSystem::updateTransform(Transform& transform, const Transform* parent){
+    transform.localMatrix = Matrix4::composeMatrix(transform.position, transform.rotation, transform.scale);
+
+    if (parent){
+        const Transform& transformParent = *parent;
 
         transform.modelMatrix = transformParent.modelMatrix * transform.localMatrix;
 
@@ -1927,6 +1963,145 @@ void RenderSystem::updateTransform(Transform& transform){
     if (hasLights){
         transform.normalMatrix = transform.modelMatrix.inverse().transpose();
     }
+
+    transformsUpdated++;
+}
+
+void RenderSystem::updateTransformLinks(){
+    auto transforms = scene->getComponentArray<Transform>();
+
+    if (!needUpdateTransformLinks && transformLinks.size() == transforms->size() && transformLinksVersion == transforms->getVersion()){
+        return;
+    }
+
+    size_t count = transforms->size();
+    transformLinks.resize(count);
+    for (size_t i = 0; i < count; i++){
+        transformLinks[i] = {NULL_TRANSFORM_INDEX, NULL_TRANSFORM_INDEX, NULL_TRANSFORM_INDEX, 0};
+    }
+
+    // backwards, so children keep array order when prepended
+    for (size_t i = count; i-- > 0;){
+        Transform& transform = transforms->getComponentFromIndex(i);
+
+        if (transform.parent != NULL_ENTITY && transforms->hasEntity(transform.parent)){
+            uint32_t parent = (uint32_t)transforms->getIndex(transform.parent);
+
+            transformLinks[i].parent = parent;
+            transformLinks[i].nextSibling = transformLinks[parent].firstChild;
+            transformLinks[parent].firstChild = (uint32_t)i;
+        }
+    }
+
+    transformLinksVersion = transforms->getVersion();
+    transformFrame = 0;
+    needUpdateTransformLinks = false;
+}
+
+bool RenderSystem::checkTransformLinks(){
+    auto transforms = scene->getComponentArray<Transform>();
+
+    if (transformLinks.size() != transforms->size() || transformLinksVersion != transforms->getVersion()){
+        return false;
+    }
+
+    return true;
+}
+
+void RenderSystem::propagateTransforms(){
+    auto transforms = scene->getComponentArray<Transform>();
+
+    dirtyTransforms.clear();
+
+    bool linksValid = !needUpdateTransformLinks && checkTransformLinks();
+
+    for (size_t i = 0; i < transforms->size(); i++){
+        Transform& transform = transforms->getComponentFromIndex(i);
+
+        if (transform.needUpdate || transform.needUpdateChildVisibility){
+            dirtyTransforms.push_back((uint32_t)i);
+        }
+
+        // parent can be assigned directly to the component, without reordering the array
+        if (linksValid){
+            uint32_t parent = transformLinks[i].parent;
+            if (parent == NULL_TRANSFORM_INDEX){
+                linksValid = (transform.parent == NULL_ENTITY || !transforms->hasEntity(transform.parent));
+            }else{
+                linksValid = (transforms->getEntity(parent) == transform.parent);
+            }
+        }
+    }
+
+    if (!linksValid){
+        needUpdateTransformLinks = true;
+    }
+    updateTransformLinks();
+
+    transformFrame++;
+    if (transformFrame == 0){
+        for (size_t i = 0; i < transformLinks.size(); i++){
+            transformLinks[i].visited = 0;
+        }
+        transformFrame = 1;
+    }
+
+    for (uint32_t index : dirtyTransforms){
+        // already reached from a dirty ancestor
+        if (transformLinks[index].visited != transformFrame){
+            updateTransformTree(index);
+        }
+    }
+}
+
+void RenderSystem::updateTransformTree(uint32_t root){
+    auto transforms = scene->getComponentArray<Transform>();
+
+    transformStack.clear();
+    transformStack.push_back(root);
+
+    while (!transformStack.empty()){
+        uint32_t index = transformStack.back();
+        transformStack.pop_back();
+
+        TransformLinks& links = transformLinks[index];
+        Transform& transform = transforms->getComponentFromIndex(index);
+        const Transform* transformParent = NULL;
+
+        if (links.parent != NULL_TRANSFORM_INDEX){
+            transformParent = &transforms->getComponentFromIndex(links.parent);
+
+            if (transformParent->needUpdate){
+                transform.needUpdate = true;
+            }
+
+            if (transformParent->needUpdateChildVisibility){
+                transform.visible = transformParent->visible;
+                transform.needUpdateChildVisibility = true;
+            }
+        }
+
+        if (transform.needUpdate){
+            updateTransform(transform, transformParent);
+            updatedTransforms.push_back(transforms->getEntity(index));
+        }
+
+        links.visited = transformFrame;
+
+        if (transform.needUpdate || transform.needUpdateChildVisibility){
+            for (uint32_t child = links.firstChild; child != NULL_TRANSFORM_INDEX; child = transformLinks[child].nextSibling){
+                transformStack.push_back(child);
+            }
+        }
+    }
+}
+
+size_t RenderSystem::getTransformsUpdated() const{
+    return transformsUpdated;
+}
+
+const std::vector<Entity>& RenderSystem::getUpdatedTransforms() const{
+    return updatedTransforms;
 }
 
 void RenderSystem::updateCamera(CameraComponent& camera, Transform& transform){
@@ -1993,14 +2168,18 @@ void RenderSystem::updateSkyViewProjection(SkyComponent& sky, CameraComponent& c
     sky.needUpdateSky = false;
 }
 
+float RenderSystem::getPointSizeScale(){
+    // point particle sizes are in pixels, need to convert it to canvas size
+    float sizeScaleW = System::instance().getScreenWidth() / (float)Engine::getCanvasWidth();
+    float sizeScaleH = System::instance().getScreenHeight() / (float)Engine::getCanvasHeight();
+    return std::max(sizeScaleW, sizeScaleH);
+}
+
 void RenderSystem::updatePoints(PointsComponent& points, Transform& transform, CameraComponent& camera, Transform& camTransform){
     points.renderPoints.clear();
     points.renderPoints.reserve(points.points.size());
 
-    // point particle sizes are in pixels, need to convert it to canvas size
-    float sizeScaleW = System::instance().getScreenWidth() / (float)Engine::getCanvasWidth();
-    float sizeScaleH = System::instance().getScreenHeight() / (float)Engine::getCanvasHeight();
-    float sizeScale = std::max(sizeScaleW, sizeScaleH);
+    float sizeScale = getPointSizeScale();
 
     points.numVisible = 0;
     size_t pointsSize = (points.points.size() < points.maxPoints)? points.points.size() : points.maxPoints;
@@ -2020,13 +2199,30 @@ void RenderSystem::updatePoints(PointsComponent& points, Transform& transform, C
         points.needUpdateBuffer = true;
 }
 
+void RenderSystem::depthSortAxis(const Matrix4& modelMatrix, const Vector3& camDir, Vector3& axis, float& offset){
+    // (modelMatrix * p).dot(camDir) == p.dot(axis) + offset, for affine model matrix
+    axis.x = modelMatrix[0][0] * camDir.x + modelMatrix[0][1] * camDir.y + modelMatrix[0][2] * camDir.z;
+    axis.y = modelMatrix[1][0] * camDir.x + modelMatrix[1][1] * camDir.y + modelMatrix[1][2] * camDir.z;
+    axis.z = modelMatrix[2][0] * camDir.x + modelMatrix[2][1] * camDir.y + modelMatrix[2][2] * camDir.z;
+    offset = modelMatrix[3][0] * camDir.x + modelMatrix[3][1] * camDir.y + modelMatrix[3][2] * camDir.z;
+}
+
 void RenderSystem::sortPoints(PointsComponent& points, Transform& transform, CameraComponent& camera, Transform& camTransform){
     Vector3 camDir = (camTransform.worldPosition - camera.worldTarget).normalize();
 
-    auto comparePoints = [&transform, &camDir](const PointRenderData& a, const PointRenderData& b) -> bool {
-        return (transform.modelMatrix * a.position).dotProduct(camDir) < (transform.modelMatrix * b.position).dotProduct(camDir);
-    };
-    std::sort(points.renderPoints.begin(), points.renderPoints.end(), comparePoints);
+    Vector3 axis;
+    float offset;
+    depthSortAxis(transform.modelMatrix, camDir, axis, offset);
+
+    size_t count = points.renderPoints.size();
+    depthKeys.resize(count);
+    for (size_t i = 0; i < count; i++){
+        depthKeys[i] = {floatToSortableKey(points.renderPoints[i].position.dotProduct(axis) + offset), (uint32_t)i};
+    }
+
+    if (!sortByKeys(points.renderPoints, pointsScratch, depthKeys, depthKeysScratch)){
+        return;
+    }
 
     if (points.loaded)
         points.needUpdateBuffer = true;
@@ -2042,10 +2238,16 @@ void RenderSystem::updateTerrain(TerrainComponent& terrain, Transform& transform
             terrain.nodesbuffer[s].clear();
         }
 
+        VertexWriter fullResNodes(terrain.nodesbuffer[0], {AttributeType::TERRAINNODEPOSITION, AttributeType::TERRAINNODESIZE, AttributeType::TERRAINNODERANGE, AttributeType::TERRAINNODERESOLUTION});
+        VertexWriter halfResNodes(terrain.nodesbuffer[1], {AttributeType::TERRAINNODEPOSITION, AttributeType::TERRAINNODESIZE, AttributeType::TERRAINNODERANGE, AttributeType::TERRAINNODERESOLUTION});
+
         for (int i = 0; i < (terrain.rootGridSize*terrain.rootGridSize); i++){
-            terrainNodeLODSelect(terrain, transform, camera, cameraTransform, terrain.nodes[terrain.grid[i]], terrain.levels-1);
+            terrainNodeLODSelect(terrain, transform, camera, cameraTransform, terrain.nodes[terrain.grid[i]], terrain.levels-1, fullResNodes, halfResNodes);
         }
 
+        fullResNodes.end();
+        halfResNodes.end();
+
         terrain.needUpdateNodesBuffer = true;
 
         terrain.eyePos = Vector3(cameraTransform.worldPosition.x, cameraTransform.worldPosition.y, cameraTransform.worldPosition.z);
@@ -2082,7 +2284,7 @@ bool RenderSystem::isTerrainNodeInSphere(Vector3 position, float radius, const A
     return dist2 <= r2;
 }
 
-bool RenderSystem::terrainNodeLODSelect(TerrainComponent& terrain, Transform& transform, CameraComponent& camera, Transform& cameraTransform, TerrainNode& terrainNode, int lodLevel){
+bool RenderSystem::terrainNodeLODSelect(TerrainComponent& terrain, Transform& transform, CameraComponent& camera, Transform& cameraTransform, TerrainNode& terrainNode, int lodLevel, VertexWriter& fullResNodes, VertexWriter& halfResNodes){
     terrainNode.currentRange = terrain.ranges[lodLevel];
 
     AABB box = getTerrainNodeAABB(transform, terrainNode);
@@ -2101,10 +2303,7 @@ bool RenderSystem::terrainNodeLODSelect(TerrainComponent& terrain, Transform& tr
         //Full resolution
         terrainNode.resolution = terrain.resolution;
         terrainNode.visible = true;
-        terrain.nodesbuffer[0].addVector2(AttributeType::TERRAINNODEPOSITION, terrainNode.position);
-        terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODESIZE, terrainNode.size);
-        terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODERANGE, terrainNode.currentRange);
-        terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODERESOLUTION, terrainNode.resolution);
+        fullResNodes.addVertex(terrainNode.position, terrainNode.size, terrainNode.currentRange, terrainNode.resolution);
 
         return true;
     } else {
@@ -2113,22 +2312,16 @@ bool RenderSystem::terrainNodeLODSelect(TerrainComponent& terrain, Transform& tr
             //Full resolution
             terrainNode.resolution = terrain.resolution;
             terrainNode.visible = true;
-            terrain.nodesbuffer[0].addVector2(AttributeType::TERRAINNODEPOSITION, terrainNode.position);
-            terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODESIZE, terrainNode.size);
-            terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODERANGE, terrainNode.currentRange);
-            terrain.nodesbuffer[0].addFloat(AttributeType::TERRAINNODERESOLUTION, terrainNode.resolution);
+            fullResNodes.addVertex(terrainNode.position, terrainNode.size, terrainNode.currentRange, terrainNode.resolution);
         } else {
             for (int i = 0; i < 4; i++) {
                 TerrainNode& child = terrain.nodes[terrainNode.childs[i]];
-                if (!terrainNodeLODSelect(terrain, transform, camera, cameraTransform, child, lodLevel-1)){
+                if (!terrainNodeLODSelect(terrain, transform, camera, cameraTransform, child, lodLevel-1, fullResNodes, halfResNodes)){
                     //Half resolution
                     child.resolution = terrain.resolution / 2;
                     child.currentRange = terrainNode.currentRange;
                     child.visible = true;
-                    terrain.nodesbuffer[1].addVector2(AttributeType::TERRAINNODEPOSITION, child.position);
-                    terrain.nodesbuffer[1].addFloat(AttributeType::TERRAINNODESIZE, child.size);
-                    terrain.nodesbuffer[1].addFloat(AttributeType::TERRAINNODERANGE, child.currentRange);
-                    terrain.nodesbuffer[1].addFloat(AttributeType::TERRAINNODERESOLUTION, child.resolution);
+                    halfResNodes.addVertex(child.position, child.size, child.currentRange, child.resolution);
                 }
             }
         }
@@ -2343,9 +2536,6 @@ void RenderSystem::updateCameraFrustumPlanes(const Matrix4 viewProjectionMatrix,
 }
 
 void RenderSystem::updateInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform){
-    instmesh.renderInstances.clear();
-    instmesh.renderInstances.reserve(instmesh.instances.size());
-
     Quaternion bRotation;
     if (instmesh.instancedBillboard){
         Vector3 camPos = camTransform.worldPosition;
@@ -2358,49 +2548,203 @@ void RenderSystem::updateInstancedMesh(InstancedMeshComponent& instmesh, MeshCom
         bRotation = transform.worldRotation.inverse() * bRotation;
     }
 
-    mesh.aabb = AABB::ZERO;
-    instmesh.numVisible = 0;
     size_t instancesSize = (instmesh.instances.size() < instmesh.maxInstances)? instmesh.instances.size() : instmesh.maxInstances;
-    for (int i = 0; i < instancesSize; i++){
-        if (instmesh.instances[i].visible){
-            Matrix4 translateMatrix = Matrix4::translateMatrix(instmesh.instances[i].position);
-            Matrix4 rotationMatrix;
-            Matrix4 scaleMatrix = Matrix4::scaleMatrix(instmesh.instances[i].scale);
-
-            if (instmesh.instancedBillboard){
-                rotationMatrix = bRotation.getRotationMatrix();
-            }else{
-                rotationMatrix = instmesh.instances[i].rotation.getRotationMatrix();
-            }
+    size_t numChunks = (instancesSize + instmesh.chunkSize - 1) / instmesh.chunkSize;
+
+    // billboard rotation depends on camera, so every instance changes
+    bool updateAll = instmesh.needUpdateInstances || instmesh.instancedBillboard;
 
-            Matrix4 instanceMatrix = translateMatrix * rotationMatrix * scaleMatrix;
+    instmesh.chunks.resize(numChunks);
+    instmesh.chunkInstances.resize(instancesSize);
 
-            instmesh.renderInstances.push_back({});
-            instmesh.renderInstances[instmesh.numVisible].instanceMatrix = instanceMatrix;
-            instmesh.renderInstances[instmesh.numVisible].color = instmesh.instances[i].color;
-            instmesh.renderInstances[instmesh.numVisible].textureRect = instmesh.instances[i].textureRect;
-            instmesh.numVisible++;
+    for (size_t c = 0; c < numChunks; c++){
+        InstanceChunk& chunk = instmesh.chunks[c];
+        unsigned int start = c * instmesh.chunkSize;
+        unsigned int count = std::min((size_t)instmesh.chunkSize, instancesSize - start);
 
-            mesh.aabb.merge(instanceMatrix * mesh.verticesAABB);
+        if (updateAll || chunk.start != start || chunk.count != count){
+            chunk.needUpdate = true;
         }
+        chunk.start = start;
+        chunk.count = count;
+    }
+
+    for (size_t index : instmesh.changedInstances){
+        if (index < instancesSize){
+            instmesh.chunks[index / instmesh.chunkSize].needUpdate = true;
+        }
+    }
+    instmesh.changedInstances.clear();
+
+    for (size_t c = 0; c < numChunks; c++){
+        InstanceChunk& chunk = instmesh.chunks[c];
+        if (!chunk.needUpdate)
+            continue;
+
+        chunk.aabb = AABB();
+        chunk.numVisible = 0;
+
+        for (size_t i = chunk.start; i < chunk.start + chunk.count; i++){
+            const InstanceData& instance = instmesh.instances[i];
+            if (instance.visible){
+                const Quaternion& rotation = instmesh.instancedBillboard ? bRotation : instance.rotation;
+
+                // visible instances packed from chunk start, ready to be copied in one block
+                InstanceRenderData& renderData = instmesh.chunkInstances[chunk.start + chunk.numVisible];
+                renderData.instanceMatrix = Matrix4::composeMatrix(instance.position, rotation, instance.scale);
+                renderData.color = instance.color;
+                renderData.textureRect = instance.textureRect;
+                chunk.numVisible++;
+
+                chunk.aabb.merge(renderData.instanceMatrix * mesh.verticesAABB);
+            }
+        }
+
+        chunk.needUpdate = false;
+    }
+
+    mesh.aabb = AABB::ZERO;
+    for (size_t c = 0; c < numChunks; c++){
+        mesh.aabb.merge(instmesh.chunks[c].aabb);
     }
 
     mesh.needUpdateAABB = true;
+}
+
+void RenderSystem::cullInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, bool instancesUpdated, bool useFrustum){
+    bool changed = instancesUpdated;
+
+    instmesh.instancesCulled = useFrustum;
+
+    for (size_t c = 0; c < instmesh.chunks.size(); c++){
+        InstanceChunk& chunk = instmesh.chunks[c];
+
+        bool inFrustum = (chunk.numVisible > 0);
+        if (inFrustum && useFrustum){
+            inFrustum = isInsideCamera(camera, transform.modelMatrix * chunk.aabb);
+        }
+
+        if (chunk.inFrustum != inFrustum){
+            chunk.inFrustum = inFrustum;
+            changed = true;
+        }
+    }
+
+    // same chunks and no instance changed, buffer already has this data
+    if (!changed)
+        return;
+
+    instmesh.renderInstances.clear();
+    instmesh.renderInstances.reserve(instmesh.chunkInstances.size());
+
+    for (size_t c = 0; c < instmesh.chunks.size(); c++){
+        const InstanceChunk& chunk = instmesh.chunks[c];
+        if (chunk.inFrustum){
+            auto first = instmesh.chunkInstances.begin() + chunk.start;
+            instmesh.renderInstances.insert(instmesh.renderInstances.end(), first, first + chunk.numVisible);
+        }
+    }
+
+    instmesh.numVisible = instmesh.renderInstances.size();
 
     if (mesh.loaded)
         instmesh.needUpdateBuffer = true;
 }
 
+void RenderSystem::cullTilemap(TilemapComponent& tilemap, MeshComponent& mesh, Transform& transform, CameraComponent& camera, bool meshLoaded, bool useFrustum){
+    bool changed = meshLoaded || tilemap.needUpdateIndices;
+
+    tilemap.chunksCulled = useFrustum;
+
+    for (size_t c = 0; c < tilemap.chunks.size(); c++){
+        TilemapChunk& chunk = tilemap.chunks[c];
+
+        bool inFrustum = !chunk.tiles.empty();
+        if (inFrustum && useFrustum){
+            inFrustum = isInsideCamera(camera, transform.modelMatrix * chunk.aabb);
+        }
+
+        if (chunk.inFrustum != inFrustum){
+            chunk.inFrustum = inFrustum;
+            changed = true;
+        }
+    }
+
+    // same chunks and no tile changed, index buffer already has this data
+    if (!changed)
+        return;
+
+    unsigned char* indices = mesh.indices.getData();
+    bool indices32 = (mesh.indices.getAttribute(AttributeType::INDEX)->getDataType() == AttributeDataType::UNSIGNED_INT);
+
+    // tiles of visible chunks packed from the start of each submesh index range
+    unsigned char* ranges[MAX_SUBMESHES];
+    unsigned int capacities[MAX_SUBMESHES];
+    unsigned int counts[MAX_SUBMESHES];
+    for (unsigned int s = 0; s < mesh.numSubmeshes; s++){
+        ranges[s] = nullptr;
+        capacities[s] = 0;
+        counts[s] = 0;
+
+        auto it = mesh.submeshes[s].attributes.find(AttributeType::INDEX);
+        if (indices && it != mesh.submeshes[s].attributes.end()){
+            ranges[s] = indices + it->second.getOffset();
+            capacities[s] = it->second.getCount();
+        }
+    }
+
+    // slot order keeps tiles drawing order, chunks only tell if a tile is visible
+    for (unsigned int i = 0; i < tilemap.tileChunks.size(); i++){
+        int c = tilemap.tileChunks[i];
+        if (c < 0 || !tilemap.chunks[c].inFrustum)
+            continue;
+
+        int s = tilemap.tileSubmeshes[i];
+        if (s < 0 || (unsigned int)s >= mesh.numSubmeshes || !ranges[s] || counts[s] + 6 > capacities[s])
+            continue;
+
+        uint32_t vertex = i * 4;
+        uint32_t quad[6] = {vertex, vertex + 1, vertex + 2, vertex, vertex + 2, vertex + 3};
+        if (indices32){
+            memcpy((uint32_t*)ranges[s] + counts[s], quad, sizeof(quad));
+        }else{
+            uint16_t* range = (uint16_t*)ranges[s] + counts[s];
+            for (int k = 0; k < 6; k++){
+                range[k] = (uint16_t)quad[k];
+            }
+        }
+        counts[s] += 6;
+    }
+
+    for (unsigned int s = 0; s < mesh.numSubmeshes; s++){
+        if (ranges[s]){
+            mesh.submeshes[s].vertexCount = counts[s];
+        }
+    }
+
+    tilemap.needUpdateIndices = false;
+
+    mesh.needUpdateBuffer = true;
+}
+
 void RenderSystem::sortInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform){
     Vector3 camDir = (camTransform.worldPosition - camera.worldTarget).normalize();
 
-    auto comparePoints = [&transform, &camDir](const InstanceRenderData& a, const InstanceRenderData& b) -> bool {
-        Vector3 positionA = Vector3(a.instanceMatrix[3][0], a.instanceMatrix[3][1], a.instanceMatrix[3][2]);
-        Vector3 positionB = Vector3(b.instanceMatrix[3][0], b.instanceMatrix[3][1], b.instanceMatrix[3][2]);
+    Vector3 axis;
+    float offset;
+    depthSortAxis(transform.modelMatrix, camDir, axis, offset);
 
-        return (transform.modelMatrix * positionA).dotProduct(camDir) < (transform.modelMatrix * positionB).dotProduct(camDir);
-    };
-    std::sort(instmesh.renderInstances.begin(), instmesh.renderInstances.end(), comparePoints);
+    size_t count = instmesh.renderInstances.size();
+    depthKeys.resize(count);
+    for (size_t i = 0; i < count; i++){
+        const Matrix4& instanceMatrix = instmesh.renderInstances[i].instanceMatrix;
+        float depth = instanceMatrix[3][0] * axis.x + instanceMatrix[3][1] * axis.y + instanceMatrix[3][2] * axis.z + offset;
+        depthKeys[i] = {floatToSortableKey(depth), (uint32_t)i};
+    }
+
+    if (!sortByKeys(instmesh.renderInstances, instancesScratch, depthKeys, depthKeysScratch)){
+        return;
+    }
 
     if (mesh.loaded)
         instmesh.needUpdateBuffer = true;
@@ -2707,7 +3051,7 @@ void RenderSystem::changeDestroy(void* data){
     delete (check_load_t*)data;
 }
 
-void RenderSystem::updateMVP(size_t index, Transform& transform, CameraComponent& camera, Transform& cameraTransform){
+void RenderSystem::updateBillboard(size_t index, Transform& transform, CameraComponent& camera, Transform& cameraTransform){
     if (transform.billboard && !transform.fakeBillboard){
 
         Vector3 camPos = cameraTransform.worldPosition;
@@ -2735,31 +3079,18 @@ void RenderSystem::updateMVP(size_t index, Transform& transform, CameraComponent
             if (transform.rotation != oldRotation){
                 transform.needUpdate = true;
 
-                std::vector<Entity> parentList;
-                auto transforms = scene->getComponentArray<Transform>();
-                for (int i = index; i < transforms->size(); i++){
-                    Transform& childTransform = transforms->getComponentFromIndex(i);
-
-                    // Finding childs
-                    if (i > index){
-                        if (std::find(parentList.begin(), parentList.end(), childTransform.parent) != parentList.end()){
-                            childTransform.needUpdate = true;
-                        }else{
-                            break;
-                        }
-                    }
-
-                    if (childTransform.needUpdate){
-                        Entity entity = transforms->getEntity(i);
-                        parentList.push_back(entity);
-                        updateTransform(childTransform);
-                    }
+                // entities can be created between update and draw
+                if (!checkTransformLinks()){
+                    updateTransformLinks();
                 }
+                updateTransformTree((uint32_t)index);
             }
         }
 
     }
+}
 
+void RenderSystem::updateModelViewProjection(Transform& transform, const CameraComponent& camera, const Transform& cameraTransform){
     if (transform.billboard && transform.fakeBillboard){
         
         Matrix4 modelViewMatrix = camera.viewMatrix * transform.modelMatrix;
@@ -2789,37 +3120,79 @@ void RenderSystem::updateMVP(size_t index, Transform& transform, CameraComponent
     transform.distanceToCamera = (cameraTransform.worldPosition - transform.worldPosition).length();
 }
 
-void RenderSystem::update(double dt){
-    if (paused) {
-        return;
+void RenderSystem::updateModelViewProjections(CameraComponent& camera, Transform& cameraTransform){
+    auto transforms = scene->getComponentArray<Transform>();
+
+    // rotating billboards can update child transforms, kept serial
+    for (size_t i = 0; i < transforms->size(); i++){
+        Transform& transform = transforms->getComponentFromIndex(i);
+        if (transform.billboard && !transform.fakeBillboard){
+            updateBillboard(i, transform, camera, cameraTransform);
+        }
     }
 
-    int numLights = checkLightsAndShadow();
+    parallelFor(transforms->size(), [&](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++){
+            updateModelViewProjection(transforms->getComponentFromIndex(i), camera, cameraTransform);
+        }
+    });
+}
 
+void RenderSystem::updateMeshesWorldAABB(){
+    auto meshes = scene->getComponentArray<MeshComponent>();
     auto transforms = scene->getComponentArray<Transform>();
-    auto cameras = scene->getComponentArray<CameraComponent>();
 
-    for (int i = 0; i < transforms->size(); i++){
-        Transform& transform = transforms->getComponentFromIndex(i);
+    parallelFor(meshes->size(), [&](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++){
+            MeshComponent& mesh = meshes->getComponentFromIndex(i);
+            if (mesh.needUpdateAABB){
+                Transform* transform = transforms->findComponent(meshes->getEntity(i));
+                if (transform){
+                    mesh.worldAABB = transform->modelMatrix * mesh.aabb;
+                }
+                mesh.needUpdateAABB = false;
+            }
+        }
+    });
+}
 
-        if (transform.parent != NULL_ENTITY){
-            Transform& transformParent = scene->getComponent<Transform>(transform.parent);
+void RenderSystem::updateMeshesVisibility(CameraComponent& camera){
+    auto meshes = scene->getComponentArray<MeshComponent>();
 
-            if (transformParent.needUpdate){
-                transform.needUpdate = true;
-            }
+    meshVisible.resize(meshes->size());
 
-            if (transformParent.needUpdateChildVisibility){
-                transform.visible = transformParent.visible;
-                transform.needUpdateChildVisibility = true;
-            }
+    parallelFor(meshes->size(), [&](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++){
+            const MeshComponent& mesh = meshes->getComponentFromIndex(i);
+            meshVisible[i] = (mesh.worldAABB == AABB::ZERO || isInsideCamera(camera, mesh.worldAABB)) ? 1 : 0;
         }
+    });
+}
 
-        if (transform.needUpdate){
-            updateTransform(transform);
+void RenderSystem::parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& func){
+    #ifndef NO_THREAD_SUPPORT
+        if (count > PARALLEL_CHUNK_SIZE){
+            ThreadPoolManager::getInstance().parallelFor(count, PARALLEL_CHUNK_SIZE, func);
+            return;
         }
+    #endif
+    func(0, count);
+}
+
+void RenderSystem::update(double dt){
+    if (paused) {
+        return;
     }
 
+    int numLights = checkLightsAndShadow();
+
+    auto transforms = scene->getComponentArray<Transform>();
+    auto cameras = scene->getComponentArray<CameraComponent>();
+
+    transformsUpdated = 0;
+    updatedTransforms.clear();
+    propagateTransforms();
+
     Entity mainCameraEntity = scene->getCamera();
     uint8_t pipelines = 0;
 
@@ -2886,6 +3259,8 @@ void RenderSystem::update(double dt){
         }
     }
 
+    transformNeedMVP.assign(transforms->size(), 0);
+
     for (int i = 0; i < transforms->size(); i++){
         Transform& transform = transforms->getComponentFromIndex(i);
 
@@ -2900,20 +3275,32 @@ void RenderSystem::update(double dt){
             InstancedMeshComponent* instmesh = scene->findComponent<InstancedMeshComponent>(entity);
             if (instmesh){
                 bool sortTransparentInstances = mesh.transparent && mainCamera.type != CameraType::CAMERA_UI;
+                bool instancesChanged = instmesh->needUpdateInstances || !instmesh->changedInstances.empty();
+                bool instancesUpdated = false;
 
-                if (instmesh->needUpdateInstances && !instmesh->instancedBillboard){
+                if (instancesChanged && !instmesh->instancedBillboard && !instmesh->externalRender){
                     updateInstancedMesh(*instmesh, mesh, transform, mainCamera, mainCameraTransform);
+                    instancesUpdated = true;
                 }
 
-                if (instmesh->needUpdateInstances || ((mainCamera.needUpdate || transform.needUpdate) && sortTransparentInstances)){
-                    if (!hasMultipleCameras || !sortTransparentInstances){
-                        if (instmesh->instancedBillboard){
-                            updateInstancedMesh(*instmesh, mesh, transform, mainCamera, mainCameraTransform);
-                        }
-                        sortInstancedMesh(*instmesh, mesh, transform, mainCamera, mainCameraTransform);
+                bool needSort = instancesChanged || ((mainCamera.needUpdate || transform.needUpdate) && sortTransparentInstances);
+                if (needSort && (!hasMultipleCameras || !sortTransparentInstances)){
+                    if (instmesh->instancedBillboard && !instmesh->externalRender){
+                        updateInstancedMesh(*instmesh, mesh, transform, mainCamera, mainCameraTransform);
+                        instancesUpdated = true;
                     }
                 }
 
+                // other cameras and shadow maps can see chunks outside main camera
+                bool cullInstances = instmesh->cullInstances && !hasMultipleCameras && !(hasShadows && mesh.castShadows);
+                if (!instmesh->externalRender && (instancesUpdated || mainCamera.needUpdate || transform.needUpdate || instmesh->instancesCulled != cullInstances)){
+                    cullInstancedMesh(*instmesh, mesh, transform, mainCamera, instancesUpdated, cullInstances);
+                }
+
+                if (needSort && (!hasMultipleCameras || !sortTransparentInstances)){
+                    sortInstancedMesh(*instmesh, mesh, transform, mainCamera, mainCameraTransform);
+                }
+
                 instmesh->needUpdateInstances = false;
             }
 
@@ -2946,12 +3333,23 @@ void RenderSystem::update(double dt){
             if (mesh.loaded && mesh.needReload){
                 destroyMesh(entity, mesh);
             }
+            bool meshLoaded = false;
             if (!mesh.loadCalled){
-                loadMesh(entity, mesh, pipelines, instmesh, terrain);
+                meshLoaded = loadMesh(entity, mesh, pipelines, instmesh, terrain);
             }
-            if (mesh.needUpdateAABB || transform.needUpdate){
-                mesh.worldAABB = transform.modelMatrix * mesh.aabb;
-                mesh.needUpdateAABB = false;
+
+            // after load, it sets submeshes vertex count to whole index ranges
+            TilemapComponent* tilemap = scene->findComponent<TilemapComponent>(entity);
+            if (tilemap && mesh.loadCalled){
+                // same indices are used by shadow maps, that also need tiles outside main camera
+                bool cullChunks = tilemap->cullChunks && !hasMultipleCameras && !(hasShadows && mesh.castShadows);
+                if (meshLoaded || tilemap->needUpdateIndices || mainCamera.needUpdate || transform.needUpdate || tilemap->chunksCulled != cullChunks){
+                    cullTilemap(*tilemap, mesh, transform, mainCamera, meshLoaded, cullChunks);
+                }
+            }
+            if (transform.needUpdate){
+                // world AABB is updated in parallel after this loop
+                mesh.needUpdateAABB = true;
             }
         }else if (signature.test(scene->getComponentId<UIComponent>())){
             UIComponent& ui = scene->getComponent<UIComponent>(entity);
@@ -3006,7 +3404,7 @@ void RenderSystem::update(double dt){
 
             bool sortTransparentPoints = points.transparent && mainCamera.type != CameraType::CAMERA_UI;
 
-            if (points.needUpdate){
+            if (points.needUpdate && !points.externalRender){
                 updatePoints(points, transform, mainCamera, mainCameraTransform);
             }
 
@@ -3041,7 +3439,8 @@ void RenderSystem::update(double dt){
 
             // need to be updated for every camera
             if (!hasMultipleCameras){
-                updateMVP(i, transform, mainCamera, mainCameraTransform);
+                updateBillboard(i, transform, mainCamera, mainCameraTransform);
+                transformNeedMVP[i] = 1;
 
                 if (signature.test(scene->getComponentId<TerrainComponent>())){
                     TerrainComponent& terrain = scene->getComponent<TerrainComponent>(entity);
@@ -3073,11 +3472,12 @@ void RenderSystem::update(double dt){
                     ModelComponent* model = scene->findComponent<ModelComponent>(bone.model);
                     MeshComponent* mesh = scene->findComponent<MeshComponent>(bone.model);
 
-                    if (model && mesh) {
+                    // compact pose writes bones matrices in MeshSystem
+                    if (model && mesh && model->pose.empty()) {
                         Matrix4 skinning = model->inverseDerivedTransform * transform.modelMatrix * bone.offsetMatrix;
 
                         if (bone.index >= 0 && bone.index < MAX_BONES)
-                            mesh->bonesMatrix[bone.index] = skinning;
+                            mesh->skinning->bonesMatrix[bone.index] = skinning;
                     }
                 }
             }
@@ -3088,6 +3488,18 @@ void RenderSystem::update(double dt){
         transform.needUpdate = false;
     }
 
+    updateMeshesWorldAABB();
+    if (!hasMultipleCameras){
+        // billboards were already rotated in the loop above
+        parallelFor(transforms->size(), [&](size_t begin, size_t end){
+            for (size_t i = begin; i < end; i++){
+                if (transformNeedMVP[i]){
+                    updateModelViewProjection(transforms->getComponentFromIndex(i), mainCamera, mainCameraTransform);
+                }
+            }
+        });
+    }
+
     for (int i = 0; i < cameras->size(); i++){
         CameraComponent& camera = cameras->getComponentFromIndex(i);
         if (camera.needUpdate){
@@ -3098,16 +3510,109 @@ void RenderSystem::update(double dt){
     processLights(numLights, mainCamera, mainCameraTransform);
 }
 
-void RenderSystem::draw(){
-    std::priority_queue<TransparentMeshesData, std::vector<TransparentMeshesData>, MeshComparison> transparentMeshes;
+uint16_t RenderSystem::getMaterialSortKey(const Submesh& submesh, const MeshComponent& mesh){
+    std::hash<std::string> hasher;
+    size_t key = hasher(submesh.material.baseColorTexture.getId());
+    key ^= hasher(submesh.material.metallicRoughnessTexture.getId()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= hasher(submesh.material.normalTexture.getId()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= hasher(submesh.material.occlusionTexture.getId()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= hasher(submesh.material.emissiveTexture.getId()) + 0x9e3779b9 + (key << 6) + (key >> 2);
+
+    // pipeline state in low bits, so same textures with other raster state stay close
+    uint16_t stateKey = (uint16_t)(((uint16_t)submesh.primitiveType << 3) | ((uint16_t)submesh.faceCulling << 2) |
+                                   ((uint16_t)mesh.cullingMode << 1) | (uint16_t)mesh.windingOrder);
+
+    return (uint16_t)(((key ^ (key >> 16) ^ (key >> 32)) << 5) | stateKey);
+}
+
+uint64_t RenderSystem::getOpaqueSortKey(const Submesh& submesh, const MeshComponent& mesh, float distanceToCamera){
+    // pass (2 bits) | shader (12 bits) | material (16 bits) | front to back depth (24 bits) | mesh (10 bits)
+    uint64_t shaderKey = (uint64_t)(uintptr_t)submesh.shader.get();
+    shaderKey = (shaderKey >> 4) ^ (shaderKey >> 16) ^ (shaderKey >> 28);
+
+    uint64_t depthKey = floatToSortableKey(distanceToCamera) >> 8;
+
+    uint64_t meshKey = (uint64_t)(uintptr_t)&mesh;
+    meshKey = (meshKey >> 4) ^ (meshKey >> 14) ^ (meshKey >> 24);
+
+    return ((uint64_t)DRAW_PASS_OPAQUE << 62) | ((shaderKey & 0xFFF) << 50) | ((uint64_t)submesh.materialKey << 34) | ((depthKey & 0xFFFFFF) << 10) | (meshKey & 0x3FF);
+}
+
+void RenderSystem::addDrawPacket(uint64_t key, const DrawPacket& packet){
+    // ordered packet closes the current run, opaque packets collected before it are sorted among themselves
+    uint32_t run = drawRun;
+    if ((key >> 62) == DRAW_PASS_ORDERED){
+        drawRun++;
+    }else if ((key >> 62) == DRAW_PASS_TRANSPARENT){
+        run = UINT32_MAX;
+    }
+
+    drawKeys.push_back({key, run, (uint32_t)drawPackets.size()});
+    drawPackets.push_back(packet);
+}
+
+void RenderSystem::submitDrawPackets(CameraComponent& camera, Transform& cameraTransform, bool renderToTexture){
+    // stable, packets with same key keep hierarchy order
+    radixSort(drawKeys, drawKeysScratch, [](const DrawKey& drawKey){ return drawKey.key; });
+    radixSort(drawKeys, drawKeysScratch, [](const DrawKey& drawKey){ return drawKey.run; });
+
+    // a failed submesh marks its mesh for reload, other submeshes of it are skipped like in drawMesh
+    std::vector<MeshComponent*> failedMeshes;
 
+    for (const DrawKey& drawKey : drawKeys){
+        DrawPacket& packet = drawPackets[drawKey.packet];
+
+        if (packet.type == DrawPacketType::SUBMESH && !failedMeshes.empty() &&
+            std::find(failedMeshes.begin(), failedMeshes.end(), packet.mesh) != failedMeshes.end()){
+            continue;
+        }
+
+        if (packet.hasScissor){
+            camera.render.applyScissor(packet.scissor);
+        }
+
+        switch (packet.type){
+            case DrawPacketType::MESH:
+                drawMesh(*packet.mesh, *packet.transform, camera, cameraTransform, renderToTexture, packet.instmesh, packet.terrain);
+                break;
+            case DrawPacketType::SUBMESH:
+                if (!drawSubmesh(*packet.mesh, packet.submesh, *packet.transform, renderToTexture, packet.instmesh, packet.terrain)){
+                    failedMeshes.push_back(packet.mesh);
+                }
+                break;
+            case DrawPacketType::UI:
+                drawUI(*packet.ui, *packet.transform, renderToTexture);
+                break;
+            case DrawPacketType::POINTS:
+                drawPoints(*packet.points, *packet.transform, cameraTransform, renderToTexture);
+                break;
+            case DrawPacketType::LINES:
+                drawLines(*packet.lines, *packet.transform, cameraTransform, renderToTexture);
+                break;
+        }
+
+        if (packet.hasScissor){
+            resetScissor(camera);
+        }
+    }
+}
+
+void RenderSystem::resetScissor(CameraComponent& camera){
+    if (!camera.renderToTexture){
+        camera.render.applyScissor(Rect(0, 0, System::instance().getScreenWidth(), System::instance().getScreenHeight()));
+    }else{
+        camera.render.applyScissor(Rect(0, 0, camera.framebuffer->getWidth(), camera.framebuffer->getHeight()));
+    }
+}
+
+void RenderSystem::draw(){
     auto transforms = scene->getComponentArray<Transform>();
+    auto meshes = scene->getComponentArray<MeshComponent>();
     auto cameras = scene->getComponentArray<CameraComponent>();
 
     //---------Depth shader----------
     if (hasShadows){
         auto lights = scene->getComponentArray<LightComponent>();
-        auto meshes = scene->getComponentArray<MeshComponent>();
         auto terrains = scene->getComponentArray<TerrainComponent>();
         
         for (int l = 0; l < lights->size(); l++){
@@ -3131,9 +3636,9 @@ void RenderSystem::draw(){
                     light.cameras[c].render.setClearColor(Vector4(1.0, 1.0, 1.0, 1.0));
 
                     light.cameras[c].render.startRenderPass(&light.framebuffer[fb], face);
-                    for (int i = 0; i < meshes->size(); i++){
-                        MeshComponent& mesh = meshes->getComponentFromIndex(i);
-                        Entity entity = meshes->getEntity(i);
+                    for (size_t i = 0; i < meshesView->size(); i++){
+                        MeshComponent& mesh = meshes->getComponentFromIndex(meshesView->getComponentIndex(i));
+                        Entity entity = meshesView->getEntity(i);
                         Transform* transform = scene->findComponent<Transform>(entity);
 
                         if (transform){
@@ -3213,8 +3718,14 @@ void RenderSystem::draw(){
             camera.render.startRenderPass(&camera.framebuffer->getRender());
         }
 
-        //---------Draw opaque meshes and UI----------
-        bool hasActiveScissor = false;
+        bool renderToTexture = camera.renderToTexture || Engine::getFramebuffer();
+
+        // opaque meshes are only reordered in 3D, 2D relies on hierarchy order
+        bool sortOpaque = (camera.type == CameraType::CAMERA_PERSPECTIVE);
+
+        drawPackets.clear();
+        drawKeys.clear();
+        drawRun = 0;
 
         //---------Draw sky----------
         auto skys = scene->getComponentArray<SkyComponent>();
@@ -3225,9 +3736,15 @@ void RenderSystem::draw(){
                 updateSkyViewProjection(sky, camera);
             }
 
-            drawSky(sky, camera.renderToTexture || Engine::getFramebuffer());
+            drawSky(sky, renderToTexture);
+        }
+
+        if (hasMultipleCameras){
+            updateModelViewProjections(camera, cameraTransform);
         }
+        updateMeshesVisibility(camera);
 
+        //---------Collect meshes, UI, points and lines----------
         for (int i = 0; i < transforms->size(); i++){
             Transform& transform = transforms->getComponentFromIndex(i);
             Entity entity = transforms->getEntity(i);
@@ -3237,11 +3754,10 @@ void RenderSystem::draw(){
                 continue;
             }
 
-            if (hasMultipleCameras){
-                updateMVP(i, transform, camera, cameraTransform);
-            }
+            DrawPacket packet = {};
+            packet.transform = &transform;
 
-            // apply scissor on UI
+            // scissor on UI
             if (signature.test(scene->getComponentId<UILayoutComponent>())){
                 UILayoutComponent& layout = scene->getComponent<UILayoutComponent>(entity);
 
@@ -3255,10 +3771,10 @@ void RenderSystem::draw(){
                         parentScissor = parentLayout.scissor;
                         if (!parentScissor.isZero()){
                             if (!layout.ignoreScissor){
-                                camera.render.applyScissor(parentScissor);
+                                packet.scissor = parentScissor;
                                 layout.scissor = parentScissor;
 
-                                hasActiveScissor = true;
+                                packet.hasScissor = true;
                             }
                         }
                     }
@@ -3268,7 +3784,7 @@ void RenderSystem::draw(){
                     ImageComponent& img = scene->getComponent<ImageComponent>(entity);
 
                     layout.scissor = getScissorRect(layout, img, transform, camera);
-                    if (hasActiveScissor){
+                    if (packet.hasScissor){
                         layout.scissor = layout.scissor.fitOnRect(parentScissor);
                     }
                 }
@@ -3277,15 +3793,16 @@ void RenderSystem::draw(){
             if (signature.test(scene->getComponentId<MeshComponent>())){
                 MeshComponent& mesh = scene->getComponent<MeshComponent>(entity);
 
-                if (transform.visible){
+                if (transform.visible && meshVisible[meshes->getIndex(entity)]){
 
                     InstancedMeshComponent* instmesh = scene->findComponent<InstancedMeshComponent>(entity);
                     if (instmesh){
                         bool sortTransparentInstances = mesh.transparent && camera.type != CameraType::CAMERA_UI;
 
                         if (hasMultipleCameras && sortTransparentInstances){
-                            if (instmesh->instancedBillboard){
+                            if (instmesh->instancedBillboard && !instmesh->externalRender){
                                 updateInstancedMesh(*instmesh, mesh, transform, camera, cameraTransform);
+                                cullInstancedMesh(*instmesh, mesh, transform, camera, true, false);
                             }
                             sortInstancedMesh(*instmesh, mesh, transform, camera, cameraTransform);
                         }
@@ -3296,23 +3813,39 @@ void RenderSystem::draw(){
                         updateTerrain(*terrain, transform, camera, cameraTransform);
                     }
 
+                    packet.mesh = &mesh;
+                    packet.instmesh = instmesh;
+                    packet.terrain = terrain;
+
                     if (!mesh.transparent || !camera.transparentSort){
-                        //Draw opaque meshes if transparency is not necessary
-                        drawMesh(mesh, transform, camera, cameraTransform, camera.renderToTexture || Engine::getFramebuffer(), instmesh, terrain);
+                        if (sortOpaque && !mesh.transparent && !packet.hasScissor){
+                            // one packet per visible submesh, grouped by shader
+                            if (prepareMeshDraw(mesh, camera, instmesh, terrain)){
+                                packet.type = DrawPacketType::SUBMESH;
+                                for (unsigned int s = 0; s < mesh.numSubmeshes; s++){
+                                    packet.submesh = s;
+                                    addDrawPacket(getOpaqueSortKey(mesh.submeshes[s], mesh, transform.distanceToCamera), packet);
+                                }
+                            }
+                        }else{
+                            packet.type = DrawPacketType::MESH;
+                            addDrawPacket((uint64_t)DRAW_PASS_ORDERED << 62, packet);
+                        }
                     }else{
-                        transparentMeshes.push({&mesh, instmesh, terrain, &transform, transform.distanceToCamera});
+                        // back to front
+                        packet.type = DrawPacketType::MESH;
+                        addDrawPacket(((uint64_t)DRAW_PASS_TRANSPARENT << 62) | ((uint64_t)(~floatToSortableKey(transform.distanceToCamera)) << 30), packet);
                     }
                 }
 
             }else if (signature.test(scene->getComponentId<UIComponent>())){
                 UIComponent& ui = scene->getComponent<UIComponent>(entity);
 
-                bool isText = false;
-                if (signature.test(scene->getComponentId<TextComponent>())){
-                    isText = true;
+                if (transform.visible){
+                    packet.type = DrawPacketType::UI;
+                    packet.ui = &ui;
+                    addDrawPacket((uint64_t)DRAW_PASS_ORDERED << 62, packet);
                 }
-                if (transform.visible)
-                    drawUI(ui, transform, camera.renderToTexture || Engine::getFramebuffer());
 
             }else if (signature.test(scene->getComponentId<PointsComponent>())){
                 PointsComponent& points = scene->getComponent<PointsComponent>(entity);
@@ -3323,36 +3856,26 @@ void RenderSystem::draw(){
                     sortPoints(points, transform, camera, cameraTransform);
                 }
 
-                if (transform.visible)
-                    drawPoints(points, transform, cameraTransform, camera.renderToTexture || Engine::getFramebuffer());
+                if (transform.visible){
+                    packet.type = DrawPacketType::POINTS;
+                    packet.points = &points;
+                    addDrawPacket((uint64_t)DRAW_PASS_ORDERED << 62, packet);
+                }
 
             }else if (signature.test(scene->getComponentId<LinesComponent>())){
                 LinesComponent& lines = scene->getComponent<LinesComponent>(entity);
 
-                if (transform.visible)
-                    drawLines(lines, transform, cameraTransform, camera.renderToTexture || Engine::getFramebuffer());
-
-            }
-
-            if (hasActiveScissor){
-                if (!camera.renderToTexture){
-                    camera.render.applyScissor(Rect(0, 0, System::instance().getScreenWidth(), System::instance().getScreenHeight()));
-                }else{
-                    camera.render.applyScissor(Rect(0, 0, camera.framebuffer->getWidth(), camera.framebuffer->getHeight()));
+                if (transform.visible){
+                    packet.type = DrawPacketType::LINES;
+                    packet.lines = &lines;
+                    addDrawPacket((uint64_t)DRAW_PASS_ORDERED << 62, packet);
                 }
-                hasActiveScissor = false;
+
             }
         }
 
-        //---------Draw transparent meshes----------
-        while (!transparentMeshes.empty()){
-            TransparentMeshesData meshData = transparentMeshes.top();
-
-            //Draw transparent meshes
-            drawMesh(*meshData.mesh, *meshData.transform, camera, cameraTransform, camera.renderToTexture || Engine::getFramebuffer(), meshData.instmesh, meshData.terrain);
-
-            transparentMeshes.pop();
-        }
+        //---------Draw opaque, ordered and transparent packets----------
+        submitDrawPackets(camera, cameraTransform, renderToTexture);
 
         camera.render.endRenderPass();
 
@@ -3382,6 +3905,8 @@ void RenderSystem::draw(){
 void RenderSystem::onComponentAdded(Entity entity, ComponentId componentId) {
     if (componentId == scene->getComponentId<LightComponent>()) {
         needReloadMeshes();
+    } else if (componentId == scene->getComponentId<Transform>()) {
+        needUpdateTransformLinks = true;
     }
 }
 
@@ -3408,5 +3933,7 @@ void RenderSystem::onComponentRemoved(Entity entity, ComponentId componentId) {
     } else if (componentId == scene->getComponentId<CameraComponent>()) {
         CameraComponent& camera = scene->getComponent<CameraComponent>(entity);
         destroyCamera(camera, true);
+    } else if (componentId == scene->getComponentId<Transform>()) {
+        needUpdateTransformLinks = true;
     }
 }
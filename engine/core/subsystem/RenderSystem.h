@@ -18,16 +18,20 @@
 #include "component/PointsComponent.h"
 #include "component/LinesComponent.h"
 #include "component/TerrainComponent.h"
+#include "component/TilemapComponent.h"
 #include "component/SpriteComponent.h"
 #include "component/Transform.h"
 #include "render/ObjectRender.h"
 #include "render/CameraRender.h"
 #include "render/BufferRender.h"
 #include "render/FramebufferRender.h"
+#include "buffer/VertexWriter.h"
+#include "util/RadixSort.h"
 #include "Engine.h"
 #include <map>
 #include <memory>
-#include <queue>
+#include <vector>
+#include <functional>
 
 namespace doriax{
 	typedef struct fs_lighting_t {
@@ -66,18 +70,50 @@ namespace doriax{
 
 	class DORIAX_API RenderSystem : public SubSystem {
 	private:
-		struct TransparentMeshesData{
+		enum class DrawPacketType{
+			MESH,
+			SUBMESH,
+			UI,
+			POINTS,
+			LINES
+		};
+
+		// Deferred draw of a camera pass, submitted in key order
+		struct DrawPacket{
+			DrawPacketType type;
+			Transform* transform;
 			MeshComponent* mesh;
+			UIComponent* ui;
+			PointsComponent* points;
+			LinesComponent* lines;
 			InstancedMeshComponent* instmesh;
 			TerrainComponent* terrain;
-			Transform* transform;
-			float distanceToCamera;
+			unsigned int submesh;
+			bool hasScissor;
+			Rect scissor;
+		};
+
+		struct DrawKey{
+			uint64_t key;
+			uint32_t run; // keeps hierarchy order between ordered packets, key only sorts inside a run
+			uint32_t packet;
+		};
+
+		// Hierarchy of the Transform array by dense index, parents always come before children
+		struct TransformLinks{
+			uint32_t parent;
+			uint32_t firstChild;
+			uint32_t nextSibling;
+			uint32_t visited; // frame stamp of last propagation
 		};
 
-		struct MeshComparison{
-			bool operator()(const TransparentMeshesData& lhs, const TransparentMeshesData& rhs) const{
-				return lhs.distanceToCamera < rhs.distanceToCamera;
-			}
+		static const uint32_t NULL_TRANSFORM_INDEX = UINT32_MAX;
+
+		// 2 high bits of sort key
+		enum DrawPass : uint64_t{
+			DRAW_PASS_OPAQUE = 0,
+			DRAW_PASS_ORDERED = 1,
+			DRAW_PASS_TRANSPARENT = 2
 		};
 
 		Scene* scene;
@@ -103,10 +139,53 @@ namespace doriax{
 		fs_shadows_t fs_shadows;
 		fs_fog_t fs_fog;
 
+		std::shared_ptr<EntityView> meshesView;
+
+		// reused by every camera pass
+		std::vector<DrawPacket> drawPackets;
+		std::vector<DrawKey> drawKeys;
+		std::vector<DrawKey> drawKeysScratch;
+		uint32_t drawRun;
+
+		// depth sort of transparent points and instances
+		std::vector<SortKey> depthKeys;
+		std::vector<SortKey> depthKeysScratch;
+		std::vector<PointRenderData> pointsScratch;
+		std::vector<InstanceRenderData> instancesScratch;
+
+		// side arrays filled in parallel: by Transform index and by MeshComponent index
+		std::vector<uint8_t> transformNeedMVP;
+		std::vector<uint8_t> meshVisible;
+
+		// same index as Transform array, rebuilt when array order or parents change
+		std::vector<TransformLinks> transformLinks;
+		std::vector<uint32_t> dirtyTransforms;
+		std::vector<uint32_t> transformStack;
+		uint32_t transformLinksVersion;
+		uint32_t transformFrame;
+		bool needUpdateTransformLinks;
+		size_t transformsUpdated;
+		// entities with world transform recomputed in last update
+		std::vector<Entity> updatedTransforms;
+
 		static void changeLoaded(void* data);
 		static void changeDestroy(void* data);
 
-		void updateMVP(size_t index, Transform& transform, CameraComponent& camera, Transform& cameraTransform);
+		// minimum items per job when splitting dense component arrays
+		static const size_t PARALLEL_CHUNK_SIZE = 256;
+
+		void updateTransformLinks();
+		bool checkTransformLinks();
+		void propagateTransforms();
+		void updateTransformTree(uint32_t root);
+		void updateTransform(Transform& transform, const Transform* transformParent);
+
+		void updateBillboard(size_t index, Transform& transform, CameraComponent& camera, Transform& cameraTransform);
+		void updateModelViewProjection(Transform& transform, const CameraComponent& camera, const Transform& cameraTransform);
+		void updateModelViewProjections(CameraComponent& camera, Transform& cameraTransform);
+		void updateMeshesWorldAABB();
+		void updateMeshesVisibility(CameraComponent& camera);
+		void parallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& func);
 
 		void createEmptyTextures();
 		int checkLightsAndShadow();
@@ -126,15 +205,24 @@ namespace doriax{
 		Rect getScissorRect(UILayoutComponent& layout, ImageComponent& img, Transform& transform, CameraComponent& camera);
 
 		// terrain
-		bool terrainNodeLODSelect(TerrainComponent& terrain, Transform& transform, CameraComponent& camera, Transform& cameraTransform, TerrainNode& terrainNode, int lodLevel);
+		bool terrainNodeLODSelect(TerrainComponent& terrain, Transform& transform, CameraComponent& camera, Transform& cameraTransform, TerrainNode& terrainNode, int lodLevel, VertexWriter& fullResNodes, VertexWriter& halfResNodes);
 		AABB getTerrainNodeAABB(Transform& transform, TerrainNode& terrainNode);
 		bool isTerrainNodeInSphere(Vector3 position, float radius, const AABB& box);
 
 		float lerp(float a, float b, float fraction);
 
+		// draw list
+		static uint16_t getMaterialSortKey(const Submesh& submesh, const MeshComponent& mesh);
+		uint64_t getOpaqueSortKey(const Submesh& submesh, const MeshComponent& mesh, float distanceToCamera);
+		void addDrawPacket(uint64_t key, const DrawPacket& packet);
+		void submitDrawPackets(CameraComponent& camera, Transform& cameraTransform, bool renderToTexture);
+		void resetScissor(CameraComponent& camera);
+
 	protected:
 
 		bool drawMesh(MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform, bool renderToTexture, InstancedMeshComponent* instmesh, TerrainComponent* terrain);
+		bool prepareMeshDraw(MeshComponent& mesh, CameraComponent& camera, InstancedMeshComponent* instmesh, TerrainComponent* terrain);
+		bool drawSubmesh(MeshComponent& mesh, unsigned int index, Transform& transform, bool renderToTexture, InstancedMeshComponent* instmesh, TerrainComponent* terrain);
 		bool drawMeshDepth(MeshComponent& mesh, const float cameraFar, const Plane frustumPlanes[6], vs_depth_t vsDepthParams, InstancedMeshComponent* instmesh, TerrainComponent* terrain);
 		void destroyMesh(Entity entity, MeshComponent& mesh);
 
@@ -159,6 +247,10 @@ namespace doriax{
 		void updateTerrain(TerrainComponent& terrain, Transform& transform, CameraComponent& camera, Transform& cameraTransform);
 		void updateCameraFrustumPlanes(const Matrix4 viewProjectionMatrix, Plane* frustumPlanes);
 		void updateInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform);
+		void cullInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, bool instancesUpdated, bool useFrustum);
+		void cullTilemap(TilemapComponent& tilemap, MeshComponent& mesh, Transform& transform, CameraComponent& camera, bool meshLoaded, bool useFrustum);
+
+		void depthSortAxis(const Matrix4& modelMatrix, const Vector3& camDir, Vector3& axis, float& offset);
 
 		void sortPoints(PointsComponent& points, Transform& transform, CameraComponent& camera, Transform& camTransform);
 		void sortInstancedMesh(InstancedMeshComponent& instmesh, MeshComponent& mesh, Transform& transform, CameraComponent& camera, Transform& camTransform);
@@ -185,6 +277,9 @@ namespace doriax{
 		bool isInsideCamera(CameraComponent& camera, const Vector3& point);
 		bool isInsideCamera(CameraComponent& camera, const Vector3& center, const float& radius);
 
+		// points size in pixels to canvas size
+		static float getPointSizeScale();
+
 		void needReloadPoints();
 		void needReloadLines();
 		void needReloadMeshes();
@@ -192,6 +287,11 @@ namespace doriax{
 		void needReloadSky();
 
 		bool isAllLoaded() const;
+
+		// number of transforms recomputed in the last frame
+		size_t getTransformsUpdated() const;
+		// systems updated after this one can react only to changed transforms
+		const std::vector<Entity>& getUpdatedTransforms() const;
 	
 		void load() override;
 		void draw() override;
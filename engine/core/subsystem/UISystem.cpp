@@ -19,6 +19,8 @@ using namespace doriax;
 UISystem::UISystem(Scene* scene): SubSystem(scene){
     signature.set(scene->getComponentId<UILayoutComponent>());
 
+    layoutsView = scene->getView<UILayoutComponent, Transform>();
+
     eventId.clear();
     lastUIFromPointer = NULL_ENTITY;
     lastPanelFromPointer = NULL_ENTITY;
@@ -1777,40 +1779,38 @@ bool UISystem::eventOnPointerDown(float x, float y){
 
     auto layouts = scene->getComponentArray<UILayoutComponent>();
 
-    for (int i = 0; i < layouts->size(); i++){
-        UILayoutComponent& layout = layouts->getComponentFromIndex(i);
+    for (size_t i = 0; i < layoutsView->size(); i++){
+        UILayoutComponent& layout = layouts->getComponentFromIndex(layoutsView->getComponentIndex(i));
 
-        Entity entity = layouts->getEntity(i);
-        Signature signature = scene->getSignature(entity);
-        if (signature.test(scene->getComponentId<Transform>())){
-            Transform& transform = scene->getComponent<Transform>(entity);
+        Entity entity = layoutsView->getEntity(i);
+        Signature signature = layoutsView->getSignature(i);
+        Transform& transform = scene->getComponent<Transform>(entity);
 
-            if (transform.visible){
-                if (signature.test(scene->getComponentId<ImageComponent>())){
-                    Rect uirect(transform.worldPosition.x, transform.worldPosition.y, layout.width * transform.worldScale.x, layout.height * transform.worldScale.y);
+        if (transform.visible){
+            if (signature.test(scene->getComponentId<ImageComponent>())){
+                Rect uirect(transform.worldPosition.x, transform.worldPosition.y, layout.width * transform.worldScale.x, layout.height * transform.worldScale.y);
 
-                    if (layout.panel != NULL_ENTITY){
-                        uirect = fitOnPanel(uirect, layout.panel);
-                    }
+                if (layout.panel != NULL_ENTITY){
+                    uirect = fitOnPanel(uirect, layout.panel);
+                }
 
-                    if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){ //TODO: inside to polygon
-                        lastUIFromPointer = entity;
-                        lastPanelFromPointer = layout.panel;
-                    }
+                if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){ //TODO: inside to polygon
+                    lastUIFromPointer = entity;
+                    lastPanelFromPointer = layout.panel;
+                }
 
-                    if (signature.test(scene->getComponentId<PanelComponent>())){
-                        if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){
-                            lastPanelFromPointer = entity;
-                        }
+                if (signature.test(scene->getComponentId<PanelComponent>())){
+                    if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){
+                        lastPanelFromPointer = entity;
                     }
                 }
+            }
 
-                if (signature.test(scene->getComponentId<UIComponent>())){
-                    UIComponent& ui = scene->getComponent<UIComponent>(entity);
-                    if (ui.focused){
-                        ui.focused = false;
-                        ui.onLostFocus.call();
-                    }
+            if (signature.test(scene->getComponentId<UIComponent>())){
+                UIComponent& ui = scene->getComponent<UIComponent>(entity);
+                if (ui.focused){
+                    ui.focused = false;
+                    ui.onLostFocus.call();
                 }
             }
         }
@@ -1926,12 +1926,12 @@ bool UISystem::eventOnPointerUp(float x, float y){
     lastPointerPos = Vector2(-1, -1);
 
     auto layouts = scene->getComponentArray<UILayoutComponent>();
-    for (int i = 0; i < layouts->size(); i++){
-        UILayoutComponent& layout = layouts->getComponentFromIndex(i);
+    for (size_t i = 0; i < layoutsView->size(); i++){
+        UILayoutComponent& layout = layouts->getComponentFromIndex(layoutsView->getComponentIndex(i));
 
-        Entity entity = layouts->getEntity(i);
-        Signature signature = scene->getSignature(entity);
-        if (signature.test(scene->getComponentId<Transform>()) && signature.test(scene->getComponentId<UIComponent>())){
+        Entity entity = layoutsView->getEntity(i);
+        Signature signature = layoutsView->getSignature(i);
+        if (signature.test(scene->getComponentId<UIComponent>())){
             Transform& transform = scene->getComponent<Transform>(entity);
             UIComponent& ui = scene->getComponent<UIComponent>(entity);
 
@@ -1984,54 +1984,52 @@ bool UISystem::eventOnPointerMove(float x, float y){
 
     CursorType cursor = CursorType::ARROW;
 
-    for (int i = 0; i < layouts->size(); i++){
-        UILayoutComponent& layout = layouts->getComponentFromIndex(i);
+    for (size_t i = 0; i < layoutsView->size(); i++){
+        UILayoutComponent& layout = layouts->getComponentFromIndex(layoutsView->getComponentIndex(i));
 
-        Entity entity = layouts->getEntity(i);
-        Signature signature = scene->getSignature(entity);
-        if (signature.test(scene->getComponentId<Transform>())){
-            Transform& transform = scene->getComponent<Transform>(entity);
+        Entity entity = layoutsView->getEntity(i);
+        Signature signature = layoutsView->getSignature(i);
+        Transform& transform = scene->getComponent<Transform>(entity);
 
-            if (transform.visible){
-                if (signature.test(scene->getComponentId<ImageComponent>())){
-                    Rect uirect(transform.worldPosition.x, transform.worldPosition.y, layout.width * transform.worldScale.x, layout.height * transform.worldScale.y);
+        if (transform.visible){
+            if (signature.test(scene->getComponentId<ImageComponent>())){
+                Rect uirect(transform.worldPosition.x, transform.worldPosition.y, layout.width * transform.worldScale.x, layout.height * transform.worldScale.y);
 
-                    if (layout.panel != NULL_ENTITY){
-                        uirect = fitOnPanel(uirect, layout.panel);
-                    }
+                if (layout.panel != NULL_ENTITY){
+                    uirect = fitOnPanel(uirect, layout.panel);
+                }
 
-                    if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){
-                        cursor = CursorType::ARROW;
-
-                        if (signature.test(scene->getComponentId<TextEditComponent>())){
-                            cursor = CursorType::IBEAM;
-
-                        }else if (signature.test(scene->getComponentId<PanelComponent>())){
-                            PanelComponent& panel = scene->getComponent<PanelComponent>(entity);
-
-                            UILayoutComponent& layout = scene->getComponent<UILayoutComponent>(entity);
-                            Transform& transform = scene->getComponent<Transform>(entity);
-                            UILayoutComponent& headerlayout = scene->getComponent<UILayoutComponent>(panel.headercontainer);
-
-                            Rect edgeRight;
-                            Rect edgeRightBottom;
-                            Rect edgeBottom;
-                            Rect edgeLeftBottom;
-                            Rect edgeLeft;
-                            getPanelEdges(panel, layout, transform, headerlayout, edgeRight, edgeRightBottom, edgeBottom, edgeLeftBottom, edgeLeft);
-
-                            if (panel.canResize){
-                                if (edgeRight.contains(Vector2(x, y))){
-                                    cursor = CursorType::RESIZE_EW;
-                                }else if (edgeRightBottom.contains(Vector2(x, y))){
-                                    cursor = CursorType::RESIZE_NWSE;
-                                }else if (edgeBottom.contains(Vector2(x, y))){
-                                    cursor = CursorType::RESIZE_NS;
-                                }else if (edgeLeftBottom.contains(Vector2(x, y))){
-                                    cursor = CursorType::RESIZE_NESW;
-                                }else if (edgeLeft.contains(Vector2(x, y))){
-                                    cursor = CursorType::RESIZE_EW;
-                                }
+                if (uirect.contains(Vector2(x, y)) && !layout.ignoreEvents){
+                    cursor = CursorType::ARROW;
+
+                    if (signature.test(scene->getComponentId<TextEditComponent>())){
+                        cursor = CursorType::IBEAM;
+
+                    }else if (signature.test(scene->getComponentId<PanelComponent>())){
+                        PanelComponent& panel = scene->getComponent<PanelComponent>(entity);
+
+                        UILayoutComponent& layout = scene->getComponent<UILayoutComponent>(entity);
+                        Transform& transform = scene->getComponent<Transform>(entity);
+                        UILayoutComponent& headerlayout = scene->getComponent<UILayoutComponent>(panel.headercontainer);
+
+                        Rect edgeRight;
+                        Rect edgeRightBottom;
+                        Rect edgeBottom;
+                        Rect edgeLeftBottom;
+                        Rect edgeLeft;
+                        getPanelEdges(panel, layout, transform, headerlayout, edgeRight, edgeRightBottom, edgeBottom, edgeLeftBottom, edgeLeft);
+
+                        if (panel.canResize){
+                            if (edgeRight.contains(Vector2(x, y))){
+                                cursor = CursorType::RESIZE_EW;
+                            }else if (edgeRightBottom.contains(Vector2(x, y))){
+                                cursor = CursorType::RESIZE_NWSE;
+                            }else if (edgeBottom.contains(Vector2(x, y))){
+                                cursor = CursorType::RESIZE_NS;
+                            }else if (edgeLeftBottom.contains(Vector2(x, y))){
+                                cursor = CursorType::RESIZE_NESW;
+                            }else if (edgeLeft.contains(Vector2(x, y))){
+                                cursor = CursorType::RESIZE_EW;
                             }
                         }
                     }
@@ -27,6 +27,7 @@ namespace doriax{
     private:
 
         std::string eventId;
+        std::shared_ptr<EntityView> layoutsView;
         Entity lastUIFromPointer;
         Entity lastPanelFromPointer;
         Vector2 lastPointerPos;
@@ -497,6 +497,10 @@ void Texture::releaseData(){
     }
 }
 
+bool Texture::hasData() const{
+    return data && data->at(0).getData();
+}
+
 bool Texture::empty() const{
     if (!needLoad && !data && !render && !framebuffer)
         return true;
@@ -86,6 +86,7 @@ namespace doriax{
             bool isReleaseDataAfterLoad() const;
 
             void releaseData();
+            bool hasData() const;
 
             bool empty() const;
             bool isFramebuffer() const;
@@ -4,14 +4,19 @@
 
 #include "ThreadPoolManager.h"
 
+#include <algorithm>
+
 using namespace doriax;
 
 std::unique_ptr<ThreadPoolManager> ThreadPoolManager::instance = nullptr;
 std::mutex ThreadPoolManager::instanceMutex;
 
+static thread_local int workerIndex = -1;
+
 ThreadPoolManager::ThreadPoolManager(size_t numThreads) {
     for(size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back([this] {
+        workers.emplace_back([this, i] {
+            workerIndex = (int)i;
             for(;;) {
                 std::function<void()> task;
                 {
@@ -47,6 +52,76 @@ void ThreadPoolManager::initialize(size_t maxThreads) {
     }
 }
 
+void ThreadPoolManager::parallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t begin, size_t end)>& func) {
+    if (count == 0) {
+        return;
+    }
+
+    // few chunks per thread to balance uneven work
+    size_t numThreads = workers.size() + 1;
+    size_t chunkSize = std::max(std::max(minChunkSize, (size_t)1), (count + numThreads * 4 - 1) / (numThreads * 4));
+    size_t numChunks = (count + chunkSize - 1) / chunkSize;
+
+    if (numChunks <= 1 || workers.empty() || stop) {
+        func(0, count);
+        return;
+    }
+
+    struct ParallelForState {
+        std::atomic<size_t> nextChunk{0};
+        std::atomic<size_t> doneChunks{0};
+        size_t numChunks;
+        size_t chunkSize;
+        size_t count;
+        const std::function<void(size_t, size_t)>* func;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    // shared because helper tasks can start after this call returned, they find no chunks left
+    auto state = std::make_shared<ParallelForState>();
+    state->numChunks = numChunks;
+    state->chunkSize = chunkSize;
+    state->count = count;
+    state->func = &func;
+
+    auto runChunks = [](ParallelForState& s) {
+        size_t chunk;
+        while ((chunk = s.nextChunk.fetch_add(1)) < s.numChunks) {
+            size_t begin = chunk * s.chunkSize;
+            size_t end = std::min(begin + s.chunkSize, s.count);
+            (*s.func)(begin, end);
+
+            if (s.doneChunks.fetch_add(1) + 1 == s.numChunks) {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.done.notify_all();
+            }
+        }
+    };
+
+    size_t numHelpers = std::min(workers.size(), numChunks - 1);
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        for (size_t i = 0; i < numHelpers; i++) {
+            tasks.emplace([state, runChunks]() { runChunks(*state); });
+        }
+    }
+    condition.notify_all();
+
+    runChunks(*state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->doneChunks.load() == state->numChunks; });
+}
+
+size_t ThreadPoolManager::getNumThreads() const {
+    return workers.size();
+}
+
+int ThreadPoolManager::getWorkerIndex() {
+    return workerIndex;
+}
+
 size_t ThreadPoolManager::getQueueSize() const {
     std::lock_guard<std::mutex> lock(queueMutex);  // Now works because queueMutex is mutable
     return tasks.size();
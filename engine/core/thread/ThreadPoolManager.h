@@ -13,6 +13,8 @@
 #include <future>
 #include <functional>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 namespace doriax {
 
@@ -39,7 +41,14 @@ namespace doriax {
         auto enqueue(F&& f, Args&&... args) 
             -> std::future<std::invoke_result_t<F, Args...>>;
             
+        // Splits [0, count) in chunks processed by workers and the calling thread, returns when all are done.
+        // Calling thread also takes chunks, so it never waits on unrelated queued tasks.
+        void parallelFor(size_t count, size_t minChunkSize, const std::function<void(size_t begin, size_t end)>& func);
+
         size_t getQueueSize() const;
+        size_t getNumThreads() const;
+        // index of the calling worker in [0, getNumThreads()), -1 for threads outside the pool
+        static int getWorkerIndex();
         ~ThreadPoolManager();
     };
 
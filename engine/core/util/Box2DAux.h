@@ -8,6 +8,14 @@
 
 #include "box2d/box2d.h"
 #include "subsystem/PhysicsSystem.h"
+#ifndef NO_THREAD_SUPPORT
+#include "thread/ThreadPoolManager.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 namespace doriax{
 
@@ -25,6 +33,139 @@ namespace doriax{
     } Box2DWorldRayCastContext;
 
 
+    // Runs Box2D tasks on the engine thread pool.
+    // Items are claimed in chunks from a shared counter, so idle workers take what busy ones did not reach.
+    // Worker index 0 belongs to the stepping thread, it runs whatever is left when finishing a task,
+    // so a step never waits for pool threads busy with unrelated work.
+    class Box2DTaskScheduler{
+    private:
+        struct Task{
+            b2TaskCallback* callback;
+            void* context;
+            int32_t itemCount;
+            int32_t chunkSize;
+            std::atomic<int32_t> nextItem{0};
+            std::atomic<int32_t> doneItems{0};
+        };
+
+        int32_t workerCount;
+        bool mainThreadOnly = false;
+        // bit set for each free worker index used by pool threads,
+        // shared with queued helpers so they can outlive the scheduler
+        std::shared_ptr<std::atomic<uint64_t>> freeWorkers;
+
+        static void runTask(Task& task, uint32_t workerIndex){
+            while (true){
+                int32_t start = task.nextItem.fetch_add(task.chunkSize);
+                if (start >= task.itemCount){
+                    break;
+                }
+                int32_t end = std::min(start + task.chunkSize, task.itemCount);
+
+                task.callback(start, end, workerIndex, task.context);
+
+                task.doneItems.fetch_add(end - start);
+            }
+        }
+
+        static bool acquireWorker(std::atomic<uint64_t>& freeWorkers, uint32_t& workerIndex){
+            uint64_t free = freeWorkers.load();
+            while (free != 0){
+                uint32_t index = 0;
+                while (!(free & (uint64_t(1) << index))){
+                    index++;
+                }
+                if (freeWorkers.compare_exchange_weak(free, free & ~(uint64_t(1) << index))){
+                    workerIndex = index;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void releaseWorker(std::atomic<uint64_t>& freeWorkers, uint32_t workerIndex){
+            freeWorkers.fetch_or(uint64_t(1) << workerIndex);
+        }
+
+        static void runHelper(std::atomic<uint64_t>& freeWorkers, Task& task){
+            // all indices in use, the other runners and finishTask complete the work
+            uint32_t workerIndex;
+            if (task.nextItem.load() < task.itemCount && acquireWorker(freeWorkers, workerIndex)){
+                runTask(task, workerIndex);
+                releaseWorker(freeWorkers, workerIndex);
+            }
+        }
+
+    public:
+        static constexpr int32_t MAX_WORKERS = 64;
+
+        explicit Box2DTaskScheduler(int32_t workerCount){
+            this->workerCount = std::max(1, std::min(workerCount, MAX_WORKERS));
+
+            uint64_t free = 0;
+            for (int32_t i = 1; i < this->workerCount; i++){
+                free |= uint64_t(1) << i;
+            }
+            freeWorkers = std::make_shared<std::atomic<uint64_t>>(free);
+        }
+
+        int32_t getWorkerCount() const{
+            return workerCount;
+        }
+
+        // tasks are not sent to the pool, they run on the thread stepping the world
+        void setMainThreadOnly(bool mainThreadOnly){
+            this->mainThreadOnly = mainThreadOnly;
+        }
+
+        bool isMainThreadOnly() const{
+            return mainThreadOnly;
+        }
+
+        static void* enqueueTask(b2TaskCallback* callback, int32_t itemCount, int32_t minRange, void* taskContext, void* userContext){
+            Box2DTaskScheduler* scheduler = (Box2DTaskScheduler*)userContext;
+
+            #ifndef NO_THREAD_SUPPORT
+            if (itemCount > 0 && scheduler->workerCount > 1 && !scheduler->mainThreadOnly){
+                std::shared_ptr<Task> task = std::make_shared<Task>();
+                task->callback = callback;
+                task->context = taskContext;
+                task->itemCount = itemCount;
+                int32_t perWorker = (itemCount + scheduler->workerCount - 1) / scheduler->workerCount;
+                task->chunkSize = std::max(std::max(minRange, 1), perWorker);
+
+                int32_t chunks = (itemCount + task->chunkSize - 1) / task->chunkSize;
+                int32_t helpers = std::min(chunks, scheduler->workerCount - 1);
+
+                ThreadPoolManager& pool = ThreadPoolManager::getInstance();
+                std::shared_ptr<std::atomic<uint64_t>> freeWorkers = scheduler->freeWorkers;
+                for (int32_t i = 0; i < helpers; i++){
+                    pool.enqueue([freeWorkers, task](){
+                        runHelper(*freeWorkers, *task);
+                    });
+                }
+
+                return new std::shared_ptr<Task>(task);
+            }
+            #endif
+
+            callback(0, itemCount, 0, taskContext);
+            return nullptr;
+        }
+
+        static void finishTask(void* userTask, void* userContext){
+            std::shared_ptr<Task>* task = (std::shared_ptr<Task>*)userTask;
+
+            runTask(**task, 0);
+
+            while ((*task)->doneItems.load() < (*task)->itemCount){
+                std::this_thread::yield();
+            }
+
+            delete task;
+        }
+    };
+
     class Box2DAux{
     public:
 
@@ -74,11 +74,13 @@ namespace doriax {
         std::vector<std::function<Ret(Args...)>> functions;
         std::vector<std::string> tags;
         bool enabled = true;
+        unsigned int version = 0; // changed with subscribers, so cached results can be invalidated
 
         // Helper to remove subscriber by index
         void removeAt(size_t index) {
             functions.erase(functions.begin() + index);
             tags.erase(tags.begin() + index);
+            version++;
         }
 
         bool addImpl(const std::string& tag, std::function<Ret(Args...)> function){
@@ -89,6 +91,7 @@ namespace doriax {
 
             functions.push_back(function);
             tags.push_back(tag);
+            version++;
 
             return true;
         }
@@ -118,6 +121,7 @@ namespace doriax {
             this->functions = t.functions;
             this->tags = t.tags;
             this->enabled = t.enabled;
+            this->version++;
 
             return *this;
         }
@@ -143,13 +147,25 @@ namespace doriax {
         }
 
         void setEnabled(bool enabled) {
-            this->enabled = enabled;
+            if (this->enabled != enabled){
+                this->enabled = enabled;
+                version++;
+            }
         }
 
         bool isEnabled() const {
             return enabled;
         }
 
+        unsigned int getVersion() const {
+            return version;
+        }
+
+        // number of subscribers, to skip building arguments when nobody listens
+        size_t size() const {
+            return enabled ? functions.size() : 0;
+        }
+
         bool add(const std::string& tag, lua_State *L){
             std::function<Ret(Args...)> function = LuaFunction<Ret>(L);
             addImpl(tag, function);
@@ -195,6 +211,7 @@ namespace doriax {
             tags.erase(it);
 
             functions.erase(functions.begin() + index);
+            version++;
 
             return true;
         }
@@ -206,6 +223,7 @@ namespace doriax {
                     tags.erase(tags.begin() + i);
                     functions.erase(functions.begin() + i);
                     ++removed;
+                    ++version;
                 } else {
                     ++i;
                 }
@@ -304,6 +322,7 @@ namespace doriax {
         void clear(){
             functions.clear();
             tags.clear();
+            version++;
         }
     };
 }
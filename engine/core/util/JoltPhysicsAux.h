@@ -9,13 +9,27 @@
 #include "object/physics/Body3D.h"
 #include "object/physics/CollideShapeResult3D.h"
 #include "object/physics/Contact3D.h"
+#ifndef NO_THREAD_SUPPORT
+#include "thread/ThreadPoolManager.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Jolt/Jolt.h"
 
 #include "Jolt/RegisterTypes.h"
 #include "Jolt/Core/Factory.h"
 #include "Jolt/Core/TempAllocator.h"
-#include "Jolt/Core/JobSystemThreadPool.h"
+#include "Jolt/Core/JobSystemWithBarrier.h"
+#include "Jolt/Core/FixedSizeFreeList.h"
 #include "Jolt/Physics/PhysicsSettings.h"
 #include "Jolt/Physics/PhysicsSystem.h"
 
@@ -23,6 +37,7 @@
 
 #include "Jolt/Physics/Collision/RayCast.h"
 #include "Jolt/Physics/Collision/CastResult.h"
+#include "Jolt/Physics/Collision/CollideShape.h"
 
 #include "Jolt/Physics/Collision/Shape/BoxShape.h"
 #include "Jolt/Physics/Collision/Shape/SphereShape.h"
@@ -76,10 +91,268 @@ namespace doriax{
 		}
 	};
 
+	// Jolt jobs run on the engine thread pool, so physics does not compete with it for cores.
+	// Waiting thread also runs ready jobs of the barrier, jobs are never blocked by busy workers.
+	// Pool tasks only own the shared queue, jobs references are dropped when done, not when a worker dequeues.
+	class JoltJobSystem : public JPH::JobSystemWithBarrier{
+	private:
+		using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+
+		struct JobQueue{
+			std::mutex mutex;
+			std::condition_variable idle;
+			std::vector<Job*> jobs;
+			int running = 0;
+			bool closed = false;
+		};
+
+		AvailableJobs jobs;
+		std::shared_ptr<JobQueue> queue;
+		bool mainThreadOnly = false;
+
+		// pool task: takes the first pending job, jobs already run by a barrier are just released
+		static void runQueuedJob(const std::shared_ptr<JobQueue>& queue){
+			Job* job = nullptr;
+			std::vector<Job*> done;
+			{
+				std::lock_guard<std::mutex> lock(queue->mutex);
+				if (queue->closed){
+					return;
+				}
+				size_t i = 0;
+				while (i < queue->jobs.size() && queue->jobs[i]->IsDone()){
+					done.push_back(queue->jobs[i++]);
+				}
+				if (i < queue->jobs.size()){
+					job = queue->jobs[i++];
+				}
+				queue->jobs.erase(queue->jobs.begin(), queue->jobs.begin() + i);
+				queue->running++;
+			}
+
+			if (job){
+				job->Execute();
+				job->Release();
+			}
+			for (Job* doneJob : done){
+				doneJob->Release();
+			}
+
+			std::lock_guard<std::mutex> lock(queue->mutex);
+			queue->running--;
+			queue->idle.notify_all();
+		}
+
+		// drops references of jobs a barrier already executed, returns false if none
+		bool releaseDoneJobs(){
+			std::vector<Job*> done;
+			{
+				std::lock_guard<std::mutex> lock(queue->mutex);
+				auto it = std::partition(queue->jobs.begin(), queue->jobs.end(), [](Job* job){ return !job->IsDone(); });
+				done.assign(it, queue->jobs.end());
+				queue->jobs.erase(it, queue->jobs.end());
+			}
+			for (Job* job : done){
+				job->Release();
+			}
+			return !done.empty();
+		}
+
+	public:
+		JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers): JPH::JobSystemWithBarrier(maxBarriers){
+			jobs.Init(maxJobs, maxJobs);
+			queue = std::make_shared<JobQueue>();
+		}
+
+		virtual ~JoltJobSystem() override{
+			// all barriers were waited, so queued jobs are done: release them before the free list goes away
+			std::vector<Job*> pending;
+			{
+				std::unique_lock<std::mutex> lock(queue->mutex);
+				queue->closed = true;
+				pending.swap(queue->jobs);
+				queue->idle.wait(lock, [this](){ return queue->running == 0; });
+			}
+			for (Job* job : pending){
+				job->Release();
+			}
+		}
+
+		// jobs are not sent to the pool, barriers run them on the thread that waits (the one stepping the world)
+		void setMainThreadOnly(bool mainThreadOnly){
+			this->mainThreadOnly = mainThreadOnly;
+		}
+
+		bool isMainThreadOnly() const{
+			return mainThreadOnly;
+		}
+
+		virtual int GetMaxConcurrency() const override{
+			#ifndef NO_THREAD_SUPPORT
+			if (mainThreadOnly){
+				return 1;
+			}
+			return (int)ThreadPoolManager::getInstance().getNumThreads() + 1;
+			#else
+			return 1;
+			#endif
+		}
+
+		virtual JobHandle CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies = 0) override{
+			JPH::uint32 index;
+			while ((index = jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies)) == AvailableJobs::cInvalidObjectIndex){
+				if (!releaseDoneJobs()){
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+				}
+			}
+			Job* job = &jobs.Get(index);
+
+			// keeps a reference, job may complete right after queued
+			JobHandle handle(job);
+
+			if (inNumDependencies == 0){
+				QueueJob(job);
+			}
+
+			return handle;
+		}
+
+	protected:
+		virtual void QueueJob(Job *inJob) override{
+			#ifndef NO_THREAD_SUPPORT
+			ThreadPoolManager& pool = ThreadPoolManager::getInstance();
+			if (mainThreadOnly || pool.getNumThreads() == 0){
+				return;
+			}
+
+			inJob->AddRef();
+			{
+				std::lock_guard<std::mutex> lock(queue->mutex);
+				queue->jobs.push_back(inJob);
+			}
+			std::shared_ptr<JobQueue> jobQueue = queue;
+			pool.enqueue([jobQueue](){
+				runQueuedJob(jobQueue);
+			});
+			#endif
+		}
+
+		virtual void QueueJobs(Job **inJobs, JPH::uint inNumJobs) override{
+			for (JPH::uint i = 0; i < inNumJobs; i++){
+				QueueJob(inJobs[i]);
+			}
+		}
+
+		virtual void FreeJob(Job *inJob) override{
+			jobs.DestructObject(inJob);
+		}
+	};
+
+	// Jolt temporary memory in a single block, with heap fallback when the block is full.
+	// Block is grown to the observed peak between steps, so fallback only happens while it warms up.
+	class JoltTempAllocator : public JPH::TempAllocator{
+	private:
+		static constexpr size_t GROW_GRANULARITY = 1024 * 1024;
+
+		JPH::TempAllocatorImpl* block;
+		size_t usage;
+		size_t peakUsage;
+		uint32_t fallbackAllocations;
+
+	public:
+		explicit JoltTempAllocator(size_t size){
+			block = new JPH::TempAllocatorImpl((JPH::uint)size);
+			usage = 0;
+			peakUsage = 0;
+			fallbackAllocations = 0;
+		}
+
+		virtual ~JoltTempAllocator() override{
+			delete block;
+		}
+
+		virtual void* Allocate(JPH::uint inSize) override{
+			if (inSize == 0){
+				return nullptr;
+			}
+
+			void* address;
+			if (block->CanAllocate(inSize)){
+				address = block->Allocate(inSize);
+			}else{
+				address = JPH::AlignedAllocate(inSize, JPH_RVECTOR_ALIGNMENT);
+				fallbackAllocations++;
+			}
+
+			usage += JPH::AlignUp(inSize, JPH_RVECTOR_ALIGNMENT);
+			peakUsage = std::max(peakUsage, usage);
+
+			return address;
+		}
+
+		virtual void Free(void* inAddress, JPH::uint inSize) override{
+			if (inAddress == nullptr){
+				return;
+			}
+
+			if (block->OwnsMemory(inAddress)){
+				block->Free(inAddress, inSize);
+			}else{
+				JPH::AlignedFree(inAddress);
+			}
+
+			usage -= JPH::AlignUp(inSize, JPH_RVECTOR_ALIGNMENT);
+		}
+
+		// only when nothing is allocated, between steps
+		void resize(size_t size){
+			if (size != block->GetSize() && block->IsEmpty()){
+				delete block;
+				block = new JPH::TempAllocatorImpl((JPH::uint)size);
+			}
+		}
+
+		// grows block with some headroom if last steps needed more
+		void fitToPeak(){
+			if (peakUsage > block->GetSize()){
+				size_t size = peakUsage + peakUsage / 4;
+				resize((size + GROW_GRANULARITY - 1) / GROW_GRANULARITY * GROW_GRANULARITY);
+			}
+		}
+
+		void resetPeak(){
+			peakUsage = usage;
+			fallbackAllocations = 0;
+		}
+
+		size_t getSize() const{
+			return block->GetSize();
+		}
+
+		size_t getPeakUsage() const{
+			return peakUsage;
+		}
+
+		uint32_t getFallbackAllocations() const{
+			return fallbackAllocations;
+		}
+	};
+
+	struct JoltActivationEvent{
+		JPH::BodyID bodyID;
+		Entity entity;
+		bool activated;
+	};
+
+	// activation changes are recorded during the step and dispatched on the main thread
 	class JoltActivationListener : public JPH::BodyActivationListener{
 	private:
         Scene* scene;
         PhysicsSystem* physicsSystem;
+
+        std::vector<JoltActivationEvent> events;
+        std::mutex eventsMutex;
+
 	public:
         JoltActivationListener(Scene* scene, PhysicsSystem* physicsSystem){
             this->scene = scene;
@@ -87,64 +360,198 @@ namespace doriax{
         }
 
 		virtual void OnBodyActivated(const JPH::BodyID &inBodyID, uint64_t inBodyUserData) override{
-			physicsSystem->onBodyActivated3D(Body3D(scene, inBodyUserData));
+			std::lock_guard<std::mutex> lock(eventsMutex);
+			events.push_back({inBodyID, (Entity)inBodyUserData, true});
 		}
 
 		virtual void OnBodyDeactivated(const JPH::BodyID &inBodyID, uint64_t inBodyUserData) override{
-			physicsSystem->onBodyDeactivated3D(Body3D(scene, inBodyUserData));
+			std::lock_guard<std::mutex> lock(eventsMutex);
+			events.push_back({inBodyID, (Entity)inBodyUserData, false});
+		}
+
+		// deactivated bodies are appended, their last pose is not in active list anymore
+		void dispatchEvents(std::vector<JPH::BodyID>& deactivatedBodies){
+			std::vector<JoltActivationEvent> dispatching;
+			{
+				std::lock_guard<std::mutex> lock(eventsMutex);
+				dispatching.swap(events);
+			}
+
+			for (const JoltActivationEvent& event : dispatching){
+				if (event.activated){
+					physicsSystem->onBodyActivated3D(Body3D(scene, event.entity));
+				}else{
+					deactivatedBodies.push_back(event.bodyID);
+					physicsSystem->onBodyDeactivated3D(Body3D(scene, event.entity));
+				}
+			}
+
+			// keeps capacity, callbacks may have recorded new events meanwhile
+			std::lock_guard<std::mutex> lock(eventsMutex);
+			if (events.empty()){
+				dispatching.clear();
+				events.swap(dispatching);
+			}
 		}
 	};
 
+	enum class JoltContactEventType{
+		ADDED,
+		PERSISTED,
+		REMOVED
+	};
+
+	// contact recorded by a solver thread, dispatched later on the main thread
+	struct JoltContactEvent{
+		JoltContactEventType type;
+		JPH::SubShapeIDPair subShapePair;
+		Entity entity1;
+		Entity entity2;
+		uint32_t shapeIndex1;
+		uint32_t shapeIndex2;
+		JPH::RVec3 baseOffset;
+		JPH::Vec3 worldSpaceNormal;
+		float penetrationDepth;
+		uint32_t firstPoint; // in buffer points
+		uint32_t numPoints1;
+		uint32_t numPoints2;
+		JPH::ContactSettings settings;
+	};
+
+	// one per thread, aligned to not share cache lines
+	struct alignas(64) JoltContactEventBuffer{
+		std::vector<JoltContactEvent> events;
+		std::vector<JPH::Vec3> points;
+	};
+
 	class JoltContactListener : public JPH::ContactListener{
     private:
         Scene* scene;
         PhysicsSystem* physicsSystem;
-	public:
-        JoltContactListener(Scene* scene, PhysicsSystem* physicsSystem){
-            this->scene = scene;
-            this->physicsSystem = physicsSystem;
-        }
-
-		// See: ContactListener
-		virtual JPH::ValidateResult	OnContactValidate(const JPH::Body &inBody1, const JPH::Body &inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult &inCollisionResult) override{
-			Entity entity1 = inBody1.GetUserData();
-			Body3D body1(scene, entity1);
 
-			Entity entity2 = inBody2.GetUserData();
-			Body3D body2(scene, entity2);
+        // slot 0 is the thread stepping the world, then one per pool worker
+        std::vector<JoltContactEventBuffer> buffers;
+        // for threads without own buffer (pool grown after creation)
+        JoltContactEventBuffer sharedBuffer;
+        std::mutex sharedBufferMutex;
+
+        // contact settings changed by callbacks, applied from next step on
+        std::unordered_map<JPH::SubShapeIDPair, JPH::ContactSettings> settingsOverrides;
+
+        static size_t getThreadSlot(){
+            #ifndef NO_THREAD_SUPPORT
+            return (size_t)(ThreadPoolManager::getWorkerIndex() + 1);
+            #else
+            return 0;
+            #endif
+        }
 
-			if (!physicsSystem->shouldCollide3D.callRet(body1, body2, Vector3(inBaseOffset.GetX(), inBaseOffset.GetY(), inBaseOffset.GetZ()), CollideShapeResult3D(scene, &inBody1, &inBody2, &inCollisionResult), true)){
-				return JPH::ValidateResult::RejectAllContactsForThisBodyPair;
-			}
+        static size_t getNumThreadSlots(){
+            #ifndef NO_THREAD_SUPPORT
+            return ThreadPoolManager::getInstance().getNumThreads() + 1;
+            #else
+            return 1;
+            #endif
+        }
 
-			return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
-		}
+        static uint32_t getShapeIndex(const JPH::Body& body, const JPH::SubShapeID& subShapeID){
+            return (uint32_t)body.GetShape()->GetSubShapeUserData(subShapeID);
+        }
 
-		virtual void OnContactAdded(const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold, JPH::ContactSettings &ioSettings) override{
-			Entity entity1 = inBody1.GetUserData();
-			Body3D body1(scene, entity1);
+        void recordEvent(JoltContactEvent& event, const JPH::ContactManifold* manifold){
+            size_t slot = getThreadSlot();
+            if (slot < buffers.size()){
+                pushEvent(buffers[slot], event, manifold);
+            }else{
+                std::lock_guard<std::mutex> lock(sharedBufferMutex);
+                pushEvent(sharedBuffer, event, manifold);
+            }
+        }
 
-			Entity entity2 = inBody2.GetUserData();
-			Body3D body2(scene, entity2);
+        static void pushEvent(JoltContactEventBuffer& buffer, JoltContactEvent& event, const JPH::ContactManifold* manifold){
+            event.firstPoint = (uint32_t)buffer.points.size();
+            event.numPoints1 = 0;
+            event.numPoints2 = 0;
+            if (manifold){
+                event.numPoints1 = (uint32_t)manifold->mRelativeContactPointsOn1.size();
+                event.numPoints2 = (uint32_t)manifold->mRelativeContactPointsOn2.size();
+                buffer.points.insert(buffer.points.end(), manifold->mRelativeContactPointsOn1.begin(), manifold->mRelativeContactPointsOn1.end());
+                buffer.points.insert(buffer.points.end(), manifold->mRelativeContactPointsOn2.begin(), manifold->mRelativeContactPointsOn2.end());
+            }
+            buffer.events.push_back(event);
+        }
 
-			physicsSystem->onContactAdded3D(body1, body2, Contact3D(scene, &inBody1, &inBody2, &inManifold, &ioSettings));
-		}
+        void recordContact(JoltContactEventType type, const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold, JPH::ContactSettings &ioSettings){
+            JPH::SubShapeIDPair subShapePair(inBody1.GetID(), inManifold.mSubShapeID1, inBody2.GetID(), inManifold.mSubShapeID2);
+
+            // only written on main thread, between steps
+            if (!settingsOverrides.empty()){
+                auto it = settingsOverrides.find(subShapePair);
+                if (it != settingsOverrides.end()){
+                    ioSettings = it->second;
+                }
+            }
+
+            size_t subscribers = (type == JoltContactEventType::ADDED) ? physicsSystem->onContactAdded3D.size() : physicsSystem->onContactPersisted3D.size();
+            if (subscribers == 0){
+                return;
+            }
+
+            JoltContactEvent event;
+            event.type = type;
+            event.subShapePair = subShapePair;
+            event.entity1 = inBody1.GetUserData();
+            event.entity2 = inBody2.GetUserData();
+            event.shapeIndex1 = getShapeIndex(inBody1, inManifold.mSubShapeID1);
+            event.shapeIndex2 = getShapeIndex(inBody2, inManifold.mSubShapeID2);
+            event.baseOffset = inManifold.mBaseOffset;
+            event.worldSpaceNormal = inManifold.mWorldSpaceNormal;
+            event.penetrationDepth = inManifold.mPenetrationDepth;
+            event.settings = ioSettings;
+
+            recordEvent(event, &inManifold);
+        }
 
-		virtual void OnContactPersisted(const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold, JPH::ContactSettings &ioSettings) override{
-			Entity entity1 = inBody1.GetUserData();
-			Body3D body1(scene, entity1);
+        void dispatchContact(JoltContactEvent& event, const JoltContactEventBuffer& buffer){
+            const JPH::Vec3* points = buffer.points.data() + event.firstPoint;
+            JPH::ContactSettings original = event.settings;
+
+            Contact3D contact(scene,
+                Vector3(event.baseOffset.GetX(), event.baseOffset.GetY(), event.baseOffset.GetZ()),
+                Vector3(event.worldSpaceNormal.GetX(), event.worldSpaceNormal.GetY(), event.worldSpaceNormal.GetZ()),
+                event.penetrationDepth, event.shapeIndex1, event.shapeIndex2,
+                points, event.numPoints1, points + event.numPoints1, event.numPoints2, &event.settings);
+
+            if (event.type == JoltContactEventType::ADDED){
+                physicsSystem->onContactAdded3D(Body3D(scene, event.entity1), Body3D(scene, event.entity2), contact);
+            }else{
+                physicsSystem->onContactPersisted3D(Body3D(scene, event.entity1), Body3D(scene, event.entity2), contact);
+            }
+
+            if (event.settings.mCombinedFriction != original.mCombinedFriction ||
+                event.settings.mCombinedRestitution != original.mCombinedRestitution ||
+                event.settings.mIsSensor != original.mIsSensor ||
+                event.settings.mInvMassScale1 != original.mInvMassScale1 ||
+                event.settings.mInvInertiaScale1 != original.mInvInertiaScale1 ||
+                event.settings.mInvMassScale2 != original.mInvMassScale2 ||
+                event.settings.mInvInertiaScale2 != original.mInvInertiaScale2 ||
+                event.settings.mRelativeLinearSurfaceVelocity != original.mRelativeLinearSurfaceVelocity ||
+                event.settings.mRelativeAngularSurfaceVelocity != original.mRelativeAngularSurfaceVelocity){
+                settingsOverrides[event.subShapePair] = event.settings;
+            }
+        }
 
-			Entity entity2 = inBody2.GetUserData();
-			Body3D body2(scene, entity2);
+        void dispatchRemoved(const JoltContactEvent& event){
+            settingsOverrides.erase(event.subShapePair);
 
-			physicsSystem->onContactPersisted3D(body1, body2, Contact3D(scene, &inBody1, &inBody2, &inManifold, &ioSettings));
-		}
+            if (physicsSystem->onContactRemoved3D.size() == 0){
+                return;
+            }
 
-		virtual void OnContactRemoved(const JPH::SubShapeIDPair &inSubShapePair) override{
 			JPH::BodyInterface &body_interface = physicsSystem->getWorld3D()->GetBodyInterfaceNoLock();
 
-			const JPH::BodyID body1Id = inSubShapePair.GetBody1ID();
-			const JPH::BodyID body2Id = inSubShapePair.GetBody2ID();
+			const JPH::BodyID body1Id = event.subShapePair.GetBody1ID();
+			const JPH::BodyID body2Id = event.subShapePair.GetBody2ID();
 
 			if (body1Id.IsInvalid() || body2Id.IsInvalid()){
 				return;
@@ -164,10 +571,96 @@ namespace doriax{
 			Entity entity1 = body_interface.GetUserData(body1Id);
 			Entity entity2 = body_interface.GetUserData(body2Id);
 
-			size_t shapeIndex1 = shape1->GetSubShapeUserData(inSubShapePair.GetSubShapeID1());
-			size_t shapeIndex2 = shape2->GetSubShapeUserData(inSubShapePair.GetSubShapeID2());
+			size_t shapeIndex1 = shape1->GetSubShapeUserData(event.subShapePair.GetSubShapeID1());
+			size_t shapeIndex2 = shape2->GetSubShapeUserData(event.subShapePair.GetSubShapeID2());
 
 			physicsSystem->onContactRemoved3D(Body3D(scene, entity1), Body3D(scene, entity2), (unsigned long)shapeIndex1, (unsigned long)shapeIndex2);
+        }
+
+        void dispatchBuffer(JoltContactEventBuffer& buffer, JoltContactEventType type){
+            for (JoltContactEvent& event : buffer.events){
+                if (event.type != type){
+                    continue;
+                }
+                if (type == JoltContactEventType::REMOVED){
+                    dispatchRemoved(event);
+                }else{
+                    dispatchContact(event, buffer);
+                }
+            }
+        }
+
+	public:
+        JoltContactListener(Scene* scene, PhysicsSystem* physicsSystem): buffers(getNumThreadSlots()){
+            this->scene = scene;
+            this->physicsSystem = physicsSystem;
+        }
+
+		// See: ContactListener
+		virtual JPH::ValidateResult	OnContactValidate(const JPH::Body &inBody1, const JPH::Body &inBody2, JPH::RVec3Arg inBaseOffset, const JPH::CollideShapeResult &inCollisionResult) override{
+			const ContactFilter3D& filter = physicsSystem->getContactFilter3D();
+			if (filter){
+				if (!filter(inBody1.GetUserData(), getShapeIndex(inBody1, inCollisionResult.mSubShapeID1), inBody2.GetUserData(), getShapeIndex(inBody2, inCollisionResult.mSubShapeID2))){
+					return JPH::ValidateResult::RejectAllContactsForThisBodyPair;
+				}
+			}
+
+			if (physicsSystem->shouldCollide3D.size() > 0){
+				Body3D body1(scene, inBody1.GetUserData());
+				Body3D body2(scene, inBody2.GetUserData());
+
+				// step runs on main thread while shouldCollide3D has subscribers (see PhysicsSystem::update3DWorld)
+				if (!physicsSystem->shouldCollide3D.callRet(body1, body2, Vector3(inBaseOffset.GetX(), inBaseOffset.GetY(), inBaseOffset.GetZ()), CollideShapeResult3D(scene, &inBody1, &inBody2, &inCollisionResult), true)){
+					return JPH::ValidateResult::RejectAllContactsForThisBodyPair;
+				}
+			}
+
+			return JPH::ValidateResult::AcceptAllContactsForThisBodyPair;
+		}
+
+		virtual void OnContactAdded(const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold, JPH::ContactSettings &ioSettings) override{
+			recordContact(JoltContactEventType::ADDED, inBody1, inBody2, inManifold, ioSettings);
+		}
+
+		virtual void OnContactPersisted(const JPH::Body &inBody1, const JPH::Body &inBody2, const JPH::ContactManifold &inManifold, JPH::ContactSettings &ioSettings) override{
+			recordContact(JoltContactEventType::PERSISTED, inBody1, inBody2, inManifold, ioSettings);
+		}
+
+		// bodies cannot be accessed here, they are resolved on dispatch
+		virtual void OnContactRemoved(const JPH::SubShapeIDPair &inSubShapePair) override{
+			if (physicsSystem->onContactRemoved3D.size() == 0 && settingsOverrides.empty()){
+				return;
+			}
+
+			JoltContactEvent event;
+			event.type = JoltContactEventType::REMOVED;
+			event.subShapePair = inSubShapePair;
+			event.entity1 = NULL_ENTITY;
+			event.entity2 = NULL_ENTITY;
+			event.shapeIndex1 = 0;
+			event.shapeIndex2 = 0;
+			event.penetrationDepth = 0;
+
+			recordEvent(event, nullptr);
+		}
+
+		// calls subscribers with the events of last step, on the calling thread
+		void dispatchEvents(){
+			const JoltContactEventType types[] = {JoltContactEventType::ADDED, JoltContactEventType::PERSISTED, JoltContactEventType::REMOVED};
+
+			for (JoltContactEventType type : types){
+				for (JoltContactEventBuffer& buffer : buffers){
+					dispatchBuffer(buffer, type);
+				}
+				dispatchBuffer(sharedBuffer, type);
+			}
+
+			for (JoltContactEventBuffer& buffer : buffers){
+				buffer.events.clear();
+				buffer.points.clear();
+			}
+			sharedBuffer.events.clear();
+			sharedBuffer.points.clear();
 		}
 	};
 
@@ -0,0 +1,170 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef DORIAX_POOLEDSTORAGE_H
+#define DORIAX_POOLEDSTORAGE_H
+
+#include "util/HybridArray.h"
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace doriax {
+
+// Free list of objects reused by PooledObject, released objects are reset to default
+template <typename T>
+class ObjectPool {
+private:
+    static std::mutex& getMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<T*>& getFreeList() {
+        static std::vector<T*> freeList;
+        return freeList;
+    }
+
+public:
+    static T* acquire() {
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+            std::vector<T*>& freeList = getFreeList();
+            if (!freeList.empty()) {
+                T* object = freeList.back();
+                freeList.pop_back();
+                return object;
+            }
+        }
+        return new T();
+    }
+
+    static void release(T* object) {
+        *object = T();
+
+        std::lock_guard<std::mutex> lock(getMutex());
+        getFreeList().push_back(object);
+    }
+};
+
+// Handle to pooled data, acquired on first write. Copies are deep, moves only transfer the handle.
+template <typename T>
+struct PooledObject {
+    T* object = nullptr;
+
+    PooledObject() = default;
+
+    PooledObject(const PooledObject& rhs) {
+        if (rhs.object) {
+            get() = *rhs.object;
+        }
+    }
+
+    PooledObject(PooledObject&& rhs) noexcept {
+        object = rhs.object;
+        rhs.object = nullptr;
+    }
+
+    PooledObject& operator=(const PooledObject& rhs) {
+        if (this != &rhs) {
+            if (rhs.object) {
+                get() = *rhs.object;
+            } else {
+                reset();
+            }
+        }
+        return *this;
+    }
+
+    PooledObject& operator=(PooledObject&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            object = rhs.object;
+            rhs.object = nullptr;
+        }
+        return *this;
+    }
+
+    ~PooledObject() {
+        reset();
+    }
+
+    void reset() {
+        if (object) {
+            ObjectPool<T>::release(object);
+            object = nullptr;
+        }
+    }
+
+    bool isAllocated() const {
+        return object != nullptr;
+    }
+
+    T& get() {
+        if (!object) {
+            object = ObjectPool<T>::acquire();
+        }
+        return *object;
+    }
+
+    // not acquired yet reads as default values
+    const T& get() const {
+        if (!object) {
+            static const T defaultValue{};
+            return defaultValue;
+        }
+        return *object;
+    }
+
+    T* operator->() {
+        return &get();
+    }
+
+    const T* operator->() const {
+        return &get();
+    }
+};
+
+#ifdef DORIAX_EDITOR
+
+template <typename T, std::size_t Size>
+using PooledArray = HybridArray<T, Size>;
+
+#else
+
+// Same interface as HybridArray but values are kept out of the owner
+template <typename T, std::size_t Size>
+struct PooledArray {
+    PooledObject<std::array<T, Size>> values;
+
+    std::size_t size() const {
+        return Size;
+    }
+
+    T* data() {
+        return values.get().data();
+    }
+
+    const T* data() const {
+        return values.get().data();
+    }
+
+    bool validIndex(int index) const {
+        return index >= 0 && static_cast<std::size_t>(index) < Size;
+    }
+
+    T& operator[](std::size_t index) {
+        return values.get()[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        return values.get()[index];
+    }
+};
+
+#endif
+
+}
+
+#endif
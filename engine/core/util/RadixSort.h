@@ -0,0 +1,127 @@
+//
+// (c) 2026 Eduardo Doria.
+//
+
+#ifndef RADIXSORT_H
+#define RADIXSORT_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace doriax {
+
+    // Maps a float to an unsigned key with the same ordering (negative values included)
+    inline uint32_t floatToSortableKey(float value){
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // Stable LSD radix sort in ascending key order, one byte per pass.
+    // Passes where every item has the same byte are skipped, so narrow keys cost less.
+    // 'scratch' is resized as needed and can be reused between calls to avoid allocations.
+    template<typename T, typename KeyFunc>
+    void radixSort(std::vector<T>& items, std::vector<T>& scratch, KeyFunc getKey){
+        using Key = typename std::decay<decltype(getKey(items[0]))>::type;
+        static_assert(std::is_unsigned<Key>::value, "radix sort key must be unsigned");
+
+        constexpr size_t numPasses = sizeof(Key);
+        const size_t count = items.size();
+
+        if (count < 2){
+            return;
+        }
+
+        size_t histograms[numPasses][256] = {};
+        for (size_t i = 0; i < count; i++){
+            Key key = getKey(items[i]);
+            for (size_t p = 0; p < numPasses; p++){
+                histograms[p][(key >> (p * 8)) & 0xFF]++;
+            }
+        }
+
+        scratch.resize(count);
+
+        std::vector<T>* src = &items;
+        std::vector<T>* dst = &scratch;
+
+        for (size_t p = 0; p < numPasses; p++){
+            size_t* histogram = histograms[p];
+
+            // all keys share this byte
+            if (histogram[(getKey((*src)[0]) >> (p * 8)) & 0xFF] == count){
+                continue;
+            }
+
+            size_t offset = 0;
+            for (size_t b = 0; b < 256; b++){
+                size_t c = histogram[b];
+                histogram[b] = offset;
+                offset += c;
+            }
+
+            for (size_t i = 0; i < count; i++){
+                T& item = (*src)[i];
+                (*dst)[histogram[(getKey(item) >> (p * 8)) & 0xFF]++] = std::move(item);
+            }
+
+            std::swap(src, dst);
+        }
+
+        if (src != &items){
+            items.swap(scratch);
+        }
+    }
+
+    struct SortKey{
+        uint32_t key;
+        uint32_t index;
+    };
+
+    // Reorders 'items' in ascending key order, where keys[i] = {key of items[i], i}.
+    // Order from last frame usually barely changes, so an insertion sort is tried first
+    // and falls back to radix sort when it moves too many elements.
+    // Returns false when items were already in order and nothing was moved.
+    template<typename T>
+    bool sortByKeys(std::vector<T>& items, std::vector<T>& scratch, std::vector<SortKey>& keys, std::vector<SortKey>& keysScratch){
+        const size_t count = keys.size();
+
+        size_t i = 1;
+        while (i < count && keys[i - 1].key <= keys[i].key){
+            i++;
+        }
+        if (i >= count){
+            return false;
+        }
+
+        size_t maxMoves = count + 64;
+        size_t moves = 0;
+        for (; i < count && moves <= maxMoves; i++){
+            SortKey current = keys[i];
+            size_t j = i;
+            while (j > 0 && keys[j - 1].key > current.key){
+                keys[j] = keys[j - 1];
+                j--;
+            }
+            keys[j] = current;
+            moves += i - j;
+        }
+
+        if (i < count){
+            radixSort(keys, keysScratch, [](const SortKey& sortKey){ return sortKey.key; });
+        }
+
+        scratch.resize(count);
+        for (size_t k = 0; k < count; k++){
+            scratch[k] = std::move(items[keys[k].index]);
+        }
+        items.swap(scratch);
+
+        return true;
+    }
+
+}
+
+#endif //RADIXSORT_H
@@ -9,9 +9,18 @@
 #include "io/Data.h"
 #include "DefaultFont.h"
 #include "StringUtils.h"
+#include "buffer/VertexWriter.h"
 
 using namespace doriax;
 
+namespace {
+    // position and texcoord packed as in text buffer
+    struct TextVertex {
+        Vector3 position;
+        Vector2 texcoord;
+    };
+}
+
 STBText::STBText() {
     atlasWidth = 0;
     atlasHeight = 0;
@@ -177,8 +186,8 @@ void STBText::createText(const std::string& text, Buffer* buffer, std::vector<ui
     float offsetX = 0;
     float offsetY = 0;
 
-    Attribute* atrVertice = buffer->getAttribute(AttributeType::POSITION);
-    Attribute* atrTexcoord = buffer->getAttribute(AttributeType::TEXCOORD1);
+    VertexWriter vertices(*buffer, {AttributeType::POSITION, AttributeType::TEXCOORD1});
+    vertices.reserve(codepoints.size() * 4);
 
     if (multiline && fixedWidth){
 
@@ -264,15 +273,13 @@ void STBText::createText(const std::string& text, Buffer* buffer, std::vector<ui
             maxX1 = offsetX;
             
         if ((!fixedWidth || offsetX <= width) && (!fixedHeight || offsetY <= height)){
-            buffer->addVector3(atrVertice, Vector3(quad.x0, quad.y0, 0));
-            buffer->addVector3(atrVertice, Vector3(quad.x1, quad.y0, 0));
-            buffer->addVector3(atrVertice, Vector3(quad.x1, quad.y1, 0));
-            buffer->addVector3(atrVertice, Vector3(quad.x0, quad.y1, 0));
-
-            buffer->addVector2(atrTexcoord, Vector2(quad.s0, quad.t0));
-            buffer->addVector2(atrTexcoord, Vector2(quad.s1, quad.t0));
-            buffer->addVector2(atrTexcoord, Vector2(quad.s1, quad.t1));
-            buffer->addVector2(atrTexcoord, Vector2(quad.s0, quad.t1));
+            const TextVertex quadVertices[4] = {
+                {Vector3(quad.x0, quad.y0, 0), Vector2(quad.s0, quad.t0)},
+                {Vector3(quad.x1, quad.y0, 0), Vector2(quad.s1, quad.t0)},
+                {Vector3(quad.x1, quad.y1, 0), Vector2(quad.s1, quad.t1)},
+                {Vector3(quad.x0, quad.y1, 0), Vector2(quad.s0, quad.t1)}
+            };
+            vertices.addVertices(quadVertices, 4);
                 
             indices.push_back(ind);
             indices.push_back(ind+1);
@@ -286,18 +293,16 @@ void STBText::createText(const std::string& text, Buffer* buffer, std::vector<ui
     }
     //Empty text
     if (codepoints.size() == 0){
-        buffer->addVector3(atrVertice, Vector3(0.0f, 0.0f, 0.0f));
-        buffer->addVector3(atrVertice, Vector3(0.0f, 0.0f, 0.0f));
-        buffer->addVector3(atrVertice, Vector3(0.0f, 0.0f, 0.0f));
-
-        buffer->addVector2(atrTexcoord, Vector2(0.0f, 0.0f));
-        buffer->addVector2(atrTexcoord, Vector2(0.0f, 0.0f));
-        buffer->addVector2(atrTexcoord, Vector2(0.0f, 0.0f));
-        
+        for (int i = 0; i < 3; i++){
+            vertices.addVertex(Vector3(0.0f, 0.0f, 0.0f), Vector2(0.0f, 0.0f));
+        }
+
         indices.push_back(0);
         indices.push_back(1);
         indices.push_back(2);
     }
+    vertices.end();
+
     if (!fixedWidth)
         width = maxX1 - minX0;
     if (!fixedHeight)
@@ -5,6 +5,7 @@
 #include "SokolBuffer.h"
 #include "Log.h"
 #include "SokolCmdQueue.h"
+#include "SokolObject.h"
 #include "Engine.h"
 
 using namespace doriax;
@@ -72,6 +73,8 @@ void SokolBuffer::updateBuffer(unsigned int size, void* data){
             SokolCmdQueue::add_command_update_buffer(buffer, {data, (size_t)size});
         }else{
             sg_update_buffer(buffer, {data, (size_t)size});
+            // buffer may have switched to another internal slot
+            SokolObject::invalidateBindings();
         }
     }
 }
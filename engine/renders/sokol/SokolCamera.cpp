@@ -6,6 +6,7 @@
 
 #include "System.h"
 #include "SokolCmdQueue.h"
+#include "SokolObject.h"
 
 #include "sokol_gfx.h"
 #include <cmath>
@@ -41,6 +42,7 @@ void SokolCamera::startRenderPass(FramebufferRender* framebuffer, size_t face){
     pass.attachments = framebuffer->backend.get(face);
     //SokolCmdQueue::add_command_begin_pass(pass);
     sg_begin_pass(pass);
+    SokolObject::invalidateDrawState();
 }
 
 void SokolCamera::startRenderPass(int width, int height){
@@ -49,12 +51,14 @@ void SokolCamera::startRenderPass(int width, int height){
     pass.swapchain.height = height;
     //SokolCmdQueue::add_command_begin_pass(pass);
     sg_begin_pass(pass);
+    SokolObject::invalidateDrawState();
 }
 
 void SokolCamera::startRenderPass(){
     pass.swapchain = System::instance().getSokolSwapchain();
     //SokolCmdQueue::add_command_begin_pass(pass);
     sg_begin_pass(pass);
+    SokolObject::invalidateDrawState();
 }
 
 void SokolCamera::applyViewport(Rect rect){
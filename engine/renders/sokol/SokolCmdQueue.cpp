@@ -7,6 +7,7 @@
 #include <cstring>
 #include <algorithm>
 #include <cassert>
+#include <new>
 
 #include "SokolCmdQueue.h"
 
@@ -14,7 +15,10 @@ using namespace doriax;
 
 // ----------------------------------------------------------------------------------------------------
 
-std::vector<SokolRenderCommand> SokolCmdQueue::m_commands[2];
+SokolCmdArena SokolCmdQueue::m_commands[2];
+SokolCmdArena SokolCmdQueue::m_resources[2];
+uint32_t SokolCmdQueue::m_command_count[2] = {0, 0};
+SokolCmdQueueStats SokolCmdQueue::m_stats;
 int32_t SokolCmdQueue::m_pending_commands_index = 0;
 int32_t SokolCmdQueue::m_commit_commands_index = 1;
 std::vector<SokolRenderCleanup> SokolCmdQueue::m_cleanups;
@@ -30,17 +34,61 @@ int32_t SokolCmdQueue::m_frame_index = 0;
 
 // ----------------------------------------------------------------------------------------------------
 
-constexpr int32_t INITIAL_NUMBER_OF_COMMANDS = 256;
+constexpr size_t INITIAL_COMMAND_BYTES = 64 * 1024;
+constexpr size_t INITIAL_RESOURCE_BYTES = 16 * 1024;
 constexpr int32_t INITIAL_NUMBER_OF_CLEANUPS = 64;
 
+constexpr size_t COMMAND_HEADER_SIZE = (sizeof(SokolRenderCommand) + SokolRenderCommand::ALIGNMENT - 1) & ~(size_t)(SokolRenderCommand::ALIGNMENT - 1);
+
+// ----------------------------------------------------------------------------------------------------
+
+template<typename T>
+static const T& get_payload(const SokolCmdArena& arena, size_t offset)
+{
+	return *reinterpret_cast<const T*>(arena.at(offset));
+}
+
+// ----------------------------------------------------------------------------------------------------
+
+template<typename T>
+T* SokolCmdQueue::push_command(SokolRenderCommand::TYPE::ENUM type, size_t extra_size)
+{
+	static_assert(alignof(T) <= SokolRenderCommand::ALIGNMENT, "command payload alignment too large");
+
+	SokolCmdArena& commands = m_commands[m_pending_commands_index];
+
+	// header and payload in one block
+	size_t payload_size = sizeof(T) + extra_size;
+	size_t offset = commands.alloc(COMMAND_HEADER_SIZE + payload_size);
+
+	new (commands.at(offset)) SokolRenderCommand(type, (uint32_t)payload_size);
+	m_command_count[m_pending_commands_index] ++;
+
+	return new (commands.at(offset + COMMAND_HEADER_SIZE)) T();
+}
+
+// ----------------------------------------------------------------------------------------------------
+
+template<typename T>
+size_t SokolCmdQueue::push_resource_desc(const T& desc)
+{
+	SokolCmdArena& resources = m_resources[m_pending_commands_index];
+
+	size_t offset = resources.alloc(sizeof(T));
+	new (resources.at(offset)) T(desc);
+
+	return offset;
+}
+
 // ----------------------------------------------------------------------------------------------------
 
 void SokolCmdQueue::start(){
 	// loop through commands
 	for (int32_t i = 0; i < 2; i ++)
 	{
-		// reserve commands
-		m_commands[i].reserve(INITIAL_NUMBER_OF_COMMANDS);
+		// reserve arenas
+		m_commands[i].reserve(INITIAL_COMMAND_BYTES);
+		m_resources[i].reserve(INITIAL_RESOURCE_BYTES);
 	}
 
 	// reserve cleamups
@@ -81,9 +129,19 @@ void SokolCmdQueue::execute_commands(bool resource_only)
 		// lock execute mutex
 		std::scoped_lock<std::mutex> lock(m_execute_mutex);
 
+		const SokolCmdArena& commands = m_commands[m_commit_commands_index];
+		const SokolCmdArena& resources = m_resources[m_commit_commands_index];
+
 		// loop through commands
-		for (const auto& command : m_commands[m_commit_commands_index])
+		size_t offset = 0;
+		while (offset < commands.size())
 		{
+			const SokolRenderCommand& command = get_payload<SokolRenderCommand>(commands, offset);
+			size_t payload = offset + COMMAND_HEADER_SIZE;
+
+			// next command
+			offset = SokolCmdArena::align(payload + command.size);
+
 			// ignore command?
 			if (resource_only && !(command.type >= SokolRenderCommand::TYPE::MAKE_BUFFER && command.type <= SokolRenderCommand::TYPE::DESTROY_ATTACHMENTS))
 			{
@@ -94,77 +152,117 @@ void SokolCmdQueue::execute_commands(bool resource_only)
 			switch (command.type)
 			{
 			case SokolRenderCommand::TYPE::PUSH_DEBUG_GROUP:
-				sg_push_debug_group(command.push_debug_group.name);
+				sg_push_debug_group(get_payload<SokolRenderCommand::PushDebugGroup>(commands, payload).name);
 				break;
 			case SokolRenderCommand::TYPE::POP_DEBUG_GROUP:
 				sg_pop_debug_group();
 				break;
 			case SokolRenderCommand::TYPE::MAKE_BUFFER:
-				sg_init_buffer(command.make_buffer.buffer, command.make_buffer.desc);
+			{
+				const auto& make_buffer = get_payload<SokolRenderCommand::MakeBuffer>(commands, payload);
+				sg_init_buffer(make_buffer.buffer, get_payload<sg_buffer_desc>(resources, make_buffer.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::MAKE_IMAGE:
-				sg_init_image(command.make_image.image, command.make_image.desc);
+			{
+				const auto& make_image = get_payload<SokolRenderCommand::MakeImage>(commands, payload);
+				sg_init_image(make_image.image, get_payload<sg_image_desc>(resources, make_image.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::MAKE_SAMPLER:
-				sg_init_sampler(command.make_sampler.sampler, command.make_sampler.desc);
+			{
+				const auto& make_sampler = get_payload<SokolRenderCommand::MakeSampler>(commands, payload);
+				sg_init_sampler(make_sampler.sampler, get_payload<sg_sampler_desc>(resources, make_sampler.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::MAKE_SHADER:
-				sg_init_shader(command.make_shader.shader, command.make_shader.desc);
+			{
+				const auto& make_shader = get_payload<SokolRenderCommand::MakeShader>(commands, payload);
+				sg_init_shader(make_shader.shader, get_payload<sg_shader_desc>(resources, make_shader.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::MAKE_PIPELINE:
-				sg_init_pipeline(command.make_pipeline.pipeline, command.make_pipeline.desc);
+			{
+				const auto& make_pipeline = get_payload<SokolRenderCommand::MakePipeline>(commands, payload);
+				sg_init_pipeline(make_pipeline.pipeline, get_payload<sg_pipeline_desc>(resources, make_pipeline.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::MAKE_ATTACHMENTS:
-				sg_init_attachments(command.make_attachments.attachments, command.make_attachments.desc);
+			{
+				const auto& make_attachments = get_payload<SokolRenderCommand::MakeAttachments>(commands, payload);
+				sg_init_attachments(make_attachments.attachments, get_payload<sg_attachments_desc>(resources, make_attachments.desc_offset));
 				break;
+			}
 			case SokolRenderCommand::TYPE::DESTROY_BUFFER:
-				sg_uninit_buffer(command.destroy_buffer.buffer);
+				sg_uninit_buffer(get_payload<SokolRenderCommand::DestroyBuffer>(commands, payload).buffer);
 				break;
 			case SokolRenderCommand::TYPE::DESTROY_IMAGE:
-				sg_uninit_image(command.destroy_image.image);
+				sg_uninit_image(get_payload<SokolRenderCommand::DestroyImage>(commands, payload).image);
 				break;
 			case SokolRenderCommand::TYPE::DESTROY_SAMPLER:
-				sg_uninit_sampler(command.destroy_sampler.sampler);
+				sg_uninit_sampler(get_payload<SokolRenderCommand::DestroySampler>(commands, payload).sampler);
 				break;
 			case SokolRenderCommand::TYPE::DESTROY_SHADER:
-				sg_uninit_shader(command.destroy_shader.shader);
+				sg_uninit_shader(get_payload<SokolRenderCommand::DestroyShader>(commands, payload).shader);
 				break;
 			case SokolRenderCommand::TYPE::DESTROY_PIPELINE:
-				sg_uninit_pipeline(command.destroy_pipeline.pipeline);
+				sg_uninit_pipeline(get_payload<SokolRenderCommand::DestroyPipeline>(commands, payload).pipeline);
 				break;
 			case SokolRenderCommand::TYPE::DESTROY_ATTACHMENTS:
-				sg_uninit_attachments(command.destroy_attachments.attachments);
+				sg_uninit_attachments(get_payload<SokolRenderCommand::DestroyAttachments>(commands, payload).attachments);
 				break;
 			case SokolRenderCommand::TYPE::UPDATE_BUFFER:
-				sg_update_buffer(command.update_buffer.buffer, command.update_buffer.data);
+			{
+				const auto& update_buffer = get_payload<SokolRenderCommand::UpdateBuffer>(commands, payload);
+				sg_update_buffer(update_buffer.buffer, update_buffer.data);
 				break;
+			}
 			case SokolRenderCommand::TYPE::APPEND_BUFFER:
-				sg_append_buffer(command.append_buffer.buffer, command.append_buffer.data);
+			{
+				const auto& append_buffer = get_payload<SokolRenderCommand::AppendBuffer>(commands, payload);
+				sg_append_buffer(append_buffer.buffer, append_buffer.data);
 				break;
+			}
 			case SokolRenderCommand::TYPE::UPDATE_IMAGE:
-				sg_update_image(command.update_image.image, command.update_image.data);
+			{
+				const auto& update_image = get_payload<SokolRenderCommand::UpdateImage>(commands, payload);
+				sg_update_image(update_image.image, update_image.data);
 				break;
+			}
 			case SokolRenderCommand::TYPE::BEGIN_PASS:
-				sg_begin_pass(command.begin_pass.pass);
+				sg_begin_pass(get_payload<SokolRenderCommand::BeginPass>(commands, payload).pass);
 				break;
 			case SokolRenderCommand::TYPE::APPLY_VIEWPORT:
-				sg_apply_viewport(command.apply_viewport.x, command.apply_viewport.y, command.apply_viewport.width, command.apply_viewport.height, command.apply_viewport.origin_top_left);
+			{
+				const auto& apply_viewport = get_payload<SokolRenderCommand::ApplyViewport>(commands, payload);
+				sg_apply_viewport(apply_viewport.x, apply_viewport.y, apply_viewport.width, apply_viewport.height, apply_viewport.origin_top_left);
 				break;
+			}
 			case SokolRenderCommand::TYPE::APPLY_SCISSOR_RECT:
-				sg_apply_scissor_rect(command.apply_scissor_rect.x, command.apply_scissor_rect.y, command.apply_scissor_rect.width, command.apply_scissor_rect.height, command.apply_scissor_rect.origin_top_left);
+			{
+				const auto& apply_scissor_rect = get_payload<SokolRenderCommand::ApplyScissorRect>(commands, payload);
+				sg_apply_scissor_rect(apply_scissor_rect.x, apply_scissor_rect.y, apply_scissor_rect.width, apply_scissor_rect.height, apply_scissor_rect.origin_top_left);
 				break;
+			}
 			case SokolRenderCommand::TYPE::APPLY_PIPELINE:
-				sg_apply_pipeline(command.apply_pipeline.pipeline);
+				sg_apply_pipeline(get_payload<SokolRenderCommand::ApplyPipeline>(commands, payload).pipeline);
 				break;
 			case SokolRenderCommand::TYPE::APPLY_BINDINGS:
-				sg_apply_bindings(command.apply_bindings.bindings);
+				sg_apply_bindings(get_payload<SokolRenderCommand::ApplyBindings>(commands, payload).bindings);
 				break;
 			case SokolRenderCommand::TYPE::APPLY_UNIFORMS:
-				sg_apply_uniforms(command.apply_uniforms.ub_slot, { command.apply_uniforms.buf, command.apply_uniforms.data_size });
+			{
+				// uniform bytes are stored right after the payload struct
+				const auto& apply_uniforms = get_payload<SokolRenderCommand::ApplyUniforms>(commands, payload);
+				sg_apply_uniforms(apply_uniforms.ub_slot, { commands.at(payload + sizeof(SokolRenderCommand::ApplyUniforms)), apply_uniforms.data_size });
 				break;
+			}
 			case SokolRenderCommand::TYPE::DRAW:
-				sg_draw(command.draw.base_element, command.draw.number_of_elements, command.draw.number_of_instances);
+			{
+				const auto& draw = get_payload<SokolRenderCommand::Draw>(commands, payload);
+				sg_draw(draw.base_element, draw.number_of_elements, draw.number_of_instances);
 				break;
+			}
 			case SokolRenderCommand::TYPE::END_PASS:
 				sg_end_pass();
 				break;
@@ -172,8 +270,11 @@ void SokolCmdQueue::execute_commands(bool resource_only)
 				sg_commit();
 				break;
 			case SokolRenderCommand::TYPE::CUSTOM:
-				command.custom.custom_cb(command.custom.custom_data);
+			{
+				const auto& custom = get_payload<SokolRenderCommand::Custom>(commands, payload);
+				custom.custom_cb(custom.custom_data);
 				break;
+			}
 			case SokolRenderCommand::TYPE::NOT_SET:
 				break;
 			}
@@ -210,47 +311,56 @@ void SokolCmdQueue::wait_for_flush()
 			// lock execute mutex
 			std::scoped_lock<std::mutex> lock(m_execute_mutex);
 			
+			const SokolCmdArena& commands = m_commands[m_commit_commands_index];
+
 			// loop through commands
-			for (const auto& command : m_commands[m_commit_commands_index])
+			size_t offset = 0;
+			while (offset < commands.size())
 			{
+				const SokolRenderCommand& command = get_payload<SokolRenderCommand>(commands, offset);
+				size_t payload = offset + COMMAND_HEADER_SIZE;
+
+				// next command
+				offset = SokolCmdArena::align(payload + command.size);
+
 				// execute command
 				switch (command.type)
 				{
 				case SokolRenderCommand::TYPE::MAKE_BUFFER:
-					//sg_init_buffer(command.make_buffer.buffer, command.make_buffer.desc);
+					//sg_init_buffer(make_buffer.buffer, make_buffer desc);
 					break;
 				case SokolRenderCommand::TYPE::MAKE_IMAGE:
-					//sg_init_image(command.make_image.image, command.make_image.desc);
+					//sg_init_image(make_image.image, make_image desc);
 					break;
 				case SokolRenderCommand::TYPE::MAKE_SAMPLER:
-					//sg_init_sampler(command.make_sampler.sampler, command.sampler.desc);
+					//sg_init_sampler(make_sampler.sampler, make_sampler desc);
 					break;
 				case SokolRenderCommand::TYPE::MAKE_SHADER:
-					//sg_init_shader(command.make_shader.shader, command.make_shader.desc);
+					//sg_init_shader(make_shader.shader, make_shader desc);
 					break;
 				case SokolRenderCommand::TYPE::MAKE_PIPELINE:
-					//sg_init_pipeline(command.make_pipeline.pipeline, command.make_pipeline.desc);
+					//sg_init_pipeline(make_pipeline.pipeline, make_pipeline desc);
 					break;
 				case SokolRenderCommand::TYPE::MAKE_ATTACHMENTS:
-					//sg_init_attachments(command.make_attachments.attachments, command.make_attachments.desc);
+					//sg_init_attachments(make_attachments.attachments, make_attachments desc);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_BUFFER:
-					sg_uninit_buffer(command.destroy_buffer.buffer);
+					sg_uninit_buffer(get_payload<SokolRenderCommand::DestroyBuffer>(commands, payload).buffer);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_IMAGE:
-					sg_uninit_image(command.destroy_image.image);
+					sg_uninit_image(get_payload<SokolRenderCommand::DestroyImage>(commands, payload).image);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_SAMPLER:
-					sg_uninit_sampler(command.destroy_sampler.sampler);
+					sg_uninit_sampler(get_payload<SokolRenderCommand::DestroySampler>(commands, payload).sampler);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_SHADER:
-					sg_uninit_shader(command.destroy_shader.shader);
+					sg_uninit_shader(get_payload<SokolRenderCommand::DestroyShader>(commands, payload).shader);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_PIPELINE:
-					sg_uninit_pipeline(command.destroy_pipeline.pipeline);
+					sg_uninit_pipeline(get_payload<SokolRenderCommand::DestroyPipeline>(commands, payload).pipeline);
 					break;
 				case SokolRenderCommand::TYPE::DESTROY_ATTACHMENTS:
-					sg_uninit_attachments(command.destroy_attachments.attachments);
+					sg_uninit_attachments(get_payload<SokolRenderCommand::DestroyAttachments>(commands, payload).attachments);
 					break;
 				default:
 					break;
@@ -271,10 +381,10 @@ void SokolCmdQueue::wait_for_flush()
 void SokolCmdQueue::add_command_push_debug_group(const char* name)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::PUSH_DEBUG_GROUP);
+	SokolRenderCommand::PushDebugGroup* command = push_command<SokolRenderCommand::PushDebugGroup>(SokolRenderCommand::TYPE::PUSH_DEBUG_GROUP);
 
 	// copy args
-	command.push_debug_group.name = name;
+	command->name = name;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -282,109 +392,127 @@ void SokolCmdQueue::add_command_push_debug_group(const char* name)
 void SokolCmdQueue::add_command_pop_debug_group()
 {
 	// add command
-	/*SokolRenderCommand& command = */m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::POP_DEBUG_GROUP);
+	push_command<SokolRenderCommand::Empty>(SokolRenderCommand::TYPE::POP_DEBUG_GROUP);
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_buffer SokolCmdQueue::add_command_make_buffer(const sg_buffer_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_BUFFER);
+	SokolRenderCommand::MakeBuffer* command = push_command<SokolRenderCommand::MakeBuffer>(SokolRenderCommand::TYPE::MAKE_BUFFER);
 
 	// copy args
-	command.make_buffer.desc = desc;
-	
+	command->desc_offset = desc_offset;
+
 	// alloc buffer
-	command.make_buffer.buffer = sg_alloc_buffer();
-	
+	command->buffer = sg_alloc_buffer();
+
 	// return buffer
-	return command.make_buffer.buffer;
+	return command->buffer;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_image SokolCmdQueue::add_command_make_image(const sg_image_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_IMAGE);
+	SokolRenderCommand::MakeImage* command = push_command<SokolRenderCommand::MakeImage>(SokolRenderCommand::TYPE::MAKE_IMAGE);
 
 	// copy args
-	command.make_image.desc = desc;
+	command->desc_offset = desc_offset;
 
 	// alloc image
-	command.make_image.image = sg_alloc_image();
-	
+	command->image = sg_alloc_image();
+
 	// return image
-	return command.make_image.image;
+	return command->image;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_sampler SokolCmdQueue::add_command_make_sampler(const sg_sampler_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_SAMPLER);
+	SokolRenderCommand::MakeSampler* command = push_command<SokolRenderCommand::MakeSampler>(SokolRenderCommand::TYPE::MAKE_SAMPLER);
 
 	// copy args
-	command.make_sampler.desc = desc;
+	command->desc_offset = desc_offset;
 
 	// alloc sampler
-	command.make_sampler.sampler = sg_alloc_sampler();
+	command->sampler = sg_alloc_sampler();
 
 	// return sampler
-	return command.make_sampler.sampler;
+	return command->sampler;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_shader SokolCmdQueue::add_command_make_shader(const sg_shader_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_SHADER);
+	SokolRenderCommand::MakeShader* command = push_command<SokolRenderCommand::MakeShader>(SokolRenderCommand::TYPE::MAKE_SHADER);
 
 	// copy args
-	command.make_shader.desc = desc;
+	command->desc_offset = desc_offset;
 
 	// alloc shader
-	command.make_shader.shader = sg_alloc_shader();
-	
+	command->shader = sg_alloc_shader();
+
 	// return shader
-	return command.make_shader.shader;
+	return command->shader;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_pipeline SokolCmdQueue::add_command_make_pipeline(const sg_pipeline_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_PIPELINE);
+	SokolRenderCommand::MakePipeline* command = push_command<SokolRenderCommand::MakePipeline>(SokolRenderCommand::TYPE::MAKE_PIPELINE);
 
 	// copy args
-	command.make_pipeline.desc = desc;
+	command->desc_offset = desc_offset;
 
 	// alloc pipeline
-	command.make_pipeline.pipeline = sg_alloc_pipeline();
-	
+	command->pipeline = sg_alloc_pipeline();
+
 	// return pipeline
-	return command.make_pipeline.pipeline;
+	return command->pipeline;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 sg_attachments SokolCmdQueue::add_command_make_attachments(const sg_attachments_desc& desc)
 {
+	// copy desc to resource arena
+	size_t desc_offset = push_resource_desc(desc);
+
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::MAKE_ATTACHMENTS);
+	SokolRenderCommand::MakeAttachments* command = push_command<SokolRenderCommand::MakeAttachments>(SokolRenderCommand::TYPE::MAKE_ATTACHMENTS);
 
 	// copy args
-	command.make_attachments.desc = desc;
+	command->desc_offset = desc_offset;
 
 	// alloc attachments
-	command.make_attachments.attachments = sg_alloc_attachments();
-	
+	command->attachments = sg_alloc_attachments();
+
 	// return attachments
-	return command.make_attachments.attachments;
+	return command->attachments;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -392,13 +520,13 @@ sg_attachments SokolCmdQueue::add_command_make_attachments(const sg_attachments_
 void SokolCmdQueue::add_command_destroy_buffer(sg_buffer buffer)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_BUFFER);
+	SokolRenderCommand::DestroyBuffer* command = push_command<SokolRenderCommand::DestroyBuffer>(SokolRenderCommand::TYPE::DESTROY_BUFFER);
 
 	// copy args
-	command.destroy_buffer.buffer = buffer;
+	command->buffer = buffer;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_buffer_cb, (void*)(uintptr_t)command.destroy_buffer.buffer.id);
+	schedule_cleanup(dealloc_buffer_cb, (void*)(uintptr_t)buffer.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -406,13 +534,13 @@ void SokolCmdQueue::add_command_destroy_buffer(sg_buffer buffer)
 void SokolCmdQueue::add_command_destroy_image(sg_image image)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_IMAGE);
+	SokolRenderCommand::DestroyImage* command = push_command<SokolRenderCommand::DestroyImage>(SokolRenderCommand::TYPE::DESTROY_IMAGE);
 
 	// copy args
-	command.destroy_image.image = image;
+	command->image = image;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_image_cb, (void*)(uintptr_t)command.destroy_image.image.id);
+	schedule_cleanup(dealloc_image_cb, (void*)(uintptr_t)image.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -420,13 +548,13 @@ void SokolCmdQueue::add_command_destroy_image(sg_image image)
 void SokolCmdQueue::add_command_destroy_sampler(sg_sampler sampler)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_SAMPLER);
+	SokolRenderCommand::DestroySampler* command = push_command<SokolRenderCommand::DestroySampler>(SokolRenderCommand::TYPE::DESTROY_SAMPLER);
 
 	// copy args
-	command.destroy_sampler.sampler = sampler;
+	command->sampler = sampler;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_sampler_cb, (void*)(uintptr_t)command.destroy_sampler.sampler.id);
+	schedule_cleanup(dealloc_sampler_cb, (void*)(uintptr_t)sampler.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -434,13 +562,13 @@ void SokolCmdQueue::add_command_destroy_sampler(sg_sampler sampler)
 void SokolCmdQueue::add_command_destroy_shader(sg_shader shader)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_SHADER);
+	SokolRenderCommand::DestroyShader* command = push_command<SokolRenderCommand::DestroyShader>(SokolRenderCommand::TYPE::DESTROY_SHADER);
 
 	// copy args
-	command.destroy_shader.shader = shader;
+	command->shader = shader;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_shader_cb, (void*)(uintptr_t)command.destroy_shader.shader.id);
+	schedule_cleanup(dealloc_shader_cb, (void*)(uintptr_t)shader.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -448,13 +576,13 @@ void SokolCmdQueue::add_command_destroy_shader(sg_shader shader)
 void SokolCmdQueue::add_command_destroy_pipeline(sg_pipeline pipeline)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_PIPELINE);
+	SokolRenderCommand::DestroyPipeline* command = push_command<SokolRenderCommand::DestroyPipeline>(SokolRenderCommand::TYPE::DESTROY_PIPELINE);
 
 	// copy args
-	command.destroy_pipeline.pipeline = pipeline;
+	command->pipeline = pipeline;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_pipeline_cb, (void*)(uintptr_t)command.destroy_pipeline.pipeline.id);
+	schedule_cleanup(dealloc_pipeline_cb, (void*)(uintptr_t)pipeline.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -462,13 +590,13 @@ void SokolCmdQueue::add_command_destroy_pipeline(sg_pipeline pipeline)
 void SokolCmdQueue::add_command_destroy_attachments(sg_attachments atts)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DESTROY_ATTACHMENTS);
+	SokolRenderCommand::DestroyAttachments* command = push_command<SokolRenderCommand::DestroyAttachments>(SokolRenderCommand::TYPE::DESTROY_ATTACHMENTS);
 
 	// copy args
-	command.destroy_attachments.attachments = atts;
+	command->attachments = atts;
 
 	// schedule cleanup
-	schedule_cleanup(dealloc_attachments_cb, (void*)(uintptr_t)command.destroy_attachments.attachments.id);
+	schedule_cleanup(dealloc_attachments_cb, (void*)(uintptr_t)atts.id);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -476,11 +604,11 @@ void SokolCmdQueue::add_command_destroy_attachments(sg_attachments atts)
 void SokolCmdQueue::add_command_update_buffer(sg_buffer buffer, const sg_range& data)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::UPDATE_BUFFER);
+	SokolRenderCommand::UpdateBuffer* command = push_command<SokolRenderCommand::UpdateBuffer>(SokolRenderCommand::TYPE::UPDATE_BUFFER);
 
 	// copy args
-	command.update_buffer.buffer = buffer;
-	command.update_buffer.data = data;
+	command->buffer = buffer;
+	command->data = data;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -488,11 +616,11 @@ void SokolCmdQueue::add_command_update_buffer(sg_buffer buffer, const sg_range&
 void SokolCmdQueue::add_command_append_buffer(sg_buffer buffer, const sg_range& data)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPEND_BUFFER);
+	SokolRenderCommand::AppendBuffer* command = push_command<SokolRenderCommand::AppendBuffer>(SokolRenderCommand::TYPE::APPEND_BUFFER);
 
 	// copy args
-	command.append_buffer.buffer = buffer;
-	command.append_buffer.data = data;
+	command->buffer = buffer;
+	command->data = data;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -500,11 +628,11 @@ void SokolCmdQueue::add_command_append_buffer(sg_buffer buffer, const sg_range&
 void SokolCmdQueue::add_command_update_image(sg_image image, const sg_image_data& data)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::UPDATE_IMAGE);
+	SokolRenderCommand::UpdateImage* command = push_command<SokolRenderCommand::UpdateImage>(SokolRenderCommand::TYPE::UPDATE_IMAGE);
 
 	// copy args
-	command.update_image.image = image;
-	command.update_image.data = data;
+	command->image = image;
+	command->data = data;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -512,10 +640,10 @@ void SokolCmdQueue::add_command_update_image(sg_image image, const sg_image_data
 void SokolCmdQueue::add_command_begin_pass(const sg_pass& pass)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::BEGIN_PASS);
+	SokolRenderCommand::BeginPass* command = push_command<SokolRenderCommand::BeginPass>(SokolRenderCommand::TYPE::BEGIN_PASS);
 
 	// copy args
-	command.begin_pass.pass = pass;
+	command->pass = pass;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -523,14 +651,14 @@ void SokolCmdQueue::add_command_begin_pass(const sg_pass& pass)
 void SokolCmdQueue::add_command_apply_viewport(int x, int y, int width, int height, bool origin_top_left)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPLY_VIEWPORT);
+	SokolRenderCommand::ApplyViewport* command = push_command<SokolRenderCommand::ApplyViewport>(SokolRenderCommand::TYPE::APPLY_VIEWPORT);
 
 	// copy args
-	command.apply_viewport.x = x;
-	command.apply_viewport.y = y;
-	command.apply_viewport.width = width;
-	command.apply_viewport.height = height;
-	command.apply_viewport.origin_top_left = origin_top_left;
+	command->x = x;
+	command->y = y;
+	command->width = width;
+	command->height = height;
+	command->origin_top_left = origin_top_left;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -538,14 +666,14 @@ void SokolCmdQueue::add_command_apply_viewport(int x, int y, int width, int heig
 void SokolCmdQueue::add_command_apply_scissor_rect(int x, int y, int width, int height, bool origin_top_left)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPLY_SCISSOR_RECT);
+	SokolRenderCommand::ApplyScissorRect* command = push_command<SokolRenderCommand::ApplyScissorRect>(SokolRenderCommand::TYPE::APPLY_SCISSOR_RECT);
 
 	// copy args
-	command.apply_scissor_rect.x = x;
-	command.apply_scissor_rect.y = y;
-	command.apply_scissor_rect.width = width;
-	command.apply_scissor_rect.height = height;
-	command.apply_scissor_rect.origin_top_left = origin_top_left;
+	command->x = x;
+	command->y = y;
+	command->width = width;
+	command->height = height;
+	command->origin_top_left = origin_top_left;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -553,10 +681,10 @@ void SokolCmdQueue::add_command_apply_scissor_rect(int x, int y, int width, int
 void SokolCmdQueue::add_command_apply_pipeline(sg_pipeline pipeline)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPLY_PIPELINE);
+	SokolRenderCommand::ApplyPipeline* command = push_command<SokolRenderCommand::ApplyPipeline>(SokolRenderCommand::TYPE::APPLY_PIPELINE);
 
 	// copy args
-	command.apply_pipeline.pipeline = pipeline;
+	command->pipeline = pipeline;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -564,26 +692,23 @@ void SokolCmdQueue::add_command_apply_pipeline(sg_pipeline pipeline)
 void SokolCmdQueue::add_command_apply_bindings(const sg_bindings& bindings)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPLY_BINDINGS);
+	SokolRenderCommand::ApplyBindings* command = push_command<SokolRenderCommand::ApplyBindings>(SokolRenderCommand::TYPE::APPLY_BINDINGS);
 
 	// copy args
-	command.apply_bindings.bindings = bindings;
+	command->bindings = bindings;
 }
 
 // ----------------------------------------------------------------------------------------------------
 
 void SokolCmdQueue::add_command_apply_uniforms(int ub_slot, const sg_range& data)
 {
-	// data size too big?
-	assert((size_t)data.size <= sizeof(SokolRenderCommand::apply_uniforms.buf));
-
-	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::APPLY_UNIFORMS);
+	// add command, uniform bytes are stored inline with their actual size
+	SokolRenderCommand::ApplyUniforms* command = push_command<SokolRenderCommand::ApplyUniforms>(SokolRenderCommand::TYPE::APPLY_UNIFORMS, data.size);
 
 	// copy args
-	command.apply_uniforms.ub_slot = ub_slot;
-	memcpy(command.apply_uniforms.buf, data.ptr, data.size);
-	command.apply_uniforms.data_size = data.size;
+	command->ub_slot = ub_slot;
+	command->data_size = data.size;
+	memcpy(command + 1, data.ptr, data.size);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -591,12 +716,12 @@ void SokolCmdQueue::add_command_apply_uniforms(int ub_slot, const sg_range& data
 void SokolCmdQueue::add_command_draw(int base_element, int number_of_elements, int number_of_instances)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::DRAW);
+	SokolRenderCommand::Draw* command = push_command<SokolRenderCommand::Draw>(SokolRenderCommand::TYPE::DRAW);
 
 	// copy args
-	command.draw.base_element = base_element;
-	command.draw.number_of_elements = number_of_elements;
-	command.draw.number_of_instances = number_of_instances;
+	command->base_element = base_element;
+	command->number_of_elements = number_of_elements;
+	command->number_of_instances = number_of_instances;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -604,7 +729,7 @@ void SokolCmdQueue::add_command_draw(int base_element, int number_of_elements, i
 void SokolCmdQueue::add_command_end_pass()
 {
 	// add command
-	/*SokolRenderCommand& command = */m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::END_PASS);
+	push_command<SokolRenderCommand::Empty>(SokolRenderCommand::TYPE::END_PASS);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -612,7 +737,7 @@ void SokolCmdQueue::add_command_end_pass()
 void SokolCmdQueue::add_command_commit()
 {
 	// add command
-	/*SokolRenderCommand& command = */m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::COMMIT);
+	push_command<SokolRenderCommand::Empty>(SokolRenderCommand::TYPE::COMMIT);
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -620,11 +745,11 @@ void SokolCmdQueue::add_command_commit()
 void SokolCmdQueue::add_command_custom(void (*custom_cb)(void* custom_data), void* custom_data)
 {
 	// add command
-	SokolRenderCommand& command = m_commands[m_pending_commands_index].emplace_back(SokolRenderCommand::TYPE::CUSTOM);
+	SokolRenderCommand::Custom* command = push_command<SokolRenderCommand::Custom>(SokolRenderCommand::TYPE::CUSTOM);
 
 	// copy args
-	command.custom.custom_cb = custom_cb;
-	command.custom.custom_data = custom_data;
+	command->custom_cb = custom_cb;
+	command->custom_data = custom_data;
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -640,16 +765,31 @@ void SokolCmdQueue::schedule_cleanup(void (*cleanup_cb)(void* cleanup_data), voi
 
 // ----------------------------------------------------------------------------------------------------
 
+void SokolCmdQueue::swap_commands()
+{
+	// clear commands
+	m_commands[m_commit_commands_index].clear();
+	m_resources[m_commit_commands_index].clear();
+	m_command_count[m_commit_commands_index] = 0;
+
+	// swap commands indexes
+	std::swap(m_pending_commands_index, m_commit_commands_index);
+
+	// frame size counters
+	m_stats.command_count = m_command_count[m_commit_commands_index];
+	m_stats.command_bytes = m_commands[m_commit_commands_index].size();
+	m_stats.resource_bytes = m_resources[m_commit_commands_index].size();
+}
+
+// ----------------------------------------------------------------------------------------------------
+
 void SokolCmdQueue::commit_commands()
 {
 	// acquire render semaphore
 	m_render_semaphore.acquire();
 	
-	// clear commands
-	m_commands[m_commit_commands_index].resize(0);
-	
-	// swap commands indexes
-	std::swap(m_pending_commands_index, m_commit_commands_index);
+	// clear executed commands and swap
+	swap_commands();
 
 	// mark as commited
 	m_commited = true;
@@ -665,11 +805,8 @@ void SokolCmdQueue::flush_commands()
 	// acquire render semaphore
 	m_render_semaphore.acquire();
 	
-	// clear commands
-	m_commands[m_commit_commands_index].resize(0);
-	
-	// swap commands indexes
-	std::swap(m_pending_commands_index, m_commit_commands_index);
+	// clear executed commands and swap
+	swap_commands();
 
 	// set flushing
 	m_flushing = true;
@@ -12,6 +12,8 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
+#include <algorithm>
+#include <cstdint>
 
 #include "sokol_gfx.h"
 
@@ -63,155 +65,209 @@ namespace doriax {
 			};
 		};
 		
+		// commands are stored in a byte arena as this header followed by only its own payload,
+		// payload starts and next header start at ALIGNMENT boundaries
+		static constexpr uint32_t ALIGNMENT = 16;
+
 		SokolRenderCommand() {}
-		SokolRenderCommand(TYPE::ENUM _type) : type(_type) {}
+		SokolRenderCommand(TYPE::ENUM _type, uint32_t _size) : type(_type), size(_size) {}
 
 		TYPE::ENUM type = TYPE::NOT_SET;
+		uint32_t size = 0;
+
+		// payloads
 
-		union
+		struct Empty
 		{
-			struct
-			{
-				const char* name;
-			} push_debug_group;
+		};
 
-			struct
-			{
-				sg_buffer_desc desc;
-				sg_buffer buffer;
-			} make_buffer;
-			
-			struct
-			{
-				sg_image_desc desc;
-				sg_image image;
-			} make_image;
+		struct PushDebugGroup
+		{
+			const char* name;
+		};
 
-			struct
-			{
-				sg_sampler_desc desc;
-				sg_sampler sampler;
-			} make_sampler;
-			
-			struct
-			{
-				sg_shader_desc desc;
-				sg_shader shader;
-			} make_shader;
-			
-			struct
-			{
-				sg_pipeline_desc desc;
-				sg_pipeline pipeline;
-			} make_pipeline;
-			
-			struct
-			{
-				sg_attachments_desc desc;
-				sg_attachments attachments;
-			} make_attachments;
-			
-			struct
-			{
-				sg_buffer buffer;
-			} destroy_buffer;
-			
-			struct
-			{
-				sg_image image;
-			} destroy_image;
-			
-			struct
-			{
-				sg_sampler sampler;
-			} destroy_sampler;
-			
-			struct
-			{
-				sg_shader shader;
-			} destroy_shader;
-			
-			struct
-			{
-				sg_pipeline pipeline;
-			} destroy_pipeline;
-			
-			struct
-			{
-				sg_attachments attachments;
-			} destroy_attachments;
-			
-			struct
-			{
-				sg_buffer buffer;
-				sg_range data;
-			} update_buffer;
-			
-			struct
-			{
-				sg_buffer buffer;
-				sg_range data;
-			} append_buffer;
-			
-			struct
-			{
-				sg_image image;
-				sg_image_data data;
-			} update_image;
-			
-			struct
-			{
-				void (*custom_cb)(void* custom_data);
-				void* custom_data;
-			} custom;
+		// descriptors are kept in the resource arena, referenced by offset
+		struct MakeBuffer
+		{
+			size_t desc_offset;
+			sg_buffer buffer;
+		};
 
-			struct
-			{
-				sg_pass pass;
-			} begin_pass;
+		struct MakeImage
+		{
+			size_t desc_offset;
+			sg_image image;
+		};
 
-			struct
-			{
-				int x;
-				int y;
-				int width;
-				int height;
-				bool origin_top_left;
-			} apply_viewport;
-			
-			struct
-			{
-				int x;
-				int y;
-				int width;
-				int height;
-				bool origin_top_left;
-			} apply_scissor_rect;
-			
-			struct
-			{
-				sg_pipeline pipeline;
-			} apply_pipeline;
-			
-			struct
-			{
-				sg_bindings bindings;
-			} apply_bindings;
-			
-			struct
-			{
-				int ub_slot;
-				size_t data_size;
-				char buf[16384];
-			} apply_uniforms;
-			
-			struct
-			{
-				int base_element;
-				int number_of_elements;
-				int number_of_instances;
-			} draw;
+		struct MakeSampler
+		{
+			size_t desc_offset;
+			sg_sampler sampler;
+		};
+
+		struct MakeShader
+		{
+			size_t desc_offset;
+			sg_shader shader;
+		};
+
+		struct MakePipeline
+		{
+			size_t desc_offset;
+			sg_pipeline pipeline;
+		};
+
+		struct MakeAttachments
+		{
+			size_t desc_offset;
+			sg_attachments attachments;
+		};
+
+		struct DestroyBuffer
+		{
+			sg_buffer buffer;
+		};
+
+		struct DestroyImage
+		{
+			sg_image image;
+		};
+
+		struct DestroySampler
+		{
+			sg_sampler sampler;
+		};
+
+		struct DestroyShader
+		{
+			sg_shader shader;
+		};
+
+		struct DestroyPipeline
+		{
+			sg_pipeline pipeline;
 		};
+
+		struct DestroyAttachments
+		{
+			sg_attachments attachments;
+		};
+
+		struct UpdateBuffer
+		{
+			sg_buffer buffer;
+			sg_range data;
+		};
+
+		struct AppendBuffer
+		{
+			sg_buffer buffer;
+			sg_range data;
+		};
+
+		struct UpdateImage
+		{
+			sg_image image;
+			sg_image_data data;
+		};
+
+		struct Custom
+		{
+			void (*custom_cb)(void* custom_data);
+			void* custom_data;
+		};
+
+		struct BeginPass
+		{
+			sg_pass pass;
+		};
+
+		struct ApplyViewport
+		{
+			int x;
+			int y;
+			int width;
+			int height;
+			bool origin_top_left;
+		};
+
+		struct ApplyScissorRect
+		{
+			int x;
+			int y;
+			int width;
+			int height;
+			bool origin_top_left;
+		};
+
+		struct ApplyPipeline
+		{
+			sg_pipeline pipeline;
+		};
+
+		struct ApplyBindings
+		{
+			sg_bindings bindings;
+		};
+
+		// followed by data_size bytes of uniform data
+		struct ApplyUniforms
+		{
+			int ub_slot;
+			size_t data_size;
+		};
+
+		struct Draw
+		{
+			int base_element;
+			int number_of_elements;
+			int number_of_instances;
+		};
+	};
+
+// ----------------------------------------------------------------------------------------------------
+
+	// Growable linear byte arena, cleared every frame but keeps its capacity
+	class SokolCmdArena
+	{
+	public:
+		void reserve(size_t capacity) { if (capacity > m_data.size()) m_data.resize(capacity); }
+		void clear() { m_size = 0; }
+
+		// returns offset of a block with aligned start, pointers to it are invalid after next alloc
+		size_t alloc(size_t bytes)
+		{
+			size_t offset = align(m_size);
+			size_t new_size = offset + bytes;
+			if (new_size > m_data.size())
+			{
+				m_data.resize(std::max(new_size, m_data.size() * 2));
+			}
+			m_size = new_size;
+			return offset;
+		}
+
+		uint8_t* at(size_t offset) { return m_data.data() + offset; }
+		const uint8_t* at(size_t offset) const { return m_data.data() + offset; }
+
+		size_t size() const { return m_size; }
+		size_t capacity() const { return m_data.size(); }
+
+		static size_t align(size_t size) { return (size + SokolRenderCommand::ALIGNMENT - 1) & ~(size_t)(SokolRenderCommand::ALIGNMENT - 1); }
+
+	private:
+		std::vector<uint8_t> m_data;
+		size_t m_size = 0;
+	};
+
+// ----------------------------------------------------------------------------------------------------
+
+	// Size of the last committed frame
+	struct SokolCmdQueueStats
+	{
+		uint32_t command_count = 0;
+		size_t command_bytes = 0;
+		size_t resource_bytes = 0;
 	};
 
 // ----------------------------------------------------------------------------------------------------
@@ -280,10 +336,18 @@ namespace doriax {
 		static void lock_execute_mutex() { m_execute_mutex.lock(); }
 		static void unlock_execute_mutex() { m_execute_mutex.unlock(); }
 
+		static SokolCmdQueueStats get_stats() { return m_stats; }
+
 		//static sg_pixel_format get_pixel_format() const { return sg_query_desc().context.color_format; }
 		
 	private:
 		static void process_cleanups(int32_t frame_index);
+		static void swap_commands();
+
+		template<typename T>
+		static T* push_command(SokolRenderCommand::TYPE::ENUM type, size_t extra_size = 0);
+		template<typename T>
+		static size_t push_resource_desc(const T& desc);
 
 		static void dealloc_buffer_cb(void* cleanup_data) { sg_dealloc_buffer({(uint32_t)(uintptr_t)cleanup_data}); }
 		static void dealloc_image_cb(void* cleanup_data) { sg_dealloc_image({(uint32_t)(uintptr_t)cleanup_data}); }
@@ -292,7 +356,10 @@ namespace doriax {
 		static void dealloc_pipeline_cb(void* cleanup_data) { sg_dealloc_pipeline({(uint32_t)(uintptr_t)cleanup_data}); }
 		static void dealloc_attachments_cb(void* cleanup_data) { sg_dealloc_attachments({(uint32_t)(uintptr_t)cleanup_data}); }
 
-		static std::vector<SokolRenderCommand> m_commands[2];
+		static SokolCmdArena m_commands[2];
+		static SokolCmdArena m_resources[2];
+		static uint32_t m_command_count[2];
+		static SokolCmdQueueStats m_stats;
 		static int32_t m_pending_commands_index;
 		static int32_t m_commit_commands_index;
 		static std::vector<SokolRenderCleanup> m_cleanups;
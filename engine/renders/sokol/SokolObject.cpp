@@ -10,8 +10,18 @@
 #include "SokolCmdQueue.h"
 #include "Engine.h"
 
+#include <cstring>
+
 using namespace doriax;
 
+sg_pipeline SokolObject::currentPipeline = { SG_INVALID_ID };
+sg_bindings SokolObject::currentBindings = {};
+bool SokolObject::currentBindingsValid = false;
+std::vector<unsigned char> SokolObject::currentUniforms[SG_MAX_UNIFORMBLOCK_BINDSLOTS];
+bool SokolObject::currentUniformsValid[SG_MAX_UNIFORMBLOCK_BINDSLOTS] = {};
+DrawStateStats SokolObject::frameStats;
+DrawStateStats SokolObject::lastFrameStats;
+
 
 SokolObject::SokolObject(){
     pip.id = SG_INVALID_ID;
@@ -299,25 +309,40 @@ bool SokolObject::endLoad(uint8_t pipelines, bool enableFaceCulling, CullingMode
     return true;
 }
 
+void SokolObject::applyPipeline(sg_pipeline pipeline){
+    if (pipeline.id == currentPipeline.id){
+        frameStats.pipelinesElided++;
+        return;
+    }
+
+    //SokolCmdQueue::add_command_apply_pipeline(pipeline);
+    sg_apply_pipeline(pipeline);
+    frameStats.pipelinesApplied++;
+
+    // sokol requires bindings and uniforms to be applied again after a pipeline change
+    currentPipeline = pipeline;
+    invalidateBindings();
+    for (int i = 0; i < SG_MAX_UNIFORMBLOCK_BINDSLOTS; i++){
+        currentUniformsValid[i] = false;
+    }
+}
+
 bool SokolObject::beginDraw(PipelineType pipType){
     if (pipType == PipelineType::PIP_DEPTH){
         if (depth_pip.id == SG_INVALID_ID){
             return false;
         }
-        //SokolCmdQueue::add_command_apply_pipeline(depth_pip);
-        sg_apply_pipeline(depth_pip);
+        applyPipeline(depth_pip);
     }else if (pipType == PipelineType::PIP_RTT){
         if (rtt_pip.id == SG_INVALID_ID){
             return false;
         }
-        //SokolCmdQueue::add_command_apply_pipeline(rtt_pip);
-        sg_apply_pipeline(rtt_pip);
+        applyPipeline(rtt_pip);
     }else{
         if (pip.id == SG_INVALID_ID){
             return false;
         }
-        //SokolCmdQueue::add_command_apply_pipeline(pip);
-        sg_apply_pipeline(pip);
+        applyPipeline(pip);
     }
 
     return true;
@@ -325,15 +350,58 @@ bool SokolObject::beginDraw(PipelineType pipType){
 
 void SokolObject::applyUniformBlock(int slot, unsigned int count, void* data){
     if (slot != -1){
+        // copy of last applied block, capacity is kept so no allocation after first frames
+        std::vector<unsigned char>& current = currentUniforms[slot];
+        if (currentUniformsValid[slot] && current.size() == count && memcmp(current.data(), data, count) == 0){
+            frameStats.uniformsElided++;
+            return;
+        }
+
         sg_apply_uniforms(slot, {data, count});
+        frameStats.uniformsApplied++;
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        current.assign(bytes, bytes + count);
+        currentUniformsValid[slot] = true;
     }
 }
 
 void SokolObject::draw(unsigned int vertexCount, unsigned int instanceCount){
-    //SokolCmdQueue::add_command_apply_bindings(bind);
-    sg_apply_bindings(bind);
+    if (currentBindingsValid && memcmp(&currentBindings, &bind, sizeof(sg_bindings)) == 0){
+        frameStats.bindingsElided++;
+    }else{
+        //SokolCmdQueue::add_command_apply_bindings(bind);
+        sg_apply_bindings(bind);
+        frameStats.bindingsApplied++;
+
+        currentBindings = bind;
+        currentBindingsValid = true;
+    }
     //SokolCmdQueue::add_command_draw(0, vertexCount, 1);
     sg_draw(0, vertexCount, instanceCount);
+    frameStats.draws++;
+}
+
+void SokolObject::invalidateDrawState(){
+    currentPipeline.id = SG_INVALID_ID;
+    invalidateBindings();
+    for (int i = 0; i < SG_MAX_UNIFORMBLOCK_BINDSLOTS; i++){
+        currentUniformsValid[i] = false;
+    }
+}
+
+void SokolObject::invalidateBindings(){
+    currentBindingsValid = false;
+}
+
+void SokolObject::endFrame(){
+    lastFrameStats = frameStats;
+    frameStats = DrawStateStats();
+    invalidateDrawState();
+}
+
+DrawStateStats SokolObject::getDrawStateStats(){
+    return lastFrameStats;
 }
 
 void SokolObject::destroy(){
@@ -14,6 +14,7 @@
 #include "sokol_gfx.h"
 
 #include <map>
+#include <vector>
 
 
 namespace doriax{
@@ -52,6 +53,17 @@ namespace doriax{
 
         std::map< BufferInfo, size_t > bufferToBindSlot;
 
+        // last applied state in current pass, shared by all objects (render thread only)
+        static sg_pipeline currentPipeline;
+        static sg_bindings currentBindings;
+        static bool currentBindingsValid;
+        static std::vector<unsigned char> currentUniforms[SG_MAX_UNIFORMBLOCK_BINDSLOTS];
+        static bool currentUniformsValid[SG_MAX_UNIFORMBLOCK_BINDSLOTS];
+
+        static DrawStateStats frameStats;
+        static DrawStateStats lastFrameStats;
+
+        static void applyPipeline(sg_pipeline pipeline);
 
         sg_vertex_format getVertexFormat(unsigned int elements, AttributeDataType dataType, bool normalized);
         sg_primitive_type getPrimitiveType(PrimitiveType primitiveType);
@@ -78,6 +90,12 @@ namespace doriax{
 
         void destroy();
 
+        // must be called when state applied outside SokolObject can be lost (new pass, buffer update)
+        static void invalidateDrawState();
+        static void invalidateBindings();
+        static void endFrame();
+        static DrawStateStats getDrawStateStats();
+
     };
 }
 #endif //sokolobject_h
@@ -7,6 +7,7 @@
 #include "System.h"
 #include "sokol_gfx.h"
 #include "SokolCmdQueue.h"
+#include "SokolObject.h"
 #include "Engine.h"
 #include "Log.h"
 
@@ -66,6 +67,7 @@ void SokolSystem::executeQueue(){
 
 void SokolSystem::commit(){
     sg_commit();
+    SokolObject::endFrame();
 }
 
 void SokolSystem::shutdown(){
@@ -79,6 +81,10 @@ void SokolSystem::scheduleCleanup(void (*cleanupFunc)(void* cleanupData), void*
     SokolCmdQueue::schedule_cleanup(cleanupFunc, cleanupData, numFramesToDefer);
 }
 
+DrawStateStats SokolSystem::getDrawStateStats(){
+    return SokolObject::getDrawStateStats();
+}
+
 void SokolSystem::addQueueCommand(void (*custom_cb)(void* custom_data), void* custom_data){
     SokolCmdQueue::add_command_custom(custom_cb, custom_data);
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #define sokolsystem_h
 
 #include <stdint.h>
+#include "render/Render.h"
 
 namespace doriax{
     class SokolSystem{
@@ -19,6 +20,8 @@ namespace doriax{
 
         static void scheduleCleanup(void (*cleanupFunc)(void* cleanupData), void* cleanupData, int32_t numFramesToDefer = 0);
         static void addQueueCommand(void (*custom_cb)(void* custom_data), void* custom_data);
+
+        static DrawStateStats getDrawStateStats();
     };
 }
 